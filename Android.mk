@@ -25,6 +25,14 @@ $(waffle_top)/include/waffle/waffle_version.h: \
 	     $(waffle_top)/include/waffle/waffle_version.h.in \
 	     > $(waffle_top)/include/waffle/waffle_version.h
 
+$(waffle_top)/include/waffle/waffle_gl_dispatch.h: \
+    $(waffle_top)/include/gen_gl_dispatch.py \
+    $(waffle_top)/third_party/khronos/gl.xml
+	@echo "target  Gen: libwaffle <= $(waffle_top)/include/waffle/waffle_gl_dispatch.h"
+	@python3 $(waffle_top)/include/gen_gl_dispatch.py \
+	     $(waffle_top)/third_party/khronos/gl.xml \
+	     $(waffle_top)/include/waffle/waffle_gl_dispatch.h
+
 LOCAL_MODULE_TAGS := eng
 LOCAL_MODULE := libwaffle-$(waffle_major_version)
 
@@ -60,17 +68,27 @@ LOCAL_C_INCLUDES := \
 LOCAL_SRC_FILES := \
     src/waffle/core/wcore_tinfo.c \
     src/waffle/core/wcore_config_attrs.c \
+    src/waffle/core/wcore_config_table.c \
     src/waffle/core/wcore_error.c \
+    src/waffle/core/wcore_ext_set.c \
+    src/waffle/core/wcore_gl_proc.c \
+    src/waffle/core/wcore_sym_cache.c \
+    src/waffle/core/wcore_time.c \
     src/waffle/core/wcore_util.c \
     src/waffle/core/wcore_display.c \
     src/waffle/core/wcore_attrib_list.c \
+    src/waffle/core/wcore_cache.c \
     src/waffle/api/api_priv.c \
+    src/waffle/api/api_async.c \
+    src/waffle/api/api_probe.c \
+    src/waffle/api/waffle_async_op.c \
     src/waffle/api/waffle_attrib_list.c \
     src/waffle/api/waffle_config.c \
     src/waffle/api/waffle_context.c \
     src/waffle/api/waffle_display.c \
     src/waffle/api/waffle_enum.c \
     src/waffle/api/waffle_error.c \
+    src/waffle/api/waffle_gl_dispatch.c \
     src/waffle/api/waffle_gl_misc.c \
     src/waffle/api/waffle_init.c \
     src/waffle/api/waffle_window.c \
@@ -80,6 +98,7 @@ LOCAL_SRC_FILES := \
     src/waffle/egl/wegl_config.c \
     src/waffle/egl/wegl_context.c \
     src/waffle/egl/wegl_display.c \
+    src/waffle/egl/wegl_fbo.c \
     src/waffle/egl/wegl_platform.c \
     src/waffle/egl/wegl_util.c \
     src/waffle/egl/wegl_surface.c \
@@ -95,11 +114,13 @@ LOCAL_SHARED_LIBRARIES := \
     libgui
 
 LOCAL_GENERATED_SOURCES := \
+    $(LOCAL_PATH)/include/waffle/waffle_gl_dispatch.h \
     $(LOCAL_PATH)/include/waffle/waffle_version.h
 
 LOCAL_COPY_HEADERS := \
     include/waffle/waffle.h \
     include/waffle/waffle_gbm.h \
+    include/waffle/waffle_gl_dispatch.h \
     include/waffle/waffle_glx.h \
     include/waffle/waffle_surfaceless_egl.h \
     include/waffle/waffle_version.h \
@@ -25,6 +25,14 @@
 
 find_package(PkgConfig)
 
+# include/gen_gl_dispatch.py generates the GL dispatch table header.
+if(CMAKE_VERSION VERSION_LESS "3.12")
+    find_package(PythonInterp 3 REQUIRED)
+    set(Python3_EXECUTABLE ${PYTHON_EXECUTABLE})
+else()
+    find_package(Python3 REQUIRED COMPONENTS Interpreter)
+endif()
+
 #
 # Macro waffle_pkg_config is a smart wrapper around CMake's standard
 # pkg_check_modules macro.
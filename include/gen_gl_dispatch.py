@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+# Copyright 2026 Intel Corporation
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# - Redistributions of source code must retain the above copyright notice, this
+#   list of conditions and the following disclaimer.
+#
+# - Redistributions in binary form must reproduce the above copyright notice,
+#   this list of conditions and the following disclaimer in the documentation
+#   and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Generate waffle_gl_dispatch.h, the entry points of struct
+waffle_gl_dispatch, from the gl.xml subset in third_party/khronos.
+
+usage: gen_gl_dispatch.py GL_XML OUTPUT
+"""
+
+import sys
+import xml.etree.ElementTree as ET
+
+# The <khrplatform.h> types that gl.xml builds on, spelled with <stdint.h>
+# so that waffle.h needs no Khronos header.
+KHRONOS_TYPES = {
+    'khronos_int8_t': 'int8_t',
+    'khronos_uint8_t': 'uint8_t',
+    'khronos_int16_t': 'int16_t',
+    'khronos_uint16_t': 'uint16_t',
+    'khronos_float_t': 'float',
+    'khronos_intptr_t': 'intptr_t',
+    'khronos_ssize_t': 'intptr_t',
+    'khronos_int64_t': 'int64_t',
+    'khronos_uint64_t': 'uint64_t',
+}
+
+
+def flatten(elem, types, name=None):
+    """Spell elem as C, replacing each <ptype> with its C type.
+
+    The <name> child is replaced with name, or dropped if name is None.
+    """
+    out = [elem.text or '']
+    for child in elem:
+        if child.tag == 'ptype':
+            out.append(types[child.text])
+        elif child.tag == 'apientry':
+            out.append('WAFFLE_GL_APIENTRY')
+        elif child.tag == 'name':
+            if name is not None:
+                out.append(name)
+        else:
+            out.append(child.text or '')
+        out.append(child.tail or '')
+    return ''.join(out)
+
+
+def parse_types(registry):
+    """Return a map from each GL type to its C spelling, and the typedefs
+    the header must declare for the GL types that C does not have."""
+    types = {}
+    typedefs = []
+    for elem in registry.findall('types/type'):
+        gl_name = elem.find('name').text
+        if elem.find('apientry') is not None:
+            c_name = 'waffle_gl_' + gl_name[2:].lower()
+            typedefs.append(flatten(elem, types, c_name))
+        else:
+            c_name = flatten(elem, types).replace('typedef', '', 1)
+            c_name = c_name.rstrip(';').strip()
+            c_name = KHRONOS_TYPES.get(c_name, c_name)
+        types[gl_name] = c_name
+    return types, typedefs
+
+
+def parse_commands(registry, types):
+    """Return (return_type, name, parameters) for each command required by
+    a feature, in order of first appearance."""
+    protos = {}
+    for elem in registry.findall('commands/command'):
+        proto = elem.find('proto')
+        name = proto.find('name').text
+        ret = flatten(proto, types).strip()
+        params = [flatten(p, types, p.find('name').text).strip()
+                  for p in elem.findall('param')]
+        protos[name] = (ret, name, '(' + (', '.join(params) or 'void') + ')')
+
+    commands = []
+    seen = set()
+    for elem in registry.findall('feature/require/command'):
+        name = elem.get('name')
+        if name not in seen:
+            seen.add(name)
+            commands.append(protos[name])
+    return commands
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.strip().splitlines()[-1])
+
+    registry = ET.parse(sys.argv[1]).getroot()
+    types, typedefs = parse_types(registry)
+    commands = parse_commands(registry, types)
+
+    ret_width = max(len(c[0]) for c in commands)
+    name_width = max(len(c[1]) for c in commands)
+
+    lines = [
+        '// Generated by gen_gl_dispatch.py from gl.xml. Do not edit.',
+        '',
+        '#ifndef WAFFLE_GL_DISPATCH_H',
+        '#define WAFFLE_GL_DISPATCH_H',
+        '',
+    ]
+    lines += typedefs
+    lines += [
+        '',
+        '#define WAFFLE_GL_DISPATCH_FUNCTIONS(f) \\',
+    ]
+    entries = ['    f(%-*s, %-*s, %s)' % (ret_width, ret, name_width, name,
+                                          params)
+               for ret, name, params in commands]
+    lines += [e + ' \\' for e in entries[:-1]] + entries[-1:]
+    lines += [
+        '',
+        '#endif',
+    ]
+
+    with open(sys.argv[2], 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    main()
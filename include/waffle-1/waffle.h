@@ -59,8 +59,15 @@ extern "C" {
 struct waffle_display;
 struct waffle_config;
 struct waffle_context;
+struct waffle_context_pool;
+struct waffle_context_group;
 struct waffle_window;
 
+struct waffle_gl_dispatch;
+struct waffle_extension_set;
+struct waffle_platform;
+struct waffle_async_op;
+
 union waffle_native_display;
 union waffle_native_config;
 union waffle_native_context;
@@ -100,6 +107,14 @@ waffle_error_get_info(void);
 const char*
 waffle_error_to_string(enum waffle_error e);
 
+#if WAFFLE_API_VERSION >= 0x0108
+uint32_t
+waffle_error_get_history_count(void);
+
+const struct waffle_error_info*
+waffle_error_get_history_info(uint32_t index);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_enum
 // ---------------------------------------------------------------------------
@@ -125,6 +140,23 @@ enum waffle_enum {
         WAFFLE_PLATFORM_GBM                                     = 0x0016,
         WAFFLE_PLATFORM_WGL                                     = 0x0017,
         WAFFLE_PLATFORM_SURFACELESS_EGL                         = 0x0019,
+        WAFFLE_PLATFORM_AUTO                                    = 0x001a,
+
+    WAFFLE_SKIP_REDUNDANT_MAKE_CURRENT                          = 0x0020,
+    WAFFLE_SKIP_VALIDATION                                      = 0x0021,
+    WAFFLE_PLATFORM_PROBE_TIMEOUT                               = 0x0022,
+    WAFFLE_PLATFORM_ASYNC_INIT                                  = 0x0023,
+    WAFFLE_DEFER_DL                                             = 0x0024,
+    WAFFLE_CACHE                                                = 0x0029,
+
+    // ------------------------------------------------------------------
+    // For waffle_get_init_time()
+    // ------------------------------------------------------------------
+
+    WAFFLE_INIT_TIME_DL_OPEN                                    = 0x0025,
+    WAFFLE_INIT_TIME_DL_SYM                                     = 0x0026,
+    WAFFLE_INIT_TIME_PLATFORM                                   = 0x0027,
+    WAFFLE_INIT_TIME_WAIT                                       = 0x0028,
 
     // ------------------------------------------------------------------
     // For waffle_config_choose()
@@ -146,6 +178,16 @@ enum waffle_enum {
     WAFFLE_CONTEXT_FORWARD_COMPATIBLE                           = 0x0215,
     WAFFLE_CONTEXT_DEBUG                                        = 0x0216,
     WAFFLE_CONTEXT_ROBUST_ACCESS                                = 0x0217,
+    WAFFLE_CONTEXT_NO_ERROR                                     = 0x021b,
+    WAFFLE_CONTEXT_RELEASE_BEHAVIOR                             = 0x021c,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH                   = 0x021d,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE                    = 0x021e,
+    WAFFLE_CONTEXT_PRIORITY                                     = 0x021f,
+        WAFFLE_CONTEXT_PRIORITY_LOW                             = 0x0220,
+        WAFFLE_CONTEXT_PRIORITY_MEDIUM                          = 0x0221,
+        WAFFLE_CONTEXT_PRIORITY_HIGH                            = 0x0222,
+        WAFFLE_CONTEXT_PRIORITY_REALTIME                        = 0x0223,
+    WAFFLE_CONTEXT_NO_CONFIG                                    = 0x0224,
 
     WAFFLE_RED_SIZE                                             = 0x0201,
     WAFFLE_GREEN_SIZE                                           = 0x0202,
@@ -162,6 +204,10 @@ enum waffle_enum {
 
     WAFFLE_ACCUM_BUFFER                                         = 0x0213,
 
+    WAFFLE_CONFIG_SORT                                          = 0x0218,
+        WAFFLE_CONFIG_SORT_NATIVE                               = 0x0219,
+        WAFFLE_CONFIG_SORT_SMALLEST                             = 0x021a,
+
     // ------------------------------------------------------------------
     // For waffle_dl_sym()
     // ------------------------------------------------------------------
@@ -178,6 +224,15 @@ enum waffle_enum {
     WAFFLE_WINDOW_WIDTH                                         = 0x0310,
     WAFFLE_WINDOW_HEIGHT                                        = 0x0311,
     WAFFLE_WINDOW_FULLSCREEN                                    = 0x0312,
+    WAFFLE_WINDOW_FBO                                           = 0x0313,
+    WAFFLE_WINDOW_OFFSCREEN                                     = 0x0314,
+
+    // ------------------------------------------------------------------
+    // For waffle_context_group_create()
+    // ------------------------------------------------------------------
+
+    WAFFLE_CONTEXT_GROUP_SIZE                                   = 0x0320,
+    WAFFLE_CONTEXT_GROUP_SURFACELESS                            = 0x0321,
 };
 
 const char*
@@ -193,6 +248,48 @@ bool
 waffle_teardown(void);
 #endif
 
+#if WAFFLE_API_VERSION >= 0x0108
+int32_t
+waffle_get_platform(void);
+
+uint64_t
+waffle_get_init_time(int32_t phase);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_platform
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0108
+struct waffle_platform*
+waffle_platform_create(const int32_t attrib_list[]);
+
+bool
+waffle_platform_destroy(struct waffle_platform *self);
+
+int32_t
+waffle_platform_get_enum(struct waffle_platform *self);
+
+uint64_t
+waffle_platform_get_init_time(struct waffle_platform *self,
+                              int32_t phase);
+
+void*
+waffle_platform_get_proc_address(struct waffle_platform *self,
+                                 const char *name);
+
+bool
+waffle_platform_dl_can_open(struct waffle_platform *self,
+                            int32_t dl);
+
+void*
+waffle_platform_dl_sym(struct waffle_platform *self,
+                       int32_t dl,
+                       const char *name);
+#endif
+
+// ---------------------------------------------------------------------------
+
 bool
 waffle_make_current(struct waffle_display *dpy,
                     struct waffle_window *window,
@@ -209,13 +306,37 @@ struct waffle_context *
 waffle_get_current_context(void);
 #endif
 
+#if WAFFLE_API_VERSION >= 0x0108
+uint64_t
+waffle_get_make_current_skip_count(void);
+#endif
+
 void*
 waffle_get_proc_address(const char *name);
 
+#if WAFFLE_API_VERSION >= 0x0108
+bool
+waffle_get_proc_address_many(const char *const names[],
+                             void *procs[],
+                             size_t count);
+#endif
+
 bool
 waffle_is_extension_in_string(const char *extension_string,
                               const char *extension_name);
 
+#if WAFFLE_API_VERSION >= 0x0108
+struct waffle_extension_set*
+waffle_extension_set_create(const char *extension_string);
+
+bool
+waffle_extension_set_has(const struct waffle_extension_set *self,
+                         const char *extension_name);
+
+bool
+waffle_extension_set_destroy(struct waffle_extension_set *self);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_display
 // ---------------------------------------------------------------------------
@@ -223,6 +344,12 @@ waffle_is_extension_in_string(const char *extension_string,
 struct waffle_display*
 waffle_display_connect(const char *name);
 
+#if WAFFLE_API_VERSION >= 0x0108
+struct waffle_display*
+waffle_display_connect_platform(struct waffle_platform *platform,
+                                const char *name);
+#endif
+
 bool
 waffle_display_disconnect(struct waffle_display *self);
 
@@ -233,6 +360,36 @@ waffle_display_supports_context_api(struct waffle_display *self,
 union waffle_native_display*
 waffle_display_get_native(struct waffle_display *self);
 
+#if WAFFLE_API_VERSION >= 0x0108
+const union waffle_native_display*
+waffle_display_peek_native(struct waffle_display *self);
+
+struct waffle_display_capabilities {
+    bool supports_opengl;
+    bool supports_opengl_es1;
+    bool supports_opengl_es2;
+    bool supports_opengl_es3;
+
+    int32_t opengl_compat_version;
+    int32_t opengl_core_version;
+    int32_t opengl_es1_version;
+    int32_t opengl_es_version;
+
+    bool robust_access;
+    bool debug;
+    bool no_error;
+    bool release_behavior_none;
+
+    const char *driver_name;
+    const char *device_path;
+    uint32_t vendor_id;
+    uint32_t device_id;
+};
+
+const struct waffle_display_capabilities*
+waffle_display_get_capabilities(struct waffle_display *self);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_config
 // ---------------------------------------------------------------------------
@@ -247,6 +404,18 @@ waffle_config_destroy(struct waffle_config *self);
 union waffle_native_config*
 waffle_config_get_native(struct waffle_config *self);
 
+#if WAFFLE_API_VERSION >= 0x0108
+const union waffle_native_config*
+waffle_config_peek_native(struct waffle_config *self);
+
+bool
+waffle_config_enumerate(struct waffle_display *dpy,
+                        const int32_t attrib_list[],
+                        struct waffle_config **configs,
+                        int32_t configs_size,
+                        int32_t *num_configs);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_context
 // ---------------------------------------------------------------------------
@@ -261,6 +430,146 @@ waffle_context_destroy(struct waffle_context *self);
 union waffle_native_context*
 waffle_context_get_native(struct waffle_context *self);
 
+#if WAFFLE_API_VERSION >= 0x0108
+const union waffle_native_context*
+waffle_context_peek_native(struct waffle_context *self);
+#endif
+
+#if WAFFLE_API_VERSION >= 0x0108
+const struct waffle_gl_dispatch*
+waffle_context_get_gl_dispatch(struct waffle_context *self);
+
+bool
+waffle_context_get_gl_version(struct waffle_context *self,
+                              int32_t *major,
+                              int32_t *minor);
+
+bool
+waffle_context_has_gl_extension(struct waffle_context *self,
+                                const char *name);
+
+bool
+waffle_context_get_priority(struct waffle_context *self,
+                            int32_t *priority);
+#endif
+
+#if WAFFLE_API_VERSION >= 0x0108
+struct waffle_async_op*
+waffle_context_create_async(struct waffle_config *config,
+                            struct waffle_context *shared_ctx);
+
+struct waffle_context*
+waffle_context_create_finish(struct waffle_async_op *op);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_context_pool
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0108
+struct waffle_context_pool*
+waffle_context_pool_create(struct waffle_display *dpy,
+                           int32_t max_idle);
+
+bool
+waffle_context_pool_destroy(struct waffle_context_pool *self);
+
+struct waffle_context*
+waffle_context_pool_acquire(struct waffle_context_pool *self,
+                            struct waffle_config *config,
+                            struct waffle_context *shared_ctx);
+
+bool
+waffle_context_pool_release(struct waffle_context_pool *self,
+                            struct waffle_context *ctx);
+
+uint64_t
+waffle_context_pool_get_hit_count(struct waffle_context_pool *self);
+
+uint64_t
+waffle_context_pool_get_miss_count(struct waffle_context_pool *self);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_context_group
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0108
+struct waffle_context_group*
+waffle_context_group_create(struct waffle_config *config,
+                            struct waffle_context *shared_ctx,
+                            const intptr_t attrib_list[]);
+
+bool
+waffle_context_group_destroy(struct waffle_context_group *self);
+
+int32_t
+waffle_context_group_get_size(struct waffle_context_group *self);
+
+struct waffle_context*
+waffle_context_group_get_context(struct waffle_context_group *self,
+                                 int32_t index);
+
+struct waffle_window*
+waffle_context_group_get_window(struct waffle_context_group *self,
+                                int32_t index);
+
+bool
+waffle_context_group_make_current(struct waffle_context_group *self,
+                                  int32_t index);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_async_op
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0108
+bool
+waffle_async_op_is_done(struct waffle_async_op *self);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_gl_dispatch
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0108
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#   define WAFFLE_GL_APIENTRY __stdcall
+#else
+#   define WAFFLE_GL_APIENTRY
+#endif
+
+// The OpenGL and OpenGL ES entry points in struct waffle_gl_dispatch, as
+// f(return_type, name, parameters): the commands of the OpenGL core profile
+// and of OpenGL ES 2.0 and later, generated from the Khronos registry. The
+// types are those of <GL/gl.h> spelled as C types. The table holds every
+// entry whatever the context's API; those the API lacks may be null or may
+// not be callable. New entries are appended only; check for them with
+// WAFFLE_GL_DISPATCH_HAS().
+#include "waffle_gl_dispatch.h"
+
+struct waffle_gl_dispatch {
+    // sizeof(struct waffle_gl_dispatch) in the library that filled the
+    // table, which may be older than the header the application was built
+    // with.
+    size_t size;
+
+#define WAFFLE_GL_DISPATCH_DECLARE(type, name, params) \
+    type (WAFFLE_GL_APIENTRY *name) params;
+
+    WAFFLE_GL_DISPATCH_FUNCTIONS(WAFFLE_GL_DISPATCH_DECLARE)
+
+#undef WAFFLE_GL_DISPATCH_DECLARE
+};
+
+// True if the library that filled gl knows the entry name. The entry
+// may still be null if the implementation does not expose it.
+#define WAFFLE_GL_DISPATCH_HAS(gl, name) \
+    (offsetof(struct waffle_gl_dispatch, name) < (gl)->size)
+
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_window
 // ---------------------------------------------------------------------------
@@ -290,6 +599,20 @@ waffle_window_swap_buffers(struct waffle_window *self);
 union waffle_native_window*
 waffle_window_get_native(struct waffle_window *self);
 
+#if WAFFLE_API_VERSION >= 0x0108
+const union waffle_native_window*
+waffle_window_peek_native(struct waffle_window *self);
+#endif
+
+#if WAFFLE_API_VERSION >= 0x0108
+struct waffle_async_op*
+waffle_window_create_async(struct waffle_config *config,
+                           const intptr_t attrib_list[]);
+
+struct waffle_window*
+waffle_window_create_finish(struct waffle_async_op *op);
+#endif
+
 #if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0103
 bool
 waffle_window_resize(
@@ -308,6 +631,14 @@ waffle_dl_can_open(int32_t dl);
 void*
 waffle_dl_sym(int32_t dl, const char *name);
 
+#if WAFFLE_API_VERSION >= 0x0108
+bool
+waffle_dl_sym_many(int32_t dl,
+                   const char *const names[],
+                   void *syms[],
+                   size_t count);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_native
 // ---------------------------------------------------------------------------
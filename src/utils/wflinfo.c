@@ -65,7 +65,7 @@ static const char *usage_message =
     "Required Parameters:\n"
     "    -p, --platform <platform>\n"
     "        One of: android, cgl, gbm, glx, surfaceless_egl (or short\n"
-    "        alias 'sl'), wayland, wgl, or x11_egl.\n"
+    "        alias 'sl'), wayland, wgl, x11_egl, or auto.\n"
     "\n"
     "    -a, --api <api>\n"
     "        One of: gl, gles1, gles2 or gles3\n"
@@ -89,6 +89,9 @@ static const char *usage_message =
     "    -f, --format <format>\n"
     "        One of: original (default) or json.\n"
     "\n"
+    "    --init-time\n"
+    "        Print the time Waffle spent initializing the platform.\n"
+    "\n"
     "    -h, --help\n"
     "        Print wflinfo usage information.\n"
     "\n"
@@ -109,6 +112,7 @@ enum {
     OPT_DEBUG_CONTEXT,
     OPT_FORWARD_COMPATIBLE,
     OPT_FORMAT = 'f',
+    OPT_INIT_TIME,
     OPT_HELP = 'h',
 };
 
@@ -121,16 +125,11 @@ static const struct option get_opts[] = {
     { .name = "debug-context",  .has_arg = no_argument,           .val = OPT_DEBUG_CONTEXT },
     { .name = "forward-compatible", .has_arg = no_argument,       .val = OPT_FORWARD_COMPATIBLE },
     { .name = "format",         .has_arg = required_argument,     .val = OPT_FORMAT },
+    { .name = "init-time",      .has_arg = no_argument,           .val = OPT_INIT_TIME },
     { .name = "help",           .has_arg = no_argument,           .val = OPT_HELP },
     { 0 },
 };
 
-static bool
-strneq(const char *a, const char *b, size_t n)
-{
-    return strncmp(a, b, n) == 0;
-}
-
 #if defined(__GNUC__)
 #define NORETURN __attribute__((noreturn))
 #elif defined(_MSC_VER)
@@ -209,7 +208,8 @@ error_get_gl_symbol(const char *name)
 
 typedef float GLclampf;
 typedef unsigned int GLbitfield;
-typedef unsigned int GLint;
+typedef int GLint;
+typedef unsigned int GLuint;
 typedef int GLsizei;
 typedef unsigned int GLenum;
 typedef void GLvoid;
@@ -235,8 +235,6 @@ enum {
 #define WINDOW_WIDTH  320
 #define WINDOW_HEIGHT 240
 
-#define GL_MAJOR_VERSION                  0x821B
-#define GL_MINOR_VERSION                  0x821C
 #define GL_CONTEXT_PROFILE_MASK           0x9126
 #define GL_CONTEXT_CORE_PROFILE_BIT       0x00000001
 #define GL_CONTEXT_COMPATIBILITY_PROFILE_BIT 0x00000002
@@ -252,7 +250,34 @@ enum {
 static GLenum (APIENTRY *glGetError)(void);
 static void (APIENTRY *glGetIntegerv)(GLenum pname, GLint *params);
 static const GLubyte * (APIENTRY *glGetString)(GLenum name);
-static const GLubyte * (APIENTRY *glGetStringi)(GLenum name, GLint i);
+static const GLubyte * (APIENTRY *glGetStringi)(GLenum name, GLuint i);
+
+/// @brief Load the GL functions used by wflinfo from the context's dispatch
+/// table.
+///
+/// Exit on failure. On some platforms, such as WGL, the context must be
+/// current.
+static void
+wflinfo_load_gl(struct waffle_context *ctx)
+{
+    const struct waffle_gl_dispatch *gl = waffle_context_get_gl_dispatch(ctx);
+    if (!gl)
+        error_waffle();
+
+    glGetError = gl->glGetError;
+    if (!glGetError)
+        error_get_gl_symbol("glGetError");
+
+    glGetIntegerv = gl->glGetIntegerv;
+    if (!glGetIntegerv)
+        error_get_gl_symbol("glGetIntegerv");
+
+    glGetString = gl->glGetString;
+    if (!glGetString)
+        error_get_gl_symbol("glGetString");
+
+    glGetStringi = gl->glGetStringi;
+}
 
 /// @brief Command line options.
 struct options {
@@ -269,6 +294,7 @@ struct options {
     int context_minor;
 
     bool verbose;
+    bool init_time;
 
     enum format {
         FORMAT_ORIGINAL,
@@ -277,9 +303,6 @@ struct options {
 
     bool context_forward_compatible;
     bool context_debug;
-
-    /// @brief One of `WAFFLE_DL_*`.
-    int dl;
 };
 
 struct enum_map {
@@ -297,6 +320,7 @@ static const struct enum_map platform_map[] = {
     {WAFFLE_PLATFORM_X11_EGL,   "x11_egl"       },
     {WAFFLE_PLATFORM_SURFACELESS_EGL,   "surfaceless_egl" },
     {WAFFLE_PLATFORM_SURFACELESS_EGL,   "sl"              },
+    {WAFFLE_PLATFORM_AUTO,      "auto"          },
     {0,                         0               },
 };
 
@@ -424,6 +448,9 @@ parse_args(int argc, char *argv[], struct options *opts)
             case OPT_VERBOSE:
                 opts->verbose = true;
                 break;
+            case OPT_INIT_TIME:
+                opts->init_time = true;
+                break;
             case OPT_FORWARD_COMPATIBLE:
                 opts->context_forward_compatible = true;
                 break;
@@ -452,17 +479,6 @@ parse_args(int argc, char *argv[], struct options *opts)
         usage_error_printf("--api is required");
     }
 
-    // Set dl.
-    switch (opts->context_api) {
-        case WAFFLE_CONTEXT_OPENGL:     opts->dl = WAFFLE_DL_OPENGL;      break;
-        case WAFFLE_CONTEXT_OPENGL_ES1: opts->dl = WAFFLE_DL_OPENGL_ES1;  break;
-        case WAFFLE_CONTEXT_OPENGL_ES2: opts->dl = WAFFLE_DL_OPENGL_ES2;  break;
-        case WAFFLE_CONTEXT_OPENGL_ES3: opts->dl = WAFFLE_DL_OPENGL_ES3;  break;
-        default:
-            abort();
-            break;
-    }
-
     return true;
 
 error_unrecognized_arg:
@@ -689,7 +705,13 @@ print_json(const struct options *opts)
     printf("{\n");
     printf("    \"waffle\": {\n");
     printf("        \"platform\": \"%s\",\n", platform);
-    printf("        \"api\": \"%s\"\n", api);
+    if (opts->init_time) {
+        printf("        \"api\": \"%s\",\n", api);
+        printf("        \"init time ms\": %.3f\n",
+               waffle_get_init_time(WAFFLE_INIT_TIME_PLATFORM) / 1e6);
+    } else {
+        printf("        \"api\": \"%s\"\n", api);
+    }
     printf("    },\n");
     printf("    \"OpenGL\": {\n");
     printf("        \"vendor string\": \"%s\",\n", vendor);
@@ -761,6 +783,14 @@ print_wflinfo(const struct options *opts)
         print_extensions(use_getstringi);
     }
 
+    if (opts->init_time) {
+        printf("Waffle platform init time: %.3f ms "
+               "(dlopen %.3f ms, dlsym %.3f ms)\n",
+               waffle_get_init_time(WAFFLE_INIT_TIME_PLATFORM) / 1e6,
+               waffle_get_init_time(WAFFLE_INIT_TIME_DL_OPEN) / 1e6,
+               waffle_get_init_time(WAFFLE_INIT_TIME_DL_SYM) / 1e6);
+    }
+
     return true;
 }
 
@@ -927,89 +957,18 @@ fail:
 
 /// @brief Return 10 * version of the current OpenGL context.
 static int
-gl_get_version(void)
+gl_get_version(struct waffle_context *ctx)
 {
-    GLint major_version = 0;
-    GLint minor_version = 0;
+    int32_t major_version = 0;
+    int32_t minor_version = 0;
 
-    glGetIntegerv(GL_MAJOR_VERSION, &major_version);
-    if (glGetError()) {
-        error_printf("Wflinfo", "glGetIntegerv(GL_MAJOR_VERSION) failed");
+    if (!waffle_context_get_gl_version(ctx, &major_version, &minor_version)) {
+        error_waffle();
     }
 
-    glGetIntegerv(GL_MINOR_VERSION, &minor_version);
-    if (glGetError()) {
-        error_printf("Wflinfo", "glGetIntegerv(GL_MINOR_VERSION) failed");
-    }
     return 10 * major_version + minor_version;
 }
 
-/// @brief Check if current context has an extension using glGetString().
-static bool
-gl_has_extension_GetString(const char *name)
-{
-#define BUF_LEN 4096
-    char exts[BUF_LEN];
-
-    const uint8_t *exts_orig = glGetString(GL_EXTENSIONS);
-    if (glGetError()) {
-        error_printf("Wflinfo", "glGetInteger(GL_EXTENSIONS) failed");
-    }
-
-    memcpy(exts, exts_orig, BUF_LEN);
-    exts[BUF_LEN - 1] = 0;
-
-    char *ext = strtok(exts, " ");
-    do {
-        if (strneq(ext, name, BUF_LEN)) {
-            return true;
-        }
-        ext = strtok(NULL, " ");
-    } while (ext);
-
-    return false;
-#undef BUF_LEN
-}
-
-/// @brief Check if current context has an extension using glGetStringi().
-static bool
-gl_has_extension_GetStringi(const char *name)
-{
-    const size_t max_ext_len = 128;
-    uint32_t num_exts = 0;
-
-    glGetIntegerv(GL_NUM_EXTENSIONS, &num_exts);
-    if (glGetError()) {
-        error_printf("Wflinfo", "glGetIntegerv(GL_NUM_EXTENSIONS) failed");
-    }
-
-    for (uint32_t i = 0; i < num_exts; i++) {
-        const uint8_t *ext = glGetStringi(GL_EXTENSIONS, i);
-        if (!ext || glGetError()) {
-            error_printf("Wflinfo", "glGetStringi(GL_EXTENSIONS) failed");
-        } else if (strneq((const char*) ext, name, max_ext_len)) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-/// @brief Check if current context has an extension.
-static bool
-gl_has_extension(const char *name)
-{
-    // Use the new glGetStringi when possible.
-    //
-    // Due to the funky semantics of obtaining the function pointer, we can
-    // get here, even when it is NULL.
-    if (glGetStringi && gl_get_version() >= 30) {
-        return gl_has_extension_GetStringi(name);
-    } else {
-        return gl_has_extension_GetString(name);
-    }
-}
-
 /// @brief Get the profile of a desktop OpenGL context.
 ///
 /// Return one of WAFFLE_CONTEXT_CORE_PROFILE,
@@ -1022,12 +981,12 @@ gl_has_extension(const char *name)
 /// According to this function, a context has no profile if and only if its
 /// version is 3.0 or lower.
 static enum waffle_enum
-gl_get_profile(void)
+gl_get_profile(struct waffle_context *ctx)
 {
-    int version = gl_get_version();
+    int version = gl_get_version(ctx);
 
     if (version >= 32) {
-        uint32_t profile_mask = 0;
+        GLint profile_mask = 0;
         glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile_mask);
         if (glGetError()) {
             error_printf("Wflinfo", "glGetIntegerv(GL_CONTEXT_PROFILE_MASK) "
@@ -1042,7 +1001,7 @@ gl_get_profile(void)
                          profile_mask);
         }
     } else if (version == 31) {
-        if (gl_has_extension("GL_ARB_compatibility")) {
+        if (waffle_context_has_gl_extension(ctx, "GL_ARB_compatibility")) {
             return WAFFLE_CONTEXT_CORE_PROFILE;
         } else {
             return WAFFLE_CONTEXT_COMPATIBILITY_PROFILE;
@@ -1102,7 +1061,9 @@ wflinfo_try_create_context_gl31(struct waffle_display *dpy,
         error_waffle();
     }
 
-    const enum waffle_enum actual_profile = gl_get_profile();
+    wflinfo_load_gl(ctx);
+
+    const enum waffle_enum actual_profile = gl_get_profile(ctx);
     waffle_make_current(dpy, NULL, NULL);
     if (actual_profile == desired_profile) {
         goto success;
@@ -1223,6 +1184,9 @@ main(int argc, char **argv)
     if (!ok)
         error_waffle();
 
+    // Report the platform that WAFFLE_PLATFORM_AUTO chose.
+    opts.platform = waffle_get_platform();
+
     dpy = waffle_display_connect(NULL);
     if (!dpy)
         error_waffle();
@@ -1232,19 +1196,6 @@ main(int argc, char **argv)
                      waffle_enum_to_string(opts.context_api));
     }
 
-    glGetError = waffle_dl_sym(opts.dl, "glGetError");
-    if (!glGetError)
-        error_get_gl_symbol("glGetError");
-
-    glGetIntegerv = waffle_dl_sym(opts.dl, "glGetIntegerv");
-    if (!glGetIntegerv)
-        error_get_gl_symbol("glGetIntegerv");
-
-    glGetString = waffle_dl_sym(opts.dl, "glGetString");
-    if (!glGetString) {
-        error_get_gl_symbol("glGetString");
-    }
-
     const struct wflinfo_config_attrs config_attrs = {
         .api = opts.context_api,
         .profile = opts.context_profile,
@@ -1264,28 +1215,7 @@ main(int argc, char **argv)
     if (!ok)
         error_waffle();
 
-    // Retrieving GL functions is tricky. When glGetStringi is supported, here
-    // are some boggling variations as of 2014-11-19:
-    //   - Mali drivers on EGL 1.4 expose glGetStringi statically from
-    //     libGLESv2 but not dynamically from eglGetProcAddress. The EGL 1.4 spec
-    //     permits this behavior.
-    //   - EGL 1.5 requires that eglGetStringi be exposed dynamically through
-    //     eglGetProcAddress. Exposing statically with dlsym is optional.
-    //   - Windows requires that glGetStringi be exposed dynamically from
-    //     wglGetProcAddress. Exposing statically from GetProcAddress (Window's
-    //     dlsym equivalent) is optional.
-    //   - Mesa drivers expose glGetStringi statically from libGL and libGLESv2
-    //     and dynamically from eglGetProcAddress and glxGetProcAddress.
-    //   - Mac exposes glGetStringi only statically.
-    //
-    // Try waffle_dl_sym before waffle_get_proc_address because
-    // (1) egl/glXProcAddress can return invalid non-null pointers for
-    // unsupported functions and (2) dlsym returns non-null if and only if the
-    // library exposes the symbol.
-    glGetStringi = waffle_dl_sym(opts.dl, "glGetStringi");
-    if (!glGetStringi) {
-        glGetStringi = waffle_get_proc_address("glGetStringi");
-    }
+    wflinfo_load_gl(ctx);
 
     switch (opts.format) {
         case FORMAT_ORIGINAL:
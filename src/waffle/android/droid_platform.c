@@ -71,7 +71,7 @@ droid_platform_create(void)
     if (!ok)
         goto error;
 
-    self->linux = linux_platform_create();
+    self->linux = linux_platform_create(true);
     if (!self->linux)
         goto error;
 
@@ -106,6 +106,7 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
     .destroy = droid_platform_destroy,
 
     .make_current = wegl_make_current,
+    .release_thread = wegl_release_thread,
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = droid_dl_can_open,
     .dl_sym = droid_dl_sym,
@@ -115,10 +116,12 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
         .destroy = droid_display_disconnect,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = NULL,
+        .get_capabilities = wegl_display_get_capabilities,
     },
 
     .config = {
         .choose = wegl_config_choose,
+        .enumerate = wegl_config_enumerate,
         .destroy = wegl_config_destroy,
         .get_native = NULL,
     },
@@ -127,6 +130,7 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
         .create = wegl_context_create,
         .destroy = wegl_context_destroy,
         .get_native = NULL,
+        .get_priority = wegl_context_get_priority,
     },
 
     .window = {
@@ -26,7 +26,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "wcore_attrib_list.h"
 #include "wcore_error.h"
 
 #include "wegl_config.h"
@@ -45,6 +44,7 @@ droid_window_create(struct wcore_platform *wc_plat,
     struct droid_window *self;
     struct wegl_config *config = wegl_config(wc_config);
     struct droid_display *dpy = droid_display(wc_config->display);
+    bool offscreen, fbo;
     bool ok = true;
 
     (void) wc_plat;
@@ -55,14 +55,21 @@ droid_window_create(struct wcore_platform *wc_plat,
         return NULL;
     }
 
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
-    }
+    if (!wegl_window_parse_attrib_list(attrib_list, &offscreen, &fbo))
+        return NULL;
 
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
+    if (offscreen) {
+        ok = wegl_offscreen_init(&self->wegl, wc_config, width, height, fbo);
+        if (!ok)
+            goto error;
+
+        return &self->wegl.wcore;
+    }
+
     self->pANWContainer = droid_create_surface(width, height,
                                                dpy->pSFContainer);
     if (!self->pANWContainer)
@@ -94,7 +101,8 @@ droid_window_destroy(struct wcore_window *wc_self)
     dpy = droid_display(self->wegl.wcore.display);
 
     ok &= wegl_surface_teardown(&self->wegl);
-    droid_destroy_surface(dpy->pSFContainer, self->pANWContainer);
+    if (self->pANWContainer)
+        droid_destroy_surface(dpy->pSFContainer, self->pANWContainer);
     free(self);
     return ok;
 }
@@ -108,6 +116,9 @@ droid_window_show(struct wcore_window *wc_self)
     if (!self)
         return false;
 
+    if (self->wegl.offscreen)
+        return true;
+
     dpy = droid_display(wc_self->display);
 
     return droid_show_surface(dpy->pSFContainer, self->pANWContainer);
@@ -124,6 +135,9 @@ droid_window_resize(struct wcore_window *wc_self,
     if (!self)
         return false;
 
+    if (self->wegl.offscreen)
+        return wegl_offscreen_resize(&self->wegl, width, height);
+
     dpy = droid_display(wc_self->display);
 
     return droid_resize_surface(dpy->pSFContainer, self->pANWContainer,
@@ -0,0 +1,286 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "threads.h"
+
+#include "api_async.h"
+#include "api_priv.h"
+
+#include "wcore_error.h"
+#include "wcore_platform.h"
+#include "wcore_time.h"
+#include "wcore_util.h"
+
+struct api_async_platform {
+    /// @brief The stand-in. Its waffle_platform is the requested value.
+    struct wcore_platform wcore;
+
+    int32_t probe_timeout;
+
+    thrd_t thread;
+
+    /// @brief Protects everything below.
+    mtx_t mutex;
+
+    /// @brief Set once the thread has been joined.
+    bool joined;
+
+    /// @brief The real platform, or null if its creation failed.
+    struct wcore_platform *real;
+
+    /// @brief The error that the thread emitted if creation failed.
+    enum waffle_error error_code;
+    char *error_message;
+};
+
+DEFINE_CONTAINER_CAST_FUNC(api_async_platform,
+                           struct api_async_platform,
+                           struct wcore_platform,
+                           wcore)
+
+static const struct wcore_platform_vtbl api_async_platform_vtbl;
+
+static int
+api_async_thread(void *arg)
+{
+    struct api_async_platform *self = arg;
+    struct wcore_platform *real;
+
+    real = api_init_platform(self->wcore.waffle_platform,
+                             self->probe_timeout);
+    if (real) {
+        if (real->vtbl->release_thread)
+            real->vtbl->release_thread(real);
+    } else {
+        // Error state is per thread, so keep a copy for api_async_resolve().
+        const struct waffle_error_info *info = wcore_error_get_info();
+
+        self->error_code = info->code;
+        self->error_message = info->message ? strdup(info->message) : NULL;
+    }
+
+    // thrd_join() publishes the result to the joining thread.
+    self->real = real;
+    return 0;
+}
+
+/// @brief Wait for the background thread and return its platform.
+///
+/// Unlike api_async_resolve(), this emits no error.
+static struct wcore_platform*
+api_async_join(struct api_async_platform *self)
+{
+    struct wcore_platform *real;
+    uint64_t start;
+
+    mtx_lock(&self->mutex);
+
+    if (!self->joined) {
+        start = wcore_time_ns();
+        thrd_join(self->thread, NULL);
+        self->wcore.init_time.wait = wcore_time_ns() - start;
+        self->joined = true;
+
+        // waffle_init() set these on the stand-in after creating it, and
+        // the API checks them on the platform that owns each object.
+        if (self->real) {
+            self->real->skip_redundant_make_current =
+                self->wcore.skip_redundant_make_current;
+            self->real->skip_validation = self->wcore.skip_validation;
+            self->real->defer_dl = self->wcore.defer_dl;
+            self->real->cache = self->wcore.cache;
+        }
+    }
+
+    real = self->real;
+    mtx_unlock(&self->mutex);
+    return real;
+}
+
+struct wcore_platform*
+api_async_resolve(struct wcore_platform *wc_plat)
+{
+    struct api_async_platform *self;
+    struct wcore_platform *real;
+
+    if (wc_plat->vtbl != &api_async_platform_vtbl)
+        return wc_plat;
+
+    self = api_async_platform(wc_plat);
+    real = api_async_join(self);
+    if (!real) {
+        wcore_errorf(self->error_code != WAFFLE_NO_ERROR
+                         ? self->error_code : WAFFLE_ERROR_UNKNOWN,
+                     "asynchronous platform initialization failed: %s",
+                     self->error_message ? self->error_message : "");
+    }
+
+    return real;
+}
+
+bool
+api_async_has_pending_ops(struct wcore_platform *wc_plat)
+{
+    struct api_async_platform *self;
+    struct wcore_platform *real = NULL;
+
+    if (wc_plat->vtbl != &api_async_platform_vtbl)
+        return api_atomic_load(&wc_plat->async_op_count) != 0;
+
+    // Before the join, no display exists to start an operation on.
+    self = api_async_platform(wc_plat);
+    mtx_lock(&self->mutex);
+    if (self->joined)
+        real = self->real;
+    mtx_unlock(&self->mutex);
+
+    return real && api_atomic_load(&real->async_op_count) != 0;
+}
+
+struct wcore_platform*
+api_async_platform_create(int32_t platform, int32_t probe_timeout)
+{
+    struct api_async_platform *self;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    if (!wcore_platform_init(&self->wcore)) {
+        free(self);
+        return NULL;
+    }
+
+    self->wcore.vtbl = &api_async_platform_vtbl;
+    self->wcore.waffle_platform = platform;
+    self->probe_timeout = probe_timeout;
+    mtx_init(&self->mutex, mtx_plain);
+
+    if (thrd_create(&self->thread, api_async_thread, self) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "failed to create the platform initialization thread");
+        mtx_destroy(&self->mutex);
+        free(self);
+        return NULL;
+    }
+
+    return &self->wcore;
+}
+
+static bool
+api_async_platform_destroy(struct wcore_platform *wc_self)
+{
+    struct api_async_platform *self = api_async_platform(wc_self);
+    struct wcore_platform *real;
+    bool ok = true;
+
+    real = api_async_join(self);
+    if (real)
+        ok &= real->vtbl->destroy(real);
+
+    ok &= wcore_platform_teardown(wc_self);
+    mtx_destroy(&self->mutex);
+    free(self->error_message);
+    free(self);
+    return ok;
+}
+
+static bool
+api_async_platform_make_current(struct wcore_platform *wc_self,
+                                struct wcore_display *wc_dpy,
+                                struct wcore_window *wc_window,
+                                struct wcore_context *wc_ctx)
+{
+    struct wcore_platform *real = api_async_resolve(wc_self);
+    if (!real)
+        return false;
+
+    return real->vtbl->make_current(real, wc_dpy, wc_window, wc_ctx);
+}
+
+static void*
+api_async_platform_get_proc_address(struct wcore_platform *wc_self,
+                                    const char *name)
+{
+    struct wcore_platform *real = api_async_resolve(wc_self);
+    if (!real)
+        return NULL;
+
+    return real->vtbl->get_proc_address(real, name);
+}
+
+static bool
+api_async_platform_dl_can_open(struct wcore_platform *wc_self,
+                               int32_t waffle_dl)
+{
+    struct wcore_platform *real = api_async_resolve(wc_self);
+    if (!real)
+        return false;
+
+    return real->vtbl->dl_can_open(real, waffle_dl);
+}
+
+static void*
+api_async_platform_dl_sym(struct wcore_platform *wc_self,
+                          int32_t waffle_dl,
+                          const char *name)
+{
+    struct wcore_platform *real = api_async_resolve(wc_self);
+    if (!real)
+        return NULL;
+
+    return real->vtbl->dl_sym(real, waffle_dl, name);
+}
+
+static struct wcore_display*
+api_async_platform_display_connect(struct wcore_platform *wc_self,
+                                   const char *name)
+{
+    struct wcore_platform *real = api_async_resolve(wc_self);
+    if (!real)
+        return NULL;
+
+    return real->vtbl->display.connect(real, name);
+}
+
+// Displays connected through the stand-in belong to the real platform, so
+// the remaining hooks are never reached.
+static const struct wcore_platform_vtbl api_async_platform_vtbl = {
+    .destroy = api_async_platform_destroy,
+
+    .make_current = api_async_platform_make_current,
+    .get_proc_address = api_async_platform_get_proc_address,
+
+    .dl_can_open = api_async_platform_dl_can_open,
+    .dl_sym = api_async_platform_dl_sym,
+
+    .display = {
+        .connect = api_async_platform_display_connect,
+    },
+};
@@ -0,0 +1,91 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct waffle_async_op;
+struct wcore_config;
+struct wcore_context;
+struct wcore_platform;
+
+/// @brief Create a platform for WAFFLE_PLATFORM_ASYNC_INIT.
+///
+/// Return a stand-in at once and create the real platform on a background
+/// thread, as api_init_platform() would. The stand-in waits for the real
+/// platform only when an entry point needs it, and then forwards to it.
+/// Objects created through the stand-in belong to the real platform.
+struct wcore_platform*
+api_async_platform_create(int32_t platform, int32_t probe_timeout);
+
+/// @brief Return the platform that does the work for @a wc_plat.
+///
+/// If @a wc_plat is a stand-in from api_async_platform_create(), wait for
+/// the background thread and return the real platform. If its creation
+/// failed, emit the thread's error and return null. Otherwise return
+/// @a wc_plat itself.
+struct wcore_platform*
+api_async_resolve(struct wcore_platform *wc_plat);
+
+/// @brief Return true if asynchronous operations are pending on the objects
+/// of @a wc_plat, or of its real platform if it is a stand-in. Never waits.
+bool
+api_async_has_pending_ops(struct wcore_platform *wc_plat);
+
+/// @brief Work that an asynchronous operation runs on its own thread.
+///
+/// Return the created object, or emit an error and return null. The
+/// operation owns @a arg and frees it with free() once the work is done.
+typedef void* (*api_async_op_func)(void *arg);
+
+/// @brief Start an operation that runs @a func on a new thread.
+///
+/// The operation belongs to the display of @a config, and the thread calls
+/// the release_thread() hook of its platform before exiting. Until the
+/// operation is finished, destroying @a config, its display, its platform or
+/// @a shared_ctx fails. @a shared_ctx may be null. On failure, emit an
+/// error, free @a arg and return null.
+struct waffle_async_op*
+api_async_op_start(struct wcore_config *config,
+                   struct wcore_context *shared_ctx,
+                   api_async_op_func func,
+                   void *arg);
+
+/// @brief Wait for @a op, destroy it, and return what its work returned.
+///
+/// If @a op does not run @a func, emit WAFFLE_ERROR_BAD_PARAMETER and leave
+/// it alive. If the work failed, emit the error that it emitted.
+void*
+api_async_op_finish(struct waffle_async_op *op, api_async_op_func func);
+
+#ifdef __cplusplus
+}
+#endif
@@ -34,11 +34,16 @@ extern "C" {
 // This header is so sad and lonely... but there is no other appropriate place
 // to define this struct.
 
+struct wcore_platform;
+
 struct api_object {
     /// @brief Display to which object belongs.
     ///
     /// For consistency, a `waffle_display` belongs to itself.
     size_t display_id;
+
+    /// @brief Platform that created the object's display.
+    struct wcore_platform *platform;
 };
 
 #ifdef __cplusplus
@@ -29,17 +29,22 @@
 #include "api_object.h"
 #include "api_priv.h"
 
+#include "wcore_context.h"
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
 
 struct wcore_platform *api_platform = 0;
+long api_platform_count = 0;
 
 bool
 api_check_entry(const struct api_object *obj_list[], int length)
 {
     wcore_error_reset();
 
-    if (!api_platform) {
+    // Objects carry their own platform, so calls that pass objects only
+    // need some platform to be alive. The others use api_platform.
+    if (length == 0 ? !api_platform : api_platform_count_load() == 0) {
         wcore_error(WAFFLE_ERROR_NOT_INITIALIZED);
         return false;
     }
@@ -58,3 +63,41 @@ api_check_entry(const struct api_object *obj_list[], int length)
 
     return true;
 }
+
+bool
+api_check_entry_hot(const struct api_object *obj_list[], int length)
+{
+    if (length > 0 && obj_list[0] && obj_list[0]->platform->skip_validation) {
+        wcore_error_reset();
+        return true;
+    }
+
+    return api_check_entry(obj_list, length);
+}
+
+bool
+api_check_platform(const struct wcore_platform *platform)
+{
+    wcore_error_reset();
+
+    if (!platform) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "null pointer");
+        return false;
+    }
+
+    return true;
+}
+
+void
+api_set_current_context(struct wcore_tinfo *tinfo, struct wcore_context *ctx)
+{
+    if (tinfo->current_context == ctx)
+        return;
+
+    if (tinfo->current_context)
+        api_atomic_add(&tinfo->current_context->current_count, -1);
+    if (ctx)
+        api_atomic_add(&ctx->current_count, 1);
+
+    tinfo->current_context = ctx;
+}
@@ -28,6 +28,10 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "waffle.h"
 
 // WAFFLE_API - Declare that a symbol is in Waffle's public API.
@@ -48,7 +52,9 @@
 #endif
 
 struct api_object;
+struct wcore_context;
 struct wcore_platform;
+struct wcore_tinfo;
 
 /// @brief Managed by waffle_init() and waffle_teardown().
 ///
@@ -56,6 +62,44 @@ struct wcore_platform;
 /// it has been torn down with waffle_teardown().
 extern struct wcore_platform *api_platform;
 
+static inline long
+api_atomic_load(long *p)
+{
+#if defined(_MSC_VER)
+    return _InterlockedOr(p, 0);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void
+api_atomic_add(long *p, long n)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchangeAdd(p, n);
+#else
+    __atomic_add_fetch(p, n, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/// @brief Number of live platforms, including api_platform.
+///
+/// Every API entry reads it, from any thread, so access it only with
+/// api_platform_count_load() and api_platform_count_add().
+extern long api_platform_count;
+
+static inline long
+api_platform_count_load(void)
+{
+    return api_atomic_load(&api_platform_count);
+}
+
+static inline void
+api_platform_count_add(long n)
+{
+    api_atomic_add(&api_platform_count, n);
+}
+
 /// @brief Used to validate most API entry points.
 ///
 /// The objects that the user passed into the API entry point are listed in
@@ -67,3 +111,45 @@ extern struct wcore_platform *api_platform;
 ///     - two objects belong to different displays
 bool
 api_check_entry(const struct api_object *obj_list[], int length);
+
+/// @brief Variant of api_check_entry() for entry points that are called
+/// every frame.
+///
+/// If waffle was initialized with WAFFLE_SKIP_VALIDATION, then only reset
+/// the error state and skip the per-object checks.
+bool
+api_check_entry_hot(const struct api_object *obj_list[], int length);
+
+/// @brief Create the platform for a WAFFLE_PLATFORM_* value.
+///
+/// The platform must have been compiled in.
+struct wcore_platform*
+api_create_platform(int32_t platform);
+
+/// @brief Create the platform for a waffle_init() attribute list.
+///
+/// Like api_create_platform(), but probe if @a platform is
+/// WAFFLE_PLATFORM_AUTO, and record the time taken in
+/// wcore_platform::init_time.
+struct wcore_platform*
+api_init_platform(int32_t platform, int32_t probe_timeout);
+
+/// @brief Entry check for functions that take a waffle_platform handle.
+///
+/// Unlike api_check_entry(), this does not require waffle_init().
+bool
+api_check_platform(const struct wcore_platform *platform);
+
+/// @brief Record @a ctx as the thread's current context.
+///
+/// Keep wcore_context::current_count of the old and new context in step
+/// with wcore_tinfo::current_context.
+void
+api_set_current_context(struct wcore_tinfo *tinfo, struct wcore_context *ctx);
+
+/// @brief Fill the context's GL version and extension set if they are not
+/// yet.
+///
+/// The context must be current on the calling thread.
+bool
+api_gl_info_load(struct wcore_context *ctx);
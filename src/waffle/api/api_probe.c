@@ -0,0 +1,460 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112 // for clock_gettime()
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "threads.h"
+
+#include "api_priv.h"
+#include "api_probe.h"
+
+#include "wcore_display.h"
+#include "wcore_error.h"
+#include "wcore_platform.h"
+#include "wcore_util.h"
+
+/// @brief Platforms tried by WAFFLE_PLATFORM_AUTO, most preferred first.
+///
+/// Display servers come before direct rendering, which comes before
+/// headless rendering. EGL comes before GLX on X11 because it can create
+/// OpenGL ES contexts too.
+static const int32_t api_probe_order[] = {
+#ifdef WAFFLE_HAS_WAYLAND
+    WAFFLE_PLATFORM_WAYLAND,
+#endif
+#ifdef WAFFLE_HAS_X11_EGL
+    WAFFLE_PLATFORM_X11_EGL,
+#endif
+#ifdef WAFFLE_HAS_GLX
+    WAFFLE_PLATFORM_GLX,
+#endif
+#ifdef WAFFLE_HAS_CGL
+    WAFFLE_PLATFORM_CGL,
+#endif
+#ifdef WAFFLE_HAS_WGL
+    WAFFLE_PLATFORM_WGL,
+#endif
+#ifdef WAFFLE_HAS_ANDROID
+    WAFFLE_PLATFORM_ANDROID,
+#endif
+#ifdef WAFFLE_HAS_GBM
+    WAFFLE_PLATFORM_GBM,
+#endif
+#ifdef WAFFLE_HAS_SURFACELESS_EGL
+    WAFFLE_PLATFORM_SURFACELESS_EGL,
+#endif
+    WAFFLE_NONE,
+};
+
+enum {
+    API_PROBE_MAX = sizeof(api_probe_order) / sizeof(api_probe_order[0]) - 1,
+};
+
+struct api_probe_set;
+
+struct api_probe {
+    struct api_probe_set *set;
+    int32_t platform;
+
+    /// @brief Index of the first probe that runs on the same thread.
+    int lane;
+
+    /// @brief Set when the probe finished, or was skipped because an earlier
+    /// probe on its thread succeeded.
+    bool done;
+
+    /// @brief The probed platform, if it succeeded and was not abandoned.
+    struct wcore_platform *result;
+};
+
+/// @brief State shared by the caller and the probe threads.
+///
+/// Probes that outlive the caller's wait can't be cancelled, so the set is
+/// refcounted and freed by whoever releases it last.
+struct api_probe_set {
+    mtx_t mutex;
+    cnd_t cond;
+    int refcount;
+
+    /// @brief Set when the caller stops waiting.
+    ///
+    /// Probes that finish later destroy their own platform, and probes that
+    /// have not started are skipped.
+    bool abandoned;
+
+    struct api_probe probes[API_PROBE_MAX];
+};
+
+/// @brief Protects api_probe_winner and api_probe_threads.
+static mtx_t api_probe_mutex;
+
+/// @brief Signalled when api_probe_threads drops to zero.
+static cnd_t api_probe_idle;
+
+static bool api_probe_init_ok;
+
+/// @brief The platform chosen by the first successful probe, or WAFFLE_NONE.
+static int32_t api_probe_winner = WAFFLE_NONE;
+
+/// @brief Number of probe threads still running, including abandoned ones.
+static int api_probe_threads;
+
+static void
+api_probe_init_once(void)
+{
+    api_probe_init_ok = mtx_init(&api_probe_mutex, mtx_plain) == thrd_success &&
+                        cnd_init(&api_probe_idle) == thrd_success;
+}
+
+/// @brief Whether probing @a platform may set EGL_PLATFORM.
+///
+/// EGL platforms select the native platform through the process-wide
+/// environment when libEGL lacks a platform display extension, and unset it
+/// again on teardown. Such probes must not overlap, so they share one thread
+/// and run in order. That is known only once libEGL is loaded, so all EGL
+/// platforms that set it are treated alike.
+static bool
+api_probe_uses_env(int32_t platform)
+{
+    switch (platform) {
+        case WAFFLE_PLATFORM_GBM:
+        case WAFFLE_PLATFORM_SURFACELESS_EGL:
+        case WAFFLE_PLATFORM_WAYLAND:
+        case WAFFLE_PLATFORM_X11_EGL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void
+api_probe_set_unref(struct api_probe_set *set)
+{
+    bool last;
+
+    mtx_lock(&set->mutex);
+    last = --set->refcount == 0;
+    mtx_unlock(&set->mutex);
+
+    if (!last)
+        return;
+
+    cnd_destroy(&set->cond);
+    mtx_destroy(&set->mutex);
+    free(set);
+}
+
+/// @brief Create the platform and connect its default display.
+static struct wcore_platform*
+api_probe_run(int32_t platform)
+{
+    struct wcore_platform *wc_plat;
+    struct wcore_display *wc_dpy;
+
+    wc_plat = api_create_platform(platform);
+    if (!wc_plat)
+        return NULL;
+
+    wc_dpy = wc_plat->vtbl->display.connect(wc_plat, NULL);
+    if (wc_dpy)
+        wc_plat->vtbl->display.destroy(wc_dpy);
+
+    if (wc_plat->vtbl->release_thread)
+        wc_plat->vtbl->release_thread(wc_plat);
+
+    if (!wc_dpy) {
+        wc_plat->vtbl->destroy(wc_plat);
+        return NULL;
+    }
+
+    return wc_plat;
+}
+
+/// @brief Run the probes of one lane in order.
+///
+/// The lane stops at its first success, because the probes after it in the
+/// same lane could not win. For the EGL lane, that also keeps a later probe
+/// from unsetting EGL_PLATFORM under the winner.
+static int
+api_probe_thread(void *arg)
+{
+    struct api_probe *first = arg;
+    struct api_probe_set *set = first->set;
+    bool skip = false;
+
+    for (int i = (int) (first - set->probes); i < API_PROBE_MAX; ++i) {
+        struct api_probe *probe = &set->probes[i];
+        struct wcore_platform *wc_plat = NULL;
+        bool abandoned;
+
+        if (probe->lane != first->lane)
+            continue;
+
+        mtx_lock(&set->mutex);
+        skip |= set->abandoned;
+        mtx_unlock(&set->mutex);
+
+        if (!skip)
+            wc_plat = api_probe_run(probe->platform);
+
+        mtx_lock(&set->mutex);
+        abandoned = set->abandoned;
+        if (!abandoned)
+            probe->result = wc_plat;
+        probe->done = true;
+        cnd_signal(&set->cond);
+        mtx_unlock(&set->mutex);
+
+        if (abandoned && wc_plat)
+            wc_plat->vtbl->destroy(wc_plat);
+
+        skip |= wc_plat != NULL;
+    }
+
+    api_probe_set_unref(set);
+
+    mtx_lock(&api_probe_mutex);
+    if (--api_probe_threads == 0)
+        cnd_broadcast(&api_probe_idle);
+    mtx_unlock(&api_probe_mutex);
+
+    return 0;
+}
+
+/// @brief Compute the deadline argument of cnd_timedwait().
+static void
+api_probe_deadline(xtime *xt, int32_t timeout_ms)
+{
+#if defined(_WIN32)
+    // The Windows implementation of cnd_timedwait() takes a duration.
+    xt->sec = timeout_ms / 1000;
+    xt->nsec = (timeout_ms % 1000) * 1000000L;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    xt->sec = now.tv_sec + timeout_ms / 1000;
+    xt->nsec = now.tv_nsec + (timeout_ms % 1000) * 1000000L;
+    if (xt->nsec >= 1000000000L) {
+        xt->sec += 1;
+        xt->nsec -= 1000000000L;
+    }
+#endif
+}
+
+/// @brief Whether the winner is known.
+///
+/// It is once a probe succeeded and every probe before it finished, or once
+/// all probes finished. Call with the set's mutex held.
+static bool
+api_probe_decided(const struct api_probe_set *set)
+{
+    for (int i = 0; i < API_PROBE_MAX; ++i) {
+        if (!set->probes[i].done)
+            return false;
+        if (set->probes[i].result)
+            return true;
+    }
+
+    return true;
+}
+
+/// @brief Wait until the probe threads of earlier calls have exited.
+///
+/// Abandoned probes keep running until their platform initializes or fails.
+/// Waiting for them here keeps probes of successive calls from overlapping,
+/// and bounds their lifetime by the next probe. Gives up at @a deadline.
+static void
+api_probe_wait_idle(const xtime *deadline)
+{
+    mtx_lock(&api_probe_mutex);
+    while (api_probe_threads > 0) {
+        if (cnd_timedwait(&api_probe_idle, &api_probe_mutex, deadline) != thrd_success)
+            break;
+    }
+    mtx_unlock(&api_probe_mutex);
+}
+
+static struct wcore_platform*
+api_probe_all(int32_t timeout_ms)
+{
+    struct api_probe_set *set;
+    struct wcore_platform *losers[API_PROBE_MAX];
+    struct wcore_platform *winner = NULL;
+    int num_losers = 0;
+    xtime deadline;
+
+    set = wcore_calloc(sizeof(*set));
+    if (!set)
+        return NULL;
+
+    if (mtx_init(&set->mutex, mtx_plain) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        free(set);
+        return NULL;
+    }
+
+    if (cnd_init(&set->cond) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "cnd_init failed");
+        mtx_destroy(&set->mutex);
+        free(set);
+        return NULL;
+    }
+
+    set->refcount = 1;
+
+    api_probe_deadline(&deadline, timeout_ms);
+    api_probe_wait_idle(&deadline);
+
+    for (int i = 0; i < API_PROBE_MAX; ++i) {
+        struct api_probe *probe = &set->probes[i];
+
+        probe->set = set;
+        probe->platform = api_probe_order[i];
+        probe->lane = i;
+
+        if (api_probe_uses_env(probe->platform)) {
+            for (int j = 0; j < i; ++j) {
+                if (api_probe_uses_env(set->probes[j].platform)) {
+                    probe->lane = j;
+                    break;
+                }
+            }
+        }
+    }
+
+    mtx_lock(&set->mutex);
+
+    for (int i = 0; i < API_PROBE_MAX; ++i) {
+        struct api_probe *probe = &set->probes[i];
+        thrd_t thread;
+
+        if (probe->lane != i)
+            continue;
+
+        ++set->refcount;
+        mtx_lock(&api_probe_mutex);
+        ++api_probe_threads;
+        mtx_unlock(&api_probe_mutex);
+
+        if (thrd_create(&thread, api_probe_thread, probe) != thrd_success) {
+            --set->refcount;
+            mtx_lock(&api_probe_mutex);
+            --api_probe_threads;
+            mtx_unlock(&api_probe_mutex);
+
+            for (int j = i; j < API_PROBE_MAX; ++j) {
+                if (set->probes[j].lane == i)
+                    set->probes[j].done = true;
+            }
+            continue;
+        }
+
+        // Joining would make waffle_init() wait for lower-priority probes,
+        // or hang with a probe stuck in a driver. The thread owns a
+        // reference to the set instead, and api_probe_threads tracks it.
+        thrd_detach(thread);
+    }
+
+    while (!api_probe_decided(set)) {
+        if (cnd_timedwait(&set->cond, &set->mutex, &deadline) != thrd_success)
+            break;
+    }
+
+    set->abandoned = true;
+
+    for (int i = 0; i < API_PROBE_MAX; ++i) {
+        struct wcore_platform *result = set->probes[i].result;
+
+        if (!result)
+            continue;
+
+        if (!winner)
+            winner = result;
+        else
+            losers[num_losers++] = result;
+    }
+
+    mtx_unlock(&set->mutex);
+    api_probe_set_unref(set);
+
+    for (int i = 0; i < num_losers; ++i)
+        losers[i]->vtbl->destroy(losers[i]);
+
+    if (!winner) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "WAFFLE_PLATFORM_AUTO found no usable platform within "
+                     "%d ms", (int) timeout_ms);
+    }
+
+    return winner;
+}
+
+struct wcore_platform*
+api_probe_platform(int32_t timeout_ms)
+{
+    static once_flag flag = ONCE_FLAG_INIT;
+    struct wcore_platform *wc_plat;
+    int32_t winner;
+
+    call_once(&flag, api_probe_init_once);
+    if (!api_probe_init_ok) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init or cnd_init failed");
+        return NULL;
+    }
+
+    mtx_lock(&api_probe_mutex);
+    winner = api_probe_winner;
+    mtx_unlock(&api_probe_mutex);
+
+    if (winner != WAFFLE_NONE) {
+        wc_plat = api_create_platform(winner);
+        if (wc_plat)
+            return wc_plat;
+
+        // The environment changed since the last probe. Probe again.
+        wcore_error_reset();
+    }
+
+    // With a single candidate there is nothing to choose from.
+    if (API_PROBE_MAX == 1)
+        return api_create_platform(api_probe_order[0]);
+
+    wc_plat = api_probe_all(timeout_ms);
+    if (!wc_plat)
+        return NULL;
+
+    mtx_lock(&api_probe_mutex);
+    api_probe_winner = wc_plat->waffle_platform;
+    mtx_unlock(&api_probe_mutex);
+
+    return wc_plat;
+}
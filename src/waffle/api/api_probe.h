@@ -0,0 +1,58 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct wcore_platform;
+
+/// @brief Default value of WAFFLE_PLATFORM_PROBE_TIMEOUT, in milliseconds.
+#define API_PROBE_DEFAULT_TIMEOUT_MS 2000
+
+/// @brief Create a platform for WAFFLE_PLATFORM_AUTO.
+///
+/// Probe the compiled-in platforms concurrently, one thread per platform,
+/// except that the EGL platforms share one thread because they may set
+/// EGL_PLATFORM. A probe succeeds if it creates the platform and connects the
+/// default display. Once a probe succeeded and all probes before it in
+/// api_probe_order[] finished, or after @a timeout_ms, return the successful
+/// platform that comes first.
+///
+/// Probes still running then are abandoned. They destroy their platform when
+/// they finish, and the next call waits for them before probing again.
+///
+/// The winner is remembered for the lifetime of the process, and later calls
+/// create it directly without probing.
+struct wcore_platform*
+api_probe_platform(int32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,205 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "threads.h"
+
+#include "api_async.h"
+#include "api_object.h"
+#include "api_priv.h"
+
+#include "wcore_config.h"
+#include "wcore_context.h"
+#include "wcore_display.h"
+#include "wcore_error.h"
+#include "wcore_platform.h"
+#include "wcore_util.h"
+
+struct waffle_async_op {
+    /// @brief The display and platform of the object being worked on.
+    struct api_object api;
+
+    /// @brief The config that the object is created from, and the context
+    /// that it shares with or null.
+    struct wcore_config *config;
+    struct wcore_context *shared_ctx;
+
+    api_async_op_func func;
+    void *arg;
+
+    thrd_t thread;
+
+    /// @brief Protects @a done.
+    mtx_t mutex;
+
+    /// @brief Set by the thread once @a result is final.
+    bool done;
+
+    /// @brief What @a func returned.
+    void *result;
+
+    /// @brief The error that @a func emitted if it failed.
+    enum waffle_error error_code;
+    char *error_message;
+};
+
+static int
+api_async_op_thread(void *arg)
+{
+    struct waffle_async_op *self = arg;
+    struct wcore_platform *plat = self->api.platform;
+    void *result;
+
+    result = self->func(self->arg);
+    if (!result) {
+        // Error state is per thread, so keep a copy for the finisher.
+        const struct waffle_error_info *info = wcore_error_get_info();
+
+        self->error_code = info->code;
+        self->error_message = info->message ? strdup(info->message) : NULL;
+    }
+
+    if (plat->vtbl->release_thread)
+        plat->vtbl->release_thread(plat);
+
+    // thrd_join() publishes the result to the finisher, and the mutex
+    // publishes the flag to waffle_async_op_is_done().
+    self->result = result;
+    mtx_lock(&self->mutex);
+    self->done = true;
+    mtx_unlock(&self->mutex);
+    return 0;
+}
+
+// Keep the objects that the operation uses alive while it is pending.
+static void
+api_async_op_hold(struct waffle_async_op *self, long n)
+{
+    struct wcore_config *config = self->config;
+
+    api_atomic_add(&config->async_op_count, n);
+    api_atomic_add(&config->display->async_op_count, n);
+    api_atomic_add(&config->display->platform->async_op_count, n);
+    if (self->shared_ctx)
+        api_atomic_add(&self->shared_ctx->async_op_count, n);
+}
+
+struct waffle_async_op*
+api_async_op_start(struct wcore_config *config,
+                   struct wcore_context *shared_ctx,
+                   api_async_op_func func,
+                   void *arg)
+{
+    struct waffle_async_op *self;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self) {
+        free(arg);
+        return NULL;
+    }
+
+    self->api = config->api;
+    self->config = config;
+    self->shared_ctx = shared_ctx;
+    self->func = func;
+    self->arg = arg;
+
+    if (mtx_init(&self->mutex, mtx_plain) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        free(self);
+        free(arg);
+        return NULL;
+    }
+
+    api_async_op_hold(self, 1);
+
+    if (thrd_create(&self->thread, api_async_op_thread, self) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "failed to create the asynchronous operation thread");
+        api_async_op_hold(self, -1);
+        mtx_destroy(&self->mutex);
+        free(self);
+        free(arg);
+        return NULL;
+    }
+
+    return self;
+}
+
+void*
+api_async_op_finish(struct waffle_async_op *self, api_async_op_func func)
+{
+    void *result;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (self->func != func) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "asynchronous operation creates a different object");
+        return NULL;
+    }
+
+    thrd_join(self->thread, NULL);
+    api_async_op_hold(self, -1);
+
+    result = self->result;
+    if (!result) {
+        wcore_errorf(self->error_code != WAFFLE_NO_ERROR
+                         ? self->error_code : WAFFLE_ERROR_UNKNOWN,
+                     "%s", self->error_message ? self->error_message : "");
+    }
+
+    mtx_destroy(&self->mutex);
+    free(self->error_message);
+    free(self->arg);
+    free(self);
+    return result;
+}
+
+WAFFLE_API bool
+waffle_async_op_is_done(struct waffle_async_op *self)
+{
+    bool done;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    mtx_lock(&self->mutex);
+    done = self->done;
+    mtx_unlock(&self->mutex);
+    return done;
+}
@@ -23,6 +23,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <stdlib.h>
+
 #include "api_priv.h"
 
 #include "wcore_config_attrs.h"
@@ -52,17 +54,57 @@ waffle_config_choose(
     if (!ok)
         return NULL;
 
-    wc_self = api_platform->vtbl->config.choose(api_platform, wc_dpy, &attrs);
+    wc_self = wc_dpy->platform->vtbl->config.choose(wc_dpy->platform, wc_dpy,
+                                                    &attrs);
     if (!wc_self)
         return NULL;
 
     return waffle_config(wc_self);
 }
 
+WAFFLE_API bool
+waffle_config_enumerate(
+        struct waffle_display *dpy,
+        const int32_t attrib_list[],
+        struct waffle_config **configs,
+        int32_t configs_size,
+        int32_t *num_configs)
+{
+    struct wcore_display *wc_dpy = wcore_display(dpy);
+    struct wcore_config_attrs attrs;
+
+    const struct api_object *obj_list[] = {
+        wc_dpy ? &wc_dpy->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!num_configs || (configs && configs_size < 0)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     configs ? "configs_size is negative"
+                             : "num_configs is null");
+        return false;
+    }
+
+    if (!wc_dpy->platform->vtbl->config.enumerate) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    if (!wcore_config_attrs_parse(attrib_list, &attrs))
+        return false;
+
+    return wc_dpy->platform->vtbl->config.enumerate(
+            wc_dpy->platform, wc_dpy, &attrs,
+            (struct wcore_config**) configs, configs_size, num_configs);
+}
+
 WAFFLE_API bool
 waffle_config_destroy(struct waffle_config *self)
 {
     struct wcore_config *wc_self = wcore_config(self);
+    union waffle_native_config *native;
 
     const struct api_object *obj_list[] = {
         wc_self ? &wc_self->api : NULL,
@@ -71,7 +113,25 @@ waffle_config_destroy(struct waffle_config *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
-    return api_platform->vtbl->config.destroy(wc_self);
+    if (api_atomic_load(&wc_self->async_op_count) != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "config has unfinished asynchronous operations");
+        return false;
+    }
+
+    if (api_atomic_load(&wc_self->pool_count) != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "config has contexts in a context pool");
+        return false;
+    }
+
+    native = wc_self->native;
+
+    if (!wc_self->api.platform->vtbl->config.destroy(wc_self))
+        return false;
+
+    free(native);
+    return true;
 }
 
 WAFFLE_API union waffle_native_config*
@@ -86,11 +146,35 @@ waffle_config_get_native(struct waffle_config *self)
     if (!api_check_entry(obj_list, 1))
         return NULL;
 
-    if (api_platform->vtbl->config.get_native) {
-        return api_platform->vtbl->config.get_native(wc_self);
+    if (wc_self->api.platform->vtbl->config.get_native) {
+        return wc_self->api.platform->vtbl->config.get_native(wc_self);
     }
     else {
         wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
         return NULL;
     }
 }
+
+WAFFLE_API const union waffle_native_config*
+waffle_config_peek_native(struct waffle_config *self)
+{
+    struct wcore_config *wc_self = wcore_config(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry_hot(obj_list, 1))
+        return NULL;
+
+    if (wc_self->native)
+        return wc_self->native;
+
+    if (!wc_self->api.platform->vtbl->config.get_native) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self->native = wc_self->api.platform->vtbl->config.get_native(wc_self);
+    return wc_self->native;
+}
@@ -23,11 +23,22 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "threads.h"
+
+#include "api_async.h"
 #include "api_priv.h"
 
+#include "wcore_attrib_list.h"
 #include "wcore_context.h"
+#include "wcore_display.h"
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
+#include "wcore_util.h"
+#include "wcore_window.h"
 
 WAFFLE_API struct waffle_context*
 waffle_context_create(
@@ -37,6 +48,7 @@ waffle_context_create(
     struct wcore_context *wc_self;
     struct wcore_config *wc_config = wcore_config(config);
     struct wcore_context *wc_shared_ctx = wcore_context(shared_ctx);
+    struct wcore_platform *wc_plat;
 
     const struct api_object *obj_list[2];
     int len = 0;
@@ -48,15 +60,93 @@ waffle_context_create(
     if (!api_check_entry(obj_list, len))
         return NULL;
 
-    wc_self = api_platform->vtbl->context.create(api_platform,
-                                                 wc_config,
-                                                 wc_shared_ctx);
+    wc_plat = wc_config->display->platform;
+    wc_self = wc_plat->vtbl->context.create(wc_plat, wc_config, wc_shared_ctx);
     if (!wc_self)
         return NULL;
 
     return waffle_context(wc_self);
 }
 
+struct context_create_args {
+    struct wcore_config *config;
+    struct wcore_context *shared_ctx;
+};
+
+static void*
+context_create_work(void *arg)
+{
+    struct context_create_args *args = arg;
+    struct wcore_platform *wc_plat = args->config->display->platform;
+
+    return wc_plat->vtbl->context.create(wc_plat,
+                                         args->config,
+                                         args->shared_ctx);
+}
+
+WAFFLE_API struct waffle_async_op*
+waffle_context_create_async(
+        struct waffle_config *config,
+        struct waffle_context *shared_ctx)
+{
+    struct wcore_config *wc_config = wcore_config(config);
+    struct wcore_context *wc_shared_ctx = wcore_context(shared_ctx);
+    struct context_create_args *args;
+
+    const struct api_object *obj_list[2];
+    int len = 0;
+
+    obj_list[len++] = wc_config ? &wc_config->api : NULL;
+    if (wc_shared_ctx)
+        obj_list[len++] = &wc_shared_ctx->api;
+
+    if (!api_check_entry(obj_list, len))
+        return NULL;
+
+    args = wcore_malloc(sizeof(*args));
+    if (!args)
+        return NULL;
+
+    args->config = wc_config;
+    args->shared_ctx = wc_shared_ctx;
+
+    return api_async_op_start(wc_config, wc_shared_ctx,
+                              context_create_work, args);
+}
+
+WAFFLE_API struct waffle_context*
+waffle_context_create_finish(struct waffle_async_op *op)
+{
+    return waffle_context(api_async_op_finish(op, context_create_work));
+}
+
+static bool
+context_destroy(struct wcore_context *wc_self)
+{
+    union waffle_native_context *native;
+    struct wcore_tinfo *tinfo;
+    bool is_current;
+
+    tinfo = wcore_tinfo_get();
+    is_current = tinfo->current_context == wc_self;
+    native = wc_self->native;
+
+    if (!wc_self->api.platform->vtbl->context.destroy(wc_self))
+        return false;
+
+    free(native);
+
+    if (is_current) {
+        tinfo->current_context = NULL;
+        tinfo->current_is_stale = true;
+    }
+
+    return true;
+}
+
+static void
+context_pool_forget(struct wcore_context *wc_ctx);
+
 WAFFLE_API bool
 waffle_context_destroy(struct waffle_context *self)
 {
@@ -69,7 +159,24 @@ waffle_context_destroy(struct waffle_context *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
-    return api_platform->vtbl->context.destroy(wc_self);
+    if (api_atomic_load(&wc_self->async_op_count) != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "context has unfinished asynchronous operations");
+        return false;
+    }
+
+    if (api_atomic_load(&wc_self->pool_count) != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "context is the shared context of contexts in a "
+                     "context pool");
+        return false;
+    }
+
+    // The caller took the context over from its pool.
+    if (wc_self->pool)
+        context_pool_forget(wc_self);
+
+    return context_destroy(wc_self);
 }
 
 WAFFLE_API union waffle_native_context*
@@ -84,11 +191,676 @@ waffle_context_get_native(struct waffle_context *self)
     if (!api_check_entry(obj_list, 1))
         return NULL;
 
-    if (api_platform->vtbl->context.get_native) {
-        return api_platform->vtbl->context.get_native(wc_self);
+    if (wc_self->api.platform->vtbl->context.get_native) {
+        return wc_self->api.platform->vtbl->context.get_native(wc_self);
     }
     else {
         wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
         return NULL;
     }
 }
+
+WAFFLE_API const union waffle_native_context*
+waffle_context_peek_native(struct waffle_context *self)
+{
+    struct wcore_context *wc_self = wcore_context(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry_hot(obj_list, 1))
+        return NULL;
+
+    if (wc_self->native)
+        return wc_self->native;
+
+    if (!wc_self->api.platform->vtbl->context.get_native) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self->native = wc_self->api.platform->vtbl->context.get_native(wc_self);
+    return wc_self->native;
+}
+
+WAFFLE_API bool
+waffle_context_get_priority(struct waffle_context *self,
+                            int32_t *priority)
+{
+    struct wcore_context *wc_self = wcore_context(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!priority) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "priority is null");
+        return false;
+    }
+
+    if (!wc_self->api.platform->vtbl->context.get_priority) {
+        *priority = WAFFLE_CONTEXT_PRIORITY_MEDIUM;
+        return true;
+    }
+
+    return wc_self->api.platform->vtbl->context.get_priority(wc_self,
+                                                             priority);
+}
+
+/// @brief A context that the pool created.
+struct context_pool_entry {
+    struct wcore_context *ctx;
+
+    /// @brief The key: contexts are interchangeable only if both match.
+    ///
+    /// The entry holds a pool_count reference on both, so neither can be
+    /// destroyed, and its address reused, while the entry exists.
+    struct wcore_config *config;
+    struct wcore_context *shared_ctx;
+
+    /// @brief Whether the context is in the pool rather than with a caller.
+    bool idle;
+
+    /// @brief When the context was last released. Larger is more recent.
+    uint64_t stamp;
+};
+
+struct waffle_context_pool {
+    struct api_object api;
+    mtx_t mutex;
+
+    /// @brief Holds a pool_count reference, so the display can't be
+    /// disconnected before the pool is destroyed.
+    struct wcore_display *display;
+
+    int32_t max_idle;
+    int32_t num_idle;
+
+    struct context_pool_entry *entries;
+    int32_t num_entries;
+    int32_t max_entries;
+
+    uint64_t clock;
+    uint64_t hit_count;
+    uint64_t miss_count;
+};
+
+WAFFLE_API struct waffle_context_pool*
+waffle_context_pool_create(struct waffle_display *dpy, int32_t max_idle)
+{
+    struct wcore_display *wc_dpy = wcore_display(dpy);
+    struct waffle_context_pool *self;
+
+    const struct api_object *obj_list[] = {
+        wc_dpy ? &wc_dpy->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (max_idle < 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "max_idle is negative: %d", max_idle);
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    if (mtx_init(&self->mutex, mtx_plain) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        free(self);
+        return NULL;
+    }
+
+    self->api = wc_dpy->api;
+    self->display = wc_dpy;
+    self->max_idle = max_idle;
+    api_atomic_add(&wc_dpy->pool_count, 1);
+    return self;
+}
+
+/// @brief Take (@a n = 1) or drop (@a n = -1) the entry's references on its
+/// key.
+static void
+context_pool_entry_hold(const struct context_pool_entry *e, long n)
+{
+    api_atomic_add(&e->config->pool_count, n);
+    if (e->shared_ctx)
+        api_atomic_add(&e->shared_ctx->pool_count, n);
+}
+
+WAFFLE_API bool
+waffle_context_pool_destroy(struct waffle_context_pool *self)
+{
+    bool ok = true;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    // Acquired contexts now belong to their callers.
+    for (int32_t i = 0; i < self->num_entries; ++i) {
+        self->entries[i].ctx->pool = NULL;
+        context_pool_entry_hold(&self->entries[i], -1);
+        if (self->entries[i].idle)
+            ok &= context_destroy(self->entries[i].ctx);
+    }
+
+    api_atomic_add(&self->display->pool_count, -1);
+    mtx_destroy(&self->mutex);
+    free(self->entries);
+    free(self);
+    return ok;
+}
+
+/// @brief Remove entry @a i and drop its references, not preserving order.
+/// Call with the lock held.
+static void
+context_pool_remove(struct waffle_context_pool *self, int32_t i)
+{
+    self->entries[i].ctx->pool = NULL;
+    context_pool_entry_hold(&self->entries[i], -1);
+    if (self->entries[i].idle)
+        self->num_idle--;
+    self->entries[i] = self->entries[--self->num_entries];
+}
+
+/// @brief Remove the entry of a context that is about to be destroyed.
+static void
+context_pool_forget(struct wcore_context *wc_ctx)
+{
+    struct waffle_context_pool *self = wc_ctx->pool;
+
+    mtx_lock(&self->mutex);
+    for (int32_t i = 0; i < self->num_entries; ++i) {
+        if (self->entries[i].ctx == wc_ctx) {
+            context_pool_remove(self, i);
+            break;
+        }
+    }
+    mtx_unlock(&self->mutex);
+}
+
+WAFFLE_API struct waffle_context*
+waffle_context_pool_acquire(struct waffle_context_pool *self,
+                            struct waffle_config *config,
+                            struct waffle_context *shared_ctx)
+{
+    struct wcore_config *wc_config = wcore_config(config);
+    struct wcore_context *wc_shared_ctx = wcore_context(shared_ctx);
+    struct wcore_context *wc_ctx;
+    struct wcore_platform *wc_plat;
+    int32_t best = -1;
+
+    const struct api_object *obj_list[3];
+    int len = 0;
+
+    obj_list[len++] = self ? &self->api : NULL;
+    obj_list[len++] = wc_config ? &wc_config->api : NULL;
+    if (wc_shared_ctx)
+        obj_list[len++] = &wc_shared_ctx->api;
+
+    if (!api_check_entry(obj_list, len))
+        return NULL;
+
+    mtx_lock(&self->mutex);
+
+    // Prefer the most recently released context; it is the likeliest to
+    // still be warm in the driver's caches.
+    for (int32_t i = 0; i < self->num_entries; ++i) {
+        const struct context_pool_entry *e = &self->entries[i];
+
+        if (e->idle && e->config == wc_config &&
+            e->shared_ctx == wc_shared_ctx &&
+            (best < 0 || e->stamp > self->entries[best].stamp))
+            best = i;
+    }
+
+    if (best >= 0) {
+        self->entries[best].idle = false;
+        self->num_idle--;
+        self->hit_count++;
+        wc_ctx = self->entries[best].ctx;
+        mtx_unlock(&self->mutex);
+        return waffle_context(wc_ctx);
+    }
+
+    self->miss_count++;
+    mtx_unlock(&self->mutex);
+
+    // Create outside the lock, as that is the slow part.
+    wc_plat = wc_config->display->platform;
+    wc_ctx = wc_plat->vtbl->context.create(wc_plat, wc_config, wc_shared_ctx);
+    if (!wc_ctx)
+        return NULL;
+
+    mtx_lock(&self->mutex);
+
+    if (self->num_entries == self->max_entries) {
+        int32_t max_entries = self->max_entries ? 2 * self->max_entries : 8;
+        struct context_pool_entry *entries;
+
+        entries = wcore_realloc(self->entries,
+                                max_entries * sizeof(*entries));
+        if (!entries) {
+            mtx_unlock(&self->mutex);
+            context_destroy(wc_ctx);
+            return NULL;
+        }
+
+        self->entries = entries;
+        self->max_entries = max_entries;
+    }
+
+    self->entries[self->num_entries] = (struct context_pool_entry) {
+        .ctx = wc_ctx,
+        .config = wc_config,
+        .shared_ctx = wc_shared_ctx,
+        .idle = false,
+    };
+    context_pool_entry_hold(&self->entries[self->num_entries++], 1);
+    wc_ctx->pool = self;
+
+    mtx_unlock(&self->mutex);
+    return waffle_context(wc_ctx);
+}
+
+WAFFLE_API bool
+waffle_context_pool_release(struct waffle_context_pool *self,
+                            struct waffle_context *ctx)
+{
+    struct wcore_context *wc_ctx = wcore_context(ctx);
+    struct wcore_context *evicted = NULL;
+    struct wcore_tinfo *tinfo;
+    int32_t index = -1;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+        wc_ctx ? &wc_ctx->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 2))
+        return false;
+
+    // The next caller must find the context unbound, as a new one would be.
+    // Only the thread it is current on can unbind it.
+    tinfo = wcore_tinfo_get();
+    if (tinfo->current_context == wc_ctx) {
+        struct wcore_display *wc_dpy = wc_ctx->display;
+
+        if (!wc_dpy->platform->vtbl->make_current(wc_dpy->platform, wc_dpy,
+                                                  NULL, NULL))
+            return false;
+
+        tinfo->current_window = NULL;
+        api_set_current_context(tinfo, NULL);
+        tinfo->current_is_stale = false;
+    }
+    else if (api_atomic_load(&wc_ctx->current_count) != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "context is current on another thread");
+        return false;
+    }
+
+    mtx_lock(&self->mutex);
+
+    for (int32_t i = 0; i < self->num_entries; ++i) {
+        if (self->entries[i].ctx == wc_ctx) {
+            index = i;
+            break;
+        }
+    }
+
+    if (index < 0 || self->entries[index].idle) {
+        mtx_unlock(&self->mutex);
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "context is not acquired from this pool");
+        return false;
+    }
+
+    self->entries[index].idle = true;
+    self->entries[index].stamp = ++self->clock;
+    self->num_idle++;
+
+    // Evict the least recently released context.
+    if (self->num_idle > self->max_idle) {
+        int32_t lru = -1;
+
+        for (int32_t i = 0; i < self->num_entries; ++i) {
+            const struct context_pool_entry *e = &self->entries[i];
+
+            if (e->idle && (lru < 0 || e->stamp < self->entries[lru].stamp))
+                lru = i;
+        }
+
+        evicted = self->entries[lru].ctx;
+        context_pool_remove(self, lru);
+    }
+
+    mtx_unlock(&self->mutex);
+
+    if (evicted)
+        return context_destroy(evicted);
+
+    return true;
+}
+
+WAFFLE_API uint64_t
+waffle_context_pool_get_hit_count(struct waffle_context_pool *self)
+{
+    uint64_t count;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return 0;
+
+    mtx_lock(&self->mutex);
+    count = self->hit_count;
+    mtx_unlock(&self->mutex);
+    return count;
+}
+
+WAFFLE_API uint64_t
+waffle_context_pool_get_miss_count(struct waffle_context_pool *self)
+{
+    uint64_t count;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return 0;
+
+    mtx_lock(&self->mutex);
+    count = self->miss_count;
+    mtx_unlock(&self->mutex);
+    return count;
+}
+
+/// @brief One context of a group, with the surface it binds to.
+struct context_group_member {
+    struct wcore_context *ctx;
+
+    /// @brief Null if the group is surfaceless.
+    struct wcore_window *window;
+};
+
+struct waffle_context_group {
+    struct api_object api;
+    struct wcore_display *display;
+
+    int32_t size;
+    struct context_group_member members[];
+};
+
+/// @brief Like waffle_window_destroy(), but without the entry check, which
+/// would reset the error that a failed group creation emitted.
+static bool
+context_group_window_destroy(struct wcore_window *wc_window)
+{
+    union waffle_native_window *native = wc_window->native;
+    struct wcore_tinfo *tinfo = wcore_tinfo_get();
+    bool is_current = tinfo->current_window == wc_window;
+
+    if (!wc_window->api.platform->vtbl->window.destroy(wc_window))
+        return false;
+
+    free(native);
+
+    if (is_current) {
+        tinfo->current_window = NULL;
+        tinfo->current_is_stale = true;
+    }
+
+    return true;
+}
+
+/// @brief Destroy the members of @a self, and @a self itself.
+static bool
+context_group_destroy(struct waffle_context_group *self)
+{
+    bool ok = true;
+
+    for (int32_t i = 0; i < self->size; ++i) {
+        struct context_group_member *m = &self->members[i];
+
+        if (m->ctx)
+            ok &= context_destroy(m->ctx);
+        if (m->window)
+            ok &= context_group_window_destroy(m->window);
+    }
+
+    free(self);
+    return ok;
+}
+
+WAFFLE_API struct waffle_context_group*
+waffle_context_group_create(struct waffle_config *config,
+                            struct waffle_context *shared_ctx,
+                            const intptr_t attrib_list[])
+{
+    struct wcore_config *wc_config = wcore_config(config);
+    struct wcore_context *wc_shared_ctx = wcore_context(shared_ctx);
+    struct waffle_context_group *self = NULL;
+    struct wcore_platform *wc_plat;
+    intptr_t *attribs;
+    intptr_t size = 0;
+    intptr_t surfaceless = false;
+    intptr_t width = 1, height = 1;
+
+    const intptr_t window_attrib_list[] = { 0 };
+
+    const struct api_object *obj_list[2];
+    int len = 0;
+
+    obj_list[len++] = wc_config ? &wc_config->api : NULL;
+    if (wc_shared_ctx)
+        obj_list[len++] = &wc_shared_ctx->api;
+
+    if (!api_check_entry(obj_list, len))
+        return NULL;
+
+    // A null attrib_list is copied as an empty one, so that the missing
+    // WAFFLE_CONTEXT_GROUP_SIZE is reported below. Only allocation fails.
+    attribs = wcore_attrib_list_copy(attrib_list);
+    if (!attribs)
+        return NULL;
+
+    if (!wcore_attrib_list_pop(attribs, WAFFLE_CONTEXT_GROUP_SIZE, &size)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "required attribute WAFFLE_CONTEXT_GROUP_SIZE is missing");
+        goto done;
+    }
+
+    wcore_attrib_list_pop(attribs, WAFFLE_CONTEXT_GROUP_SURFACELESS,
+                          &surfaceless);
+    wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_WIDTH, &width);
+    wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_HEIGHT, &height);
+
+    if (attribs[0] != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "unrecognized attribute 0x%lx", (long) attribs[0]);
+        goto done;
+    }
+
+    if (size <= 0 || size > INT32_MAX) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_CONTEXT_GROUP_SIZE is not in [1, INT32_MAX]");
+        goto done;
+    }
+
+    if (surfaceless != true && surfaceless != false) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_CONTEXT_GROUP_SURFACELESS has bad value 0x%lx. "
+                     "Must be true(1) or false(0)", (long) surfaceless);
+        goto done;
+    }
+
+    if (width <= 0 || width > INT32_MAX ||
+        height <= 0 || height > INT32_MAX) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_WIDTH and WAFFLE_WINDOW_HEIGHT must be "
+                     "in [1, INT32_MAX]");
+        goto done;
+    }
+
+    if ((size_t) size > (SIZE_MAX - sizeof(*self)) / sizeof(self->members[0])) {
+        wcore_error(WAFFLE_ERROR_BAD_ALLOC);
+        goto done;
+    }
+
+    self = wcore_calloc(sizeof(*self) + size * sizeof(self->members[0]));
+    if (!self)
+        goto done;
+
+    self->api = wc_config->api;
+    self->display = wc_config->display;
+    self->size = (int32_t) size;
+
+    // Share groups are transitive, so sharing each member with one context
+    // makes all of them share with each other.
+    wc_plat = wc_config->display->platform;
+    for (int32_t i = 0; i < self->size; ++i) {
+        struct context_group_member *m = &self->members[i];
+
+        m->ctx = wc_plat->vtbl->context.create(wc_plat, wc_config,
+                                               wc_shared_ctx
+                                                   ? wc_shared_ctx
+                                                   : self->members[0].ctx);
+        if (!m->ctx)
+            goto fail;
+
+        if (!surfaceless) {
+            m->window = wc_plat->vtbl->window.create(wc_plat, wc_config,
+                                                     (int32_t) width,
+                                                     (int32_t) height,
+                                                     window_attrib_list);
+            if (!m->window)
+                goto fail;
+        }
+    }
+
+done:
+    free(attribs);
+    return self;
+
+fail:
+    context_group_destroy(self);
+    self = NULL;
+    goto done;
+}
+
+WAFFLE_API bool
+waffle_context_group_destroy(struct waffle_context_group *self)
+{
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    return context_group_destroy(self);
+}
+
+WAFFLE_API int32_t
+waffle_context_group_get_size(struct waffle_context_group *self)
+{
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return 0;
+
+    return self->size;
+}
+
+/// @brief Return member @a index of @a self, or emit an error and return null.
+static struct context_group_member*
+context_group_get_member(struct waffle_context_group *self, int32_t index)
+{
+    if (index < 0 || index >= self->size) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "index %d is not in a group of %d contexts",
+                     index, self->size);
+        return NULL;
+    }
+
+    return &self->members[index];
+}
+
+WAFFLE_API struct waffle_context*
+waffle_context_group_get_context(struct waffle_context_group *self,
+                                 int32_t index)
+{
+    struct context_group_member *m;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    m = context_group_get_member(self, index);
+    if (!m)
+        return NULL;
+
+    return waffle_context(m->ctx);
+}
+
+WAFFLE_API struct waffle_window*
+waffle_context_group_get_window(struct waffle_context_group *self,
+                                int32_t index)
+{
+    struct context_group_member *m;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    m = context_group_get_member(self, index);
+    if (!m)
+        return NULL;
+
+    return waffle_window(m->window);
+}
+
+WAFFLE_API bool
+waffle_context_group_make_current(struct waffle_context_group *self,
+                                  int32_t index)
+{
+    struct context_group_member *m;
+
+    const struct api_object *obj_list[] = {
+        self ? &self->api : NULL,
+    };
+
+    if (!api_check_entry_hot(obj_list, 1))
+        return false;
+
+    m = context_group_get_member(self, index);
+    if (!m)
+        return false;
+
+    return waffle_make_current(waffle_display(self->display),
+                               waffle_window(m->window),
+                               waffle_context(m->ctx));
+}
@@ -23,12 +23,20 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <stdlib.h>
+
 #include "api_priv.h"
 
+#include "wcore_cache.h"
+#include "wcore_config.h"
+#include "wcore_config_attrs.h"
+#include "wcore_context.h"
 #include "wcore_error.h"
 #include "wcore_display.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
 #include "wcore_util.h"
+#include "wcore_window.h"
 
 WAFFLE_API struct waffle_display*
 waffle_display_connect(const char *name)
@@ -45,10 +53,32 @@ waffle_display_connect(const char *name)
     return waffle_display(wc_self);
 }
 
+WAFFLE_API struct waffle_display*
+waffle_display_connect_platform(struct waffle_platform *platform,
+                                const char *name)
+{
+    struct wcore_platform *wc_plat = wcore_platform(platform);
+    struct wcore_display *wc_self;
+
+    if (!api_check_platform(wc_plat))
+        return NULL;
+
+    wc_self = wc_plat->vtbl->display.connect(wc_plat, name);
+    if (!wc_self)
+        return NULL;
+
+    return waffle_display(wc_self);
+}
+
 WAFFLE_API bool
 waffle_display_disconnect(struct waffle_display *self)
 {
     struct wcore_display *wc_self = wcore_display(self);
+    union waffle_native_display *native;
+    struct waffle_display_capabilities *capabilities;
+    struct wcore_config_table *config_table;
+    struct wcore_tinfo *tinfo;
+    bool is_current;
 
     const struct api_object *obj_list[] = {
         wc_self ? &wc_self->api : NULL,
@@ -57,7 +87,37 @@ waffle_display_disconnect(struct waffle_display *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
-    return api_platform->vtbl->display.destroy(wc_self);
+    if (api_atomic_load(&wc_self->async_op_count) != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "display has unfinished asynchronous operations");
+        return false;
+    }
+
+    if (api_atomic_load(&wc_self->pool_count) != 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "display has context pools");
+        return false;
+    }
+
+    tinfo = wcore_tinfo_get();
+    is_current = tinfo->current_display == wc_self;
+    native = wc_self->native;
+    capabilities = wc_self->capabilities;
+    config_table = wc_self->config_table;
+
+    if (!wc_self->api.platform->vtbl->display.destroy(wc_self))
+        return false;
+
+    free(native);
+    free(capabilities);
+    wcore_config_table_destroy(config_table);
+
+    if (is_current) {
+        tinfo->current_display = NULL;
+        tinfo->current_is_stale = true;
+    }
+
+    return true;
 }
 
 WAFFLE_API bool
@@ -86,7 +146,7 @@ waffle_display_supports_context_api(
             return false;
     }
 
-    return api_platform->vtbl->display.supports_context_api(wc_self,
+    return wc_self->api.platform->vtbl->display.supports_context_api(wc_self,
                                                             context_api);
 }
 
@@ -102,11 +162,332 @@ waffle_display_get_native(struct waffle_display *self)
     if (!api_check_entry(obj_list, 1))
         return NULL;
 
-    if (api_platform->vtbl->display.get_native) {
-        return api_platform->vtbl->display.get_native(wc_self);
+    if (wc_self->api.platform->vtbl->display.get_native) {
+        return wc_self->api.platform->vtbl->display.get_native(wc_self);
     }
     else {
         wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
         return NULL;
     }
 }
+
+WAFFLE_API const union waffle_native_display*
+waffle_display_peek_native(struct waffle_display *self)
+{
+    struct wcore_display *wc_self = wcore_display(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry_hot(obj_list, 1))
+        return NULL;
+
+    if (wc_self->native)
+        return wc_self->native;
+
+    if (!wc_self->api.platform->vtbl->display.get_native) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self->native = wc_self->api.platform->vtbl->display.get_native(wc_self);
+    return wc_self->native;
+}
+
+/// Bind through the platform, and record the binding as waffle_make_current()
+/// would.
+static bool
+waffle_display_probe_make_current(struct wcore_display *wc_dpy,
+                                  struct wcore_window *window,
+                                  struct wcore_context *ctx)
+{
+    struct wcore_platform *wc_plat = wc_dpy->platform;
+    struct wcore_tinfo *tinfo = wcore_tinfo_get();
+
+    if (!wc_plat->vtbl->make_current(wc_plat, wc_dpy, window, ctx))
+        return false;
+
+    tinfo->current_display = wc_dpy;
+    tinfo->current_window = window;
+    api_set_current_context(tinfo, ctx);
+    tinfo->current_is_stale = false;
+    return true;
+}
+
+/// Create a context for the given request, bind it, and return the version
+/// the driver actually handed out, as 10 * major + minor. Return 0 if any
+/// step fails.
+///
+/// Drivers return the highest version they support for the API and profile
+/// when a lower version is requested, so one context per API and profile
+/// suffices.
+static int32_t
+waffle_display_probe_version(struct wcore_display *wc_dpy,
+                             int32_t context_api,
+                             int32_t profile,
+                             int32_t major,
+                             int32_t minor)
+{
+    static const intptr_t window_attrib_list[] = { 0 };
+    struct wcore_platform *wc_plat = wc_dpy->platform;
+    struct wcore_tinfo *tinfo = wcore_tinfo_get();
+    struct wcore_config *config = NULL;
+    struct wcore_context *ctx = NULL;
+    struct wcore_window *window = NULL;
+    struct wcore_config_attrs attrs;
+    int32_t attrib_list[16];
+    int32_t version = 0;
+    int i = 0;
+
+    if (!wc_plat->vtbl->display.supports_context_api(wc_dpy, context_api))
+        return 0;
+
+    attrib_list[i++] = WAFFLE_CONTEXT_API;
+    attrib_list[i++] = context_api;
+
+    if (major) {
+        attrib_list[i++] = WAFFLE_CONTEXT_MAJOR_VERSION;
+        attrib_list[i++] = major;
+        attrib_list[i++] = WAFFLE_CONTEXT_MINOR_VERSION;
+        attrib_list[i++] = minor;
+    }
+
+    if (profile) {
+        attrib_list[i++] = WAFFLE_CONTEXT_PROFILE;
+        attrib_list[i++] = profile;
+    }
+
+    attrib_list[i++] = 0;
+
+    if (!wcore_config_attrs_parse(attrib_list, &attrs))
+        return 0;
+
+    config = wc_plat->vtbl->config.choose(wc_plat, wc_dpy, &attrs);
+    if (!config)
+        goto out;
+
+    ctx = wc_plat->vtbl->context.create(wc_plat, config, NULL);
+    if (!ctx)
+        goto out;
+
+    // Not every platform and API can bind a context without a surface.
+    if (!waffle_display_probe_make_current(wc_dpy, NULL, ctx)) {
+        window = wc_plat->vtbl->window.create(wc_plat, config, 1, 1,
+                                              window_attrib_list);
+        if (!window)
+            goto out;
+
+        if (!waffle_display_probe_make_current(wc_dpy, window, ctx))
+            goto out;
+    }
+
+    if (api_gl_info_load(ctx))
+        version = 10 * ctx->gl_major_version + ctx->gl_minor_version;
+
+    waffle_display_probe_make_current(wc_dpy, NULL, NULL);
+
+out:
+    // The probe objects must not outlive the call in the bookkeeping, even
+    // if releasing the thread failed.
+    if (tinfo->current_window == window)
+        tinfo->current_window = NULL;
+    if (ctx && tinfo->current_context == ctx)
+        tinfo->current_context = NULL;
+
+    if (window)
+        wc_plat->vtbl->window.destroy(window);
+    if (ctx)
+        wc_plat->vtbl->context.destroy(ctx);
+    if (config)
+        wc_plat->vtbl->config.destroy(config);
+
+    return version;
+}
+
+/// Probe the maximum context versions with as few contexts as possible:
+/// one per API and profile, plus an OpenGL ES 3 context only if the
+/// OpenGL ES 2 request did not already yield version 3.0 or later.
+///
+/// Return false if the caller's binding could not be restored afterwards.
+/// The thread is then released.
+static bool
+waffle_display_probe_versions(struct wcore_display *wc_self,
+                              struct waffle_display_capabilities *caps)
+{
+    struct wcore_tinfo *tinfo = wcore_tinfo_get();
+    struct wcore_display *old_dpy = tinfo->current_display;
+    struct wcore_window *old_window = tinfo->current_window;
+    struct wcore_context *old_ctx = tinfo->current_context;
+    bool old_is_stale = tinfo->current_is_stale;
+    bool ok = true;
+
+    // The native APIs of two platforms don't know about each other, as in
+    // waffle_make_current().
+    if (old_dpy && old_dpy->platform != wc_self->platform) {
+        if (!old_dpy->platform->vtbl->make_current(old_dpy->platform,
+                                                   old_dpy, NULL, NULL))
+            return false;
+    }
+
+    WCORE_ERROR_DISABLED({
+        caps->opengl_compat_version =
+            waffle_display_probe_version(wc_self, WAFFLE_CONTEXT_OPENGL,
+                                         0, 0, 0);
+        caps->opengl_core_version =
+            waffle_display_probe_version(wc_self, WAFFLE_CONTEXT_OPENGL,
+                                         WAFFLE_CONTEXT_CORE_PROFILE, 3, 2);
+        caps->opengl_es1_version =
+            waffle_display_probe_version(wc_self, WAFFLE_CONTEXT_OPENGL_ES1,
+                                         0, 0, 0);
+        caps->opengl_es_version =
+            waffle_display_probe_version(wc_self, WAFFLE_CONTEXT_OPENGL_ES2,
+                                         0, 0, 0);
+        if (caps->opengl_es_version < 30) {
+            int32_t es3_version =
+                waffle_display_probe_version(wc_self,
+                                             WAFFLE_CONTEXT_OPENGL_ES3,
+                                             0, 0, 0);
+            if (es3_version > caps->opengl_es_version)
+                caps->opengl_es_version = es3_version;
+        }
+    });
+
+    // Each probe released the thread before returning. Rebind the caller's
+    // objects, unless nothing was bound or the binding referenced destroyed
+    // objects; in both cases the released thread satisfies the old
+    // bookkeeping.
+    if (old_dpy && !old_is_stale)
+        ok = old_dpy->platform->vtbl->make_current(old_dpy->platform, old_dpy,
+                                                   old_window, old_ctx);
+
+    if (ok) {
+        tinfo->current_display = old_dpy;
+        tinfo->current_window = old_window;
+        api_set_current_context(tinfo, old_ctx);
+        tinfo->current_is_stale = old_is_stale;
+    } else {
+        tinfo->current_display = NULL;
+        tinfo->current_window = NULL;
+        api_set_current_context(tinfo, NULL);
+        tinfo->current_is_stale = false;
+    }
+
+    return ok;
+}
+
+/// The versions, as stored in the cache.
+struct waffle_display_cached_versions {
+    int32_t opengl_compat_version;
+    int32_t opengl_core_version;
+    int32_t opengl_es1_version;
+    int32_t opengl_es_version;
+};
+
+/// Key the versions by everything the platform hook reported, plus the
+/// identity of the driver build. Return false if the driver cannot be
+/// identified.
+static bool
+waffle_display_cache_key(struct wcore_display *wc_self,
+                         const struct waffle_display_capabilities *caps,
+                         struct wcore_cache_key *key)
+{
+    const int32_t platform = wc_self->platform->waffle_platform;
+    const uint8_t flags[] = {
+        caps->robust_access,
+        caps->debug,
+        caps->no_error,
+        caps->release_behavior_none,
+    };
+
+    wcore_cache_key_init(key, "capabilities");
+    wcore_cache_key_add(key, &platform, sizeof(platform));
+    wcore_cache_key_add(key, flags, sizeof(flags));
+    wcore_cache_key_add_string(key, caps->driver_name);
+    wcore_cache_key_add_string(key, caps->device_path);
+    wcore_cache_key_add(key, &caps->vendor_id, sizeof(caps->vendor_id));
+    wcore_cache_key_add(key, &caps->device_id, sizeof(caps->device_id));
+
+    return wcore_cache_key_add_driver(key);
+}
+
+/// Fill the versions from the cache if WAFFLE_CACHE allows, else probe them
+/// and store them. Return false if probing failed to restore the caller's
+/// binding.
+static bool
+waffle_display_get_versions(struct wcore_display *wc_self,
+                            struct waffle_display_capabilities *caps)
+{
+    struct waffle_display_cached_versions versions;
+    struct wcore_cache_key key;
+    bool use_cache = wc_self->platform->cache &&
+                     waffle_display_cache_key(wc_self, caps, &key);
+
+    if (use_cache && wcore_cache_load(&key, &versions, sizeof(versions))) {
+        caps->opengl_compat_version = versions.opengl_compat_version;
+        caps->opengl_core_version = versions.opengl_core_version;
+        caps->opengl_es1_version = versions.opengl_es1_version;
+        caps->opengl_es_version = versions.opengl_es_version;
+        return true;
+    }
+
+    if (!waffle_display_probe_versions(wc_self, caps))
+        return false;
+
+    if (use_cache) {
+        versions.opengl_compat_version = caps->opengl_compat_version;
+        versions.opengl_core_version = caps->opengl_core_version;
+        versions.opengl_es1_version = caps->opengl_es1_version;
+        versions.opengl_es_version = caps->opengl_es_version;
+        wcore_cache_store(&key, &versions, sizeof(versions));
+    }
+
+    return true;
+}
+
+WAFFLE_API const struct waffle_display_capabilities*
+waffle_display_get_capabilities(struct waffle_display *self)
+{
+    struct wcore_display *wc_self = wcore_display(self);
+    struct waffle_display_capabilities *caps;
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    // Concurrent callers wait for one probe rather than each creating
+    // their own contexts.
+    mtx_lock(&wc_self->capabilities_mutex);
+
+    caps = wc_self->capabilities;
+    if (caps)
+        goto out;
+
+    caps = wcore_calloc(sizeof(*caps));
+    if (!caps)
+        goto out;
+
+    if (wc_self->api.platform->vtbl->display.get_capabilities)
+        wc_self->api.platform->vtbl->display.get_capabilities(wc_self, caps);
+
+    if (!waffle_display_get_versions(wc_self, caps)) {
+        free(caps);
+        caps = NULL;
+        goto out;
+    }
+
+    caps->supports_opengl = caps->opengl_compat_version ||
+                            caps->opengl_core_version;
+    caps->supports_opengl_es1 = caps->opengl_es1_version != 0;
+    caps->supports_opengl_es2 = caps->opengl_es_version != 0;
+    caps->supports_opengl_es3 = caps->opengl_es_version >= 30;
+
+    wc_self->capabilities = caps;
+
+out:
+    mtx_unlock(&wc_self->capabilities_mutex);
+    return caps;
+}
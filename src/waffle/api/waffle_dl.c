@@ -67,3 +67,61 @@ waffle_dl_sym(int32_t dl, const char *name)
 
     return api_platform->vtbl->dl_sym(api_platform, dl, name);
 }
+
+WAFFLE_API bool
+waffle_platform_dl_can_open(struct waffle_platform *self, int32_t dl)
+{
+    struct wcore_platform *wc_self = wcore_platform(self);
+
+    if (!api_check_platform(wc_self))
+        return false;
+
+    if (!waffle_dl_check_enum(dl))
+        return false;
+
+    return wc_self->vtbl->dl_can_open(wc_self, dl);
+}
+
+WAFFLE_API void*
+waffle_platform_dl_sym(struct waffle_platform *self,
+                       int32_t dl,
+                       const char *name)
+{
+    struct wcore_platform *wc_self = wcore_platform(self);
+
+    if (!api_check_platform(wc_self))
+        return NULL;
+
+    if (!waffle_dl_check_enum(dl))
+        return NULL;
+
+    return wc_self->vtbl->dl_sym(wc_self, dl, name);
+}
+
+WAFFLE_API bool
+waffle_dl_sym_many(int32_t dl,
+                   const char *const names[],
+                   void *syms[],
+                   size_t count)
+{
+    bool ok = true;
+
+    if (!api_check_entry(NULL, 0))
+        return false;
+
+    if (!waffle_dl_check_enum(dl))
+        return false;
+
+    if (count > 0 && (names == NULL || syms == NULL)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "names and syms must not be null");
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        syms[i] = api_platform->vtbl->dl_sym(api_platform, dl, names[i]);
+        ok &= syms[i] != NULL;
+    }
+
+    return ok;
+}
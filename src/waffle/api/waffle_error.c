@@ -41,6 +41,18 @@ waffle_error_get_info(void)
     return wcore_error_get_info();
 }
 
+WAFFLE_API uint32_t
+waffle_error_get_history_count(void)
+{
+    return wcore_error_get_history_count();
+}
+
+WAFFLE_API const struct waffle_error_info*
+waffle_error_get_history_info(uint32_t index)
+{
+    return wcore_error_get_history_info(index);
+}
+
 WAFFLE_API const char*
 waffle_error_to_string(enum waffle_error e)
 {
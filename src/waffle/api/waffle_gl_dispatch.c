@@ -0,0 +1,310 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "threads.h"
+
+#include "api_priv.h"
+
+#include "wcore_context.h"
+#include "wcore_display.h"
+#include "wcore_error.h"
+#include "wcore_ext_set.h"
+#include "wcore_gl_proc.h"
+#include "wcore_platform.h"
+#include "wcore_tinfo.h"
+#include "wcore_util.h"
+
+enum {
+    GL_VERSION = 0x1F02,
+    GL_EXTENSIONS = 0x1F03,
+    GL_NUM_EXTENSIONS = 0x821D,
+};
+
+/// @brief Protects wcore_context::gl_dispatch and the GL info while they
+/// are filled.
+static mtx_t waffle_gl_dispatch_mutex;
+static once_flag waffle_gl_dispatch_once = ONCE_FLAG_INIT;
+
+static void
+waffle_gl_dispatch_init_once(void)
+{
+    mtx_init(&waffle_gl_dispatch_mutex, mtx_plain);
+}
+
+static struct waffle_gl_dispatch*
+waffle_gl_dispatch_create(struct wcore_context *ctx)
+{
+    struct waffle_gl_dispatch *self;
+    struct wcore_gl_proc_loader loader;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    self->size = sizeof(*self);
+
+    wcore_gl_proc_loader_init(&loader, ctx->display->platform,
+                              ctx->context_api);
+
+#define RETRIEVE_GL_PROC(type, name, params) \
+    self->name = (type (WAFFLE_GL_APIENTRY *) params) \
+        wcore_gl_proc_loader_get(&loader, #name);
+
+    WAFFLE_GL_DISPATCH_FUNCTIONS(RETRIEVE_GL_PROC)
+
+#undef RETRIEVE_GL_PROC
+
+    return self;
+}
+
+/// Fill the context's dispatch table if it is not yet. The context must be
+/// current on the calling thread, and the caller must hold
+/// waffle_gl_dispatch_mutex.
+static bool
+waffle_gl_dispatch_fill_locked(struct wcore_context *ctx)
+{
+    if (wcore_tinfo_get()->current_context != ctx) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "context is not current on the calling thread");
+        return false;
+    }
+
+    if (!ctx->gl_dispatch)
+        ctx->gl_dispatch = waffle_gl_dispatch_create(ctx);
+
+    return ctx->gl_dispatch != NULL;
+}
+
+static bool
+waffle_gl_dispatch_fill(struct wcore_context *ctx)
+{
+    bool ok;
+
+    call_once(&waffle_gl_dispatch_once, waffle_gl_dispatch_init_once);
+    mtx_lock(&waffle_gl_dispatch_mutex);
+    ok = waffle_gl_dispatch_fill_locked(ctx);
+    mtx_unlock(&waffle_gl_dispatch_mutex);
+    return ok;
+}
+
+WAFFLE_API const struct waffle_gl_dispatch*
+waffle_context_get_gl_dispatch(struct waffle_context *self)
+{
+    struct wcore_context *wc_self = wcore_context(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry_hot(obj_list, 1))
+        return NULL;
+
+    if (!waffle_gl_dispatch_fill(wc_self))
+        return NULL;
+
+    return wc_self->gl_dispatch;
+}
+
+/// Concatenate the context's extensions, as enumerated by glGetStringi(), into
+/// one string in the format of glGetString(GL_EXTENSIONS).
+static char*
+waffle_gl_info_join_extensions(const struct waffle_gl_dispatch *gl)
+{
+    const char **exts = NULL;
+    char *str = NULL;
+    char *p;
+    int count = 0;
+    size_t len = 1;
+
+    gl->glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    if (count < 0)
+        count = 0;
+
+    if (count > 0) {
+        exts = wcore_calloc(count * sizeof(*exts));
+        if (!exts)
+            return NULL;
+    }
+
+    // The returned strings are static for the lifetime of the context, so
+    // each is fetched once.
+    for (int i = 0; i < count; ++i) {
+        exts[i] = (const char*) gl->glGetStringi(GL_EXTENSIONS, i);
+        if (exts[i])
+            len += strlen(exts[i]) + 1;
+    }
+
+    str = wcore_malloc(len);
+    if (!str)
+        goto out;
+
+    p = str;
+    for (int i = 0; i < count; ++i) {
+        size_t n;
+
+        if (!exts[i])
+            continue;
+
+        n = strlen(exts[i]);
+        memcpy(p, exts[i], n);
+        p += n;
+        *p++ = ' ';
+    }
+    *p = '\0';
+
+out:
+    free(exts);
+    return str;
+}
+
+/// Fill the context's GL version and extension set. The context must be
+/// current on the calling thread, and the caller must hold
+/// waffle_gl_dispatch_mutex.
+static bool
+waffle_gl_info_load_locked(struct wcore_context *ctx)
+{
+    const struct waffle_gl_dispatch *gl;
+    const char *version_str;
+    const char *p;
+    int major = 0;
+    int minor = 0;
+    bool ok;
+
+    if (ctx->gl_info_valid)
+        return true;
+
+    if (!waffle_gl_dispatch_fill_locked(ctx))
+        return false;
+
+    gl = ctx->gl_dispatch;
+    if (!gl->glGetString || !gl->glGetIntegerv) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "failed to resolve glGetString or glGetIntegerv");
+        return false;
+    }
+
+    version_str = (const char*) gl->glGetString(GL_VERSION);
+    if (!version_str) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glGetString(GL_VERSION) failed");
+        return false;
+    }
+
+    // Skip the "OpenGL ES " or "OpenGL ES-CM " prefix of OpenGL ES.
+    for (p = version_str; *p && !isdigit((unsigned char) *p); ++p)
+        continue;
+
+    if (sscanf(p, "%d.%d", &major, &minor) != 2) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "failed to parse GL_VERSION \"%s\"", version_str);
+        return false;
+    }
+
+    // glGetString(GL_EXTENSIONS) is an error in core profiles.
+    if (major >= 3 && gl->glGetStringi) {
+        char *extensions = waffle_gl_info_join_extensions(gl);
+        if (!extensions)
+            return false;
+
+        ok = wcore_ext_set_init(&ctx->gl_extensions, extensions);
+        free(extensions);
+    } else {
+        ok = wcore_ext_set_init(&ctx->gl_extensions,
+                                (const char*) gl->glGetString(GL_EXTENSIONS));
+    }
+
+    if (!ok)
+        return false;
+
+    ctx->gl_major_version = major;
+    ctx->gl_minor_version = minor;
+    ctx->gl_info_valid = true;
+    return true;
+}
+
+bool
+api_gl_info_load(struct wcore_context *ctx)
+{
+    bool ok;
+
+    call_once(&waffle_gl_dispatch_once, waffle_gl_dispatch_init_once);
+    mtx_lock(&waffle_gl_dispatch_mutex);
+    ok = waffle_gl_info_load_locked(ctx);
+    mtx_unlock(&waffle_gl_dispatch_mutex);
+    return ok;
+}
+
+WAFFLE_API bool
+waffle_context_get_gl_version(struct waffle_context *self,
+                              int32_t *major,
+                              int32_t *minor)
+{
+    struct wcore_context *wc_self = wcore_context(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!api_gl_info_load(wc_self))
+        return false;
+
+    if (major)
+        *major = wc_self->gl_major_version;
+    if (minor)
+        *minor = wc_self->gl_minor_version;
+
+    return true;
+}
+
+WAFFLE_API bool
+waffle_context_has_gl_extension(struct waffle_context *self,
+                                const char *name)
+{
+    struct wcore_context *wc_self = wcore_context(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (name == NULL) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "name is null");
+        return false;
+    }
+
+    if (!api_gl_info_load(wc_self))
+        return false;
+
+    return wcore_ext_set_has(&wc_self->gl_extensions, name);
+}
@@ -24,6 +24,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 #include "c99_compat.h"
 
@@ -32,8 +33,10 @@
 #include "wcore_context.h"
 #include "wcore_display.h"
 #include "wcore_error.h"
+#include "wcore_ext_set.h"
 #include "wcore_platform.h"
 #include "wcore_tinfo.h"
+#include "wcore_util.h"
 #include "wcore_window.h"
 
 WAFFLE_API bool
@@ -73,6 +76,61 @@ waffle_is_extension_in_string(
     }
 }
 
+struct waffle_extension_set {
+    struct wcore_ext_set set;
+};
+
+WAFFLE_API struct waffle_extension_set*
+waffle_extension_set_create(const char *extension_string)
+{
+    struct waffle_extension_set *self;
+
+    wcore_error_reset();
+
+    if (extension_string == NULL) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "extension_string is null");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    if (!wcore_ext_set_init(&self->set, extension_string)) {
+        free(self);
+        return NULL;
+    }
+
+    return self;
+}
+
+WAFFLE_API bool
+waffle_extension_set_has(const struct waffle_extension_set *self,
+                         const char *extension_name)
+{
+    wcore_error_reset();
+
+    if (self == NULL || extension_name == NULL)
+        return false;
+
+    return wcore_ext_set_has(&self->set, extension_name);
+}
+
+WAFFLE_API bool
+waffle_extension_set_destroy(struct waffle_extension_set *self)
+{
+    wcore_error_reset();
+
+    if (self == NULL) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "self is null");
+        return false;
+    }
+
+    wcore_ext_set_teardown(&self->set);
+    free(self);
+    return true;
+}
+
 WAFFLE_API bool
 waffle_make_current(
         struct waffle_display *dpy,
@@ -82,6 +140,8 @@ waffle_make_current(
     struct wcore_display *wc_dpy = wcore_display(dpy);
     struct wcore_window *wc_window = wcore_window(window);
     struct wcore_context *wc_ctx = wcore_context(ctx);
+    struct wcore_platform *wc_plat;
+    struct wcore_display *old_dpy;
     struct wcore_tinfo *tinfo;
 
     const struct api_object *obj_list[3];
@@ -94,18 +154,45 @@ waffle_make_current(
     if (wc_ctx)
         obj_list[len++] = &wc_ctx->api;
 
-    if (!api_check_entry(obj_list, len))
+    if (!api_check_entry_hot(obj_list, len))
         return false;
 
-    ok = api_platform->vtbl->make_current(api_platform, wc_dpy, wc_window,
-                                          wc_ctx);
+    tinfo = wcore_tinfo_get();
+    wc_plat = wc_dpy->platform;
+
+    // Rebinding the current objects is a no-op for the native platform, but
+    // it still reaches the driver, which may flush.
+    if (wc_plat->skip_redundant_make_current &&
+        !tinfo->current_is_stale &&
+        tinfo->current_display == wc_dpy &&
+        tinfo->current_window == wc_window &&
+        tinfo->current_context == wc_ctx) {
+        tinfo->make_current_skip_count++;
+        return true;
+    }
+
+    // The native APIs of two platforms don't know about each other, so
+    // release the thread from the old platform before binding the new one.
+    old_dpy = tinfo->current_display;
+    if (old_dpy && old_dpy->platform != wc_plat) {
+        ok = old_dpy->platform->vtbl->make_current(old_dpy->platform, old_dpy,
+                                                   NULL, NULL);
+        if (!ok)
+            return false;
+
+        tinfo->current_display = NULL;
+        tinfo->current_window = NULL;
+        api_set_current_context(tinfo, NULL);
+    }
+
+    ok = wc_plat->vtbl->make_current(wc_plat, wc_dpy, wc_window, wc_ctx);
     if (!ok)
         return false;
 
-    tinfo = wcore_tinfo_get();
     tinfo->current_display = wc_dpy;
     tinfo->current_window = wc_window;
-    tinfo->current_context = wc_ctx;
+    api_set_current_context(tinfo, wc_ctx);
+    tinfo->current_is_stale = false;
 
     return true;
 }
@@ -128,6 +215,12 @@ waffle_get_current_context(void)
     return waffle_context(wcore_tinfo_get()->current_context);
 }
 
+WAFFLE_API uint64_t
+waffle_get_make_current_skip_count(void)
+{
+    return wcore_tinfo_get()->make_current_skip_count;
+}
+
 WAFFLE_API void*
 waffle_get_proc_address(const char *name)
 {
@@ -136,3 +229,40 @@ waffle_get_proc_address(const char *name)
 
     return api_platform->vtbl->get_proc_address(api_platform, name);
 }
+
+WAFFLE_API void*
+waffle_platform_get_proc_address(struct waffle_platform *self,
+                                 const char *name)
+{
+    struct wcore_platform *wc_self = wcore_platform(self);
+
+    if (!api_check_platform(wc_self))
+        return NULL;
+
+    return wc_self->vtbl->get_proc_address(wc_self, name);
+}
+
+WAFFLE_API bool
+waffle_get_proc_address_many(const char *const names[],
+                             void *procs[],
+                             size_t count)
+{
+    bool ok = true;
+
+    if (!api_check_entry(NULL, 0))
+        return false;
+
+    if (count > 0 && (names == NULL || procs == NULL)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "names and procs must not be null");
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        procs[i] = api_platform->vtbl->get_proc_address(api_platform,
+                                                        names[i]);
+        ok &= procs[i] != NULL;
+    }
+
+    return ok;
+}
@@ -23,10 +23,14 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "api_async.h"
 #include "api_priv.h"
+#include "api_probe.h"
 
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_time.h"
+#include "wcore_util.h"
 
 struct wcore_platform* cgl_platform_create(void);
 struct wcore_platform* droid_platform_create(void);
@@ -37,13 +41,47 @@ struct wcore_platform* wgbm_platform_create(void);
 struct wcore_platform* wgl_platform_create(void);
 struct wcore_platform* sl_platform_create(void);
 
+/// @brief The attributes of waffle_init() and waffle_platform_create().
+struct waffle_init_attrs {
+    int32_t platform;
+    bool skip_redundant_make_current;
+    bool skip_validation;
+    int32_t probe_timeout;
+    bool async_init;
+    bool defer_dl;
+    bool cache;
+};
+
+static bool
+waffle_init_parse_bool(int32_t attr, int32_t value, bool *result)
+{
+    switch (value) {
+        case true:
+        case false:
+            *result = value;
+            return true;
+        default:
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "%s has bad value 0x%x",
+                         wcore_enum_to_string(attr), value);
+            return false;
+    }
+}
+
 static bool
 waffle_init_parse_attrib_list(
         const int32_t attrib_list[],
-        int *platform)
+        struct waffle_init_attrs *attrs)
 {
     bool found_platform = false;
 
+    attrs->skip_redundant_make_current = true;
+    attrs->skip_validation = false;
+    attrs->probe_timeout = API_PROBE_DEFAULT_TIMEOUT_MS;
+    attrs->async_init = false;
+    attrs->defer_dl = false;
+    attrs->cache = false;
+
     for (const int32_t *i = attrib_list; *i != 0; i += 2) {
         const int32_t attr = i[0];
         const int32_t value = i[1];
@@ -54,7 +92,7 @@ waffle_init_parse_attrib_list(
                     #define CASE_DEFINED_PLATFORM(name) \
                         case WAFFLE_PLATFORM_##name : \
                             found_platform = true; \
-                            *platform = value; \
+                            attrs->platform = value; \
                             break;
 
                     #define CASE_UNDEFINED_PLATFORM(name) \
@@ -63,6 +101,8 @@ waffle_init_parse_attrib_list(
                                          "waffle was built without support for WAFFLE_PLATFORM_" #name); \
                             return false;
 
+                    CASE_DEFINED_PLATFORM(AUTO)
+
 #ifdef WAFFLE_HAS_ANDROID
                     CASE_DEFINED_PLATFORM(ANDROID)
 #else
@@ -121,6 +161,37 @@ waffle_init_parse_attrib_list(
                     #undef CASE_UNDEFINED_PLATFORM
                 }
 
+                break;
+            case WAFFLE_SKIP_REDUNDANT_MAKE_CURRENT:
+                if (!waffle_init_parse_bool(attr, value,
+                                            &attrs->skip_redundant_make_current))
+                    return false;
+                break;
+            case WAFFLE_SKIP_VALIDATION:
+                if (!waffle_init_parse_bool(attr, value,
+                                            &attrs->skip_validation))
+                    return false;
+                break;
+            case WAFFLE_PLATFORM_ASYNC_INIT:
+                if (!waffle_init_parse_bool(attr, value, &attrs->async_init))
+                    return false;
+                break;
+            case WAFFLE_DEFER_DL:
+                if (!waffle_init_parse_bool(attr, value, &attrs->defer_dl))
+                    return false;
+                break;
+            case WAFFLE_CACHE:
+                if (!waffle_init_parse_bool(attr, value, &attrs->cache))
+                    return false;
+                break;
+            case WAFFLE_PLATFORM_PROBE_TIMEOUT:
+                if (value <= 0) {
+                    wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                                 "WAFFLE_PLATFORM_PROBE_TIMEOUT has "
+                                 "bad value %d", value);
+                    return false;
+                }
+                attrs->probe_timeout = value;
                 break;
             default:
                 wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
@@ -139,12 +210,12 @@ waffle_init_parse_attrib_list(
     return true;
 }
 
-static struct wcore_platform*
-waffle_init_create_platform(int32_t waffle_platform)
+struct wcore_platform*
+api_create_platform(int32_t platform)
 {
     struct wcore_platform *wc_platform = NULL;
 
-    switch (waffle_platform) {
+    switch (platform) {
 #ifdef WAFFLE_HAS_ANDROID
         case WAFFLE_PLATFORM_ANDROID:
             wc_platform = droid_platform_create();
@@ -191,40 +262,95 @@ waffle_init_create_platform(int32_t waffle_platform)
     }
 
     if (wc_platform)
-        wc_platform->waffle_platform = waffle_platform;
+        wc_platform->waffle_platform = platform;
 
     return wc_platform;
 }
 
-WAFFLE_API bool
-waffle_init(const int32_t *attrib_list)
+struct wcore_platform*
+api_init_platform(int32_t platform, int32_t probe_timeout)
 {
-    bool ok = true;
-    int platform;
+    struct wcore_platform *wc_platform;
+    uint64_t start = wcore_time_ns();
 
-    wcore_error_reset();
+    if (platform == WAFFLE_PLATFORM_AUTO)
+        wc_platform = api_probe_platform(probe_timeout);
+    else
+        wc_platform = api_create_platform(platform);
 
-    if (api_platform) {
-        wcore_error(WAFFLE_ERROR_ALREADY_INITIALIZED);
+    if (wc_platform)
+        wc_platform->init_time.platform = wcore_time_ns() - start;
+
+    return wc_platform;
+}
+
+/// @brief Create a platform from a waffle_init() attribute list.
+///
+/// Each platform is independent of the others, so this serves both
+/// waffle_init() and waffle_platform_create().
+static struct wcore_platform*
+waffle_init_platform(const int32_t attrib_list[])
+{
+    struct wcore_platform *wc_platform;
+    struct waffle_init_attrs attrs;
+
+    if (!waffle_init_parse_attrib_list(attrib_list, &attrs))
+        return NULL;
+
+    if (attrs.async_init)
+        wc_platform = api_async_platform_create(attrs.platform,
+                                                attrs.probe_timeout);
+    else
+        wc_platform = api_init_platform(attrs.platform, attrs.probe_timeout);
+
+    if (!wc_platform)
+        return NULL;
+
+    wc_platform->skip_redundant_make_current =
+        attrs.skip_redundant_make_current;
+    wc_platform->skip_validation = attrs.skip_validation;
+    wc_platform->defer_dl = attrs.defer_dl;
+    wc_platform->cache = attrs.cache;
+
+    api_platform_count_add(1);
+
+    return wc_platform;
+}
+
+static bool
+waffle_init_platform_destroy(struct wcore_platform *wc_platform)
+{
+    if (api_async_has_pending_ops(wc_platform)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "platform has unfinished asynchronous operations");
         return false;
     }
 
-    ok &= waffle_init_parse_attrib_list(attrib_list, &platform);
-    if (!ok)
+    if (!wc_platform->vtbl->destroy(wc_platform))
         return false;
 
-    api_platform = waffle_init_create_platform(platform);
-    if (!api_platform)
-        return false;
+    api_platform_count_add(-1);
 
     return true;
 }
 
 WAFFLE_API bool
-waffle_teardown(void)
+waffle_init(const int32_t *attrib_list)
 {
-    bool ok = true;
+    wcore_error_reset();
 
+    if (api_platform) {
+        wcore_error(WAFFLE_ERROR_ALREADY_INITIALIZED);
+        return false;
+    }
+
+    api_platform = waffle_init_platform(attrib_list);
+    return api_platform != NULL;
+}
+
+WAFFLE_API bool
+waffle_teardown(void)
+{
     wcore_error_reset();
 
     if (!api_platform) {
@@ -232,10 +358,127 @@ waffle_teardown(void)
         return false;
     }
 
-    ok &= api_platform->vtbl->destroy(api_platform);
-    if (!ok)
+    if (!waffle_init_platform_destroy(api_platform))
         return false;
 
     api_platform = NULL;
     return true;
 }
+
+/// @brief Return the WAFFLE_PLATFORM_* value of @a wc_platform.
+///
+/// With WAFFLE_PLATFORM_ASYNC_INIT, only WAFFLE_PLATFORM_AUTO must wait to
+/// learn the answer.
+static int32_t
+waffle_init_get_enum(struct wcore_platform *wc_platform)
+{
+    if (wc_platform->waffle_platform == WAFFLE_PLATFORM_AUTO) {
+        wc_platform = api_async_resolve(wc_platform);
+        if (!wc_platform)
+            return WAFFLE_NONE;
+    }
+
+    return wc_platform->waffle_platform;
+}
+
+static uint64_t
+waffle_init_get_time(struct wcore_platform *wc_platform, int32_t phase)
+{
+    struct wcore_platform *real;
+
+    switch (phase) {
+        case WAFFLE_INIT_TIME_DL_OPEN:
+        case WAFFLE_INIT_TIME_DL_SYM:
+        case WAFFLE_INIT_TIME_PLATFORM:
+        case WAFFLE_INIT_TIME_WAIT:
+            break;
+        default:
+            wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                         "phase has bad value %#x", phase);
+            return 0;
+    }
+
+    // The stand-in of WAFFLE_PLATFORM_ASYNC_INIT measures the wait, and the
+    // real platform the rest.
+    real = api_async_resolve(wc_platform);
+    if (!real)
+        return 0;
+
+    switch (phase) {
+        case WAFFLE_INIT_TIME_DL_OPEN:  return real->init_time.dl_open;
+        case WAFFLE_INIT_TIME_DL_SYM:   return real->init_time.dl_sym;
+        case WAFFLE_INIT_TIME_PLATFORM: return real->init_time.platform;
+        default:                        return wc_platform->init_time.wait;
+    }
+}
+
+WAFFLE_API int32_t
+waffle_get_platform(void)
+{
+    if (!api_check_entry(NULL, 0))
+        return WAFFLE_NONE;
+
+    return waffle_init_get_enum(api_platform);
+}
+
+WAFFLE_API uint64_t
+waffle_get_init_time(int32_t phase)
+{
+    if (!api_check_entry(NULL, 0))
+        return 0;
+
+    return waffle_init_get_time(api_platform, phase);
+}
+
+WAFFLE_API struct waffle_platform*
+waffle_platform_create(const int32_t attrib_list[])
+{
+    wcore_error_reset();
+
+    if (!attrib_list) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "null pointer");
+        return NULL;
+    }
+
+    return waffle_platform(waffle_init_platform(attrib_list));
+}
+
+WAFFLE_API bool
+waffle_platform_destroy(struct waffle_platform *self)
+{
+    struct wcore_platform *wc_self = wcore_platform(self);
+
+    if (!api_check_platform(wc_self))
+        return false;
+
+    if (wc_self == api_platform) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "the platform of waffle_init() is destroyed by "
+                     "waffle_teardown()");
+        return false;
+    }
+
+    return waffle_init_platform_destroy(wc_self);
+}
+
+WAFFLE_API int32_t
+waffle_platform_get_enum(struct waffle_platform *self)
+{
+    struct wcore_platform *wc_self = wcore_platform(self);
+
+    if (!api_check_platform(wc_self))
+        return WAFFLE_NONE;
+
+    return waffle_init_get_enum(wc_self);
+}
+
+WAFFLE_API uint64_t
+waffle_platform_get_init_time(struct waffle_platform *self, int32_t phase)
+{
+    struct wcore_platform *wc_self = wcore_platform(self);
+
+    if (!api_check_platform(wc_self))
+        return 0;
+
+    return waffle_init_get_time(wc_self, phase);
+}
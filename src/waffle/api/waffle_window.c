@@ -24,36 +24,40 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdlib.h>
+#include <string.h>
 
+#include "api_async.h"
 #include "api_priv.h"
 
 #include "wcore_attrib_list.h"
 #include "wcore_config.h"
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
+#include "wcore_util.h"
 #include "wcore_window.h"
 
-WAFFLE_API struct waffle_window*
-waffle_window_create2(
-        struct waffle_config *config,
-        const intptr_t attrib_list[])
+/// @brief Validate the attributes of waffle_window_create2().
+///
+/// On success, return in @a out_attrib_list a copy of @a attrib_list
+/// without the attributes that waffle consumes, which the caller must free.
+static bool
+window_parse_attrib_list(const intptr_t attrib_list[],
+                         intptr_t **out_attrib_list,
+                         int32_t *out_width,
+                         int32_t *out_height)
 {
-    struct wcore_window *wc_self = NULL;
-    struct wcore_config *wc_config = wcore_config(config);
     intptr_t *attrib_list_filtered = NULL;
     intptr_t width = 1, height = 1;
     bool need_size = true;
     intptr_t fullscreen = WAFFLE_DONT_CARE;
 
-    const struct api_object *obj_list[] = {
-        wc_config ? &wc_config->api : NULL,
-    };
-
-    if (!api_check_entry(obj_list, 1)) {
-        goto done;
-    }
-
+    // A null attrib_list is copied as an empty one, so that the missing
+    // WAFFLE_WINDOW_WIDTH is reported below. Only allocation fails, and it
+    // emits WAFFLE_ERROR_BAD_ALLOC.
     attrib_list_filtered = wcore_attrib_list_copy(attrib_list);
+    if (!attrib_list_filtered)
+        return false;
 
     wcore_attrib_list_pop(attrib_list_filtered,
                           WAFFLE_WINDOW_FULLSCREEN, &fullscreen);
@@ -68,53 +72,84 @@ waffle_window_create2(
                      "WAFFLE_WINDOW_FULLSCREEN has bad value 0x%lx. "
                      "Must be true(1), false(0), or WAFFLE_DONT_CARE(-1)",
                      (long)fullscreen);
-        goto done;
+        goto error;
     }
 
     if (!wcore_attrib_list_pop(attrib_list_filtered,
                                WAFFLE_WINDOW_WIDTH, &width) && need_size) {
         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
                      "required attribute WAFFLE_WINDOW_WIDTH is missing");
-        goto done;
+        goto error;
     }
 
     if (!wcore_attrib_list_pop(attrib_list_filtered,
                                WAFFLE_WINDOW_HEIGHT, &height) && need_size) {
         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
                      "required attribute WAFFLE_WINDOW_HEIGHT is missing");
-        goto done;
+        goto error;
     }
 
     if (width <= 0) {
         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
                      "WAFFLE_WINDOW_WIDTH is not positive");
-        goto done;
+        goto error;
     } else if (width > INT32_MAX) {
         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
                      "WAFFLE_WINDOW_WIDTH is greater than INT32_MAX");
-        goto done;
+        goto error;
     }
 
     if (height <= 0) {
         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
                      "WAFFLE_WINDOW_HEIGHT is not positive");
-        goto done;
+        goto error;
     } else if (height > INT32_MAX) {
         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
                      "WAFFLE_WINDOW_HEIGHT is greater than INT32_MAX");
-        goto done;
+        goto error;
     }
 
     if (fullscreen)
         width = height = -1;
 
-    wc_self = api_platform->vtbl->window.create(api_platform,
-                                                wc_config,
-                                                (int32_t) width,
-                                                (int32_t) height,
-                                                attrib_list_filtered);
+    *out_attrib_list = attrib_list_filtered;
+    *out_width = (int32_t) width;
+    *out_height = (int32_t) height;
+    return true;
+
+error:
+    free(attrib_list_filtered);
+    return false;
+}
+
+WAFFLE_API struct waffle_window*
+waffle_window_create2(
+        struct waffle_config *config,
+        const intptr_t attrib_list[])
+{
+    struct wcore_window *wc_self;
+    struct wcore_config *wc_config = wcore_config(config);
+    struct wcore_platform *wc_plat;
+    intptr_t *attrib_list_filtered;
+    int32_t width, height;
+
+    const struct api_object *obj_list[] = {
+        wc_config ? &wc_config->api : NULL,
+    };
 
-done:
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (!window_parse_attrib_list(attrib_list, &attrib_list_filtered,
+                                  &width, &height))
+        return NULL;
+
+    wc_plat = wc_config->display->platform;
+    wc_self = wc_plat->vtbl->window.create(wc_plat,
+                                           wc_config,
+                                           width,
+                                           height,
+                                           attrib_list_filtered);
     free(attrib_list_filtered);
 
     if (!wc_self) {
@@ -138,10 +173,79 @@ waffle_window_create(
     return waffle_window_create2(config, attrib_list);
 }
 
+struct window_create_args {
+    struct wcore_config *config;
+    int32_t width;
+    int32_t height;
+    intptr_t attrib_list[];
+};
+
+static void*
+window_create_work(void *arg)
+{
+    struct window_create_args *args = arg;
+    struct wcore_platform *wc_plat = args->config->display->platform;
+
+    return wc_plat->vtbl->window.create(wc_plat,
+                                        args->config,
+                                        args->width,
+                                        args->height,
+                                        args->attrib_list);
+}
+
+WAFFLE_API struct waffle_async_op*
+waffle_window_create_async(
+        struct waffle_config *config,
+        const intptr_t attrib_list[])
+{
+    struct wcore_config *wc_config = wcore_config(config);
+    struct window_create_args *args;
+    intptr_t *attrib_list_filtered;
+    int32_t width, height;
+    size_t attrib_list_size;
+
+    const struct api_object *obj_list[] = {
+        wc_config ? &wc_config->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    // Validate here so that bad attributes fail at once.
+    if (!window_parse_attrib_list(attrib_list, &attrib_list_filtered,
+                                  &width, &height))
+        return NULL;
+
+    attrib_list_size = (2 * wcore_attrib_list_length(attrib_list_filtered) + 1)
+                       * sizeof(intptr_t);
+    args = wcore_malloc(sizeof(*args) + attrib_list_size);
+    if (!args) {
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    args->config = wc_config;
+    args->width = width;
+    args->height = height;
+    memcpy(args->attrib_list, attrib_list_filtered, attrib_list_size);
+    free(attrib_list_filtered);
+
+    return api_async_op_start(wc_config, NULL, window_create_work, args);
+}
+
+WAFFLE_API struct waffle_window*
+waffle_window_create_finish(struct waffle_async_op *op)
+{
+    return waffle_window(api_async_op_finish(op, window_create_work));
+}
+
 WAFFLE_API bool
 waffle_window_destroy(struct waffle_window *self)
 {
     struct wcore_window *wc_self = wcore_window(self);
+    union waffle_native_window *native;
+    struct wcore_tinfo *tinfo;
+    bool is_current;
 
     const struct api_object *obj_list[] = {
         wc_self ? &wc_self->api : NULL,
@@ -150,7 +254,21 @@ waffle_window_destroy(struct waffle_window *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
-    return api_platform->vtbl->window.destroy(wc_self);
+    tinfo = wcore_tinfo_get();
+    is_current = tinfo->current_window == wc_self;
+    native = wc_self->native;
+
+    if (!wc_self->api.platform->vtbl->window.destroy(wc_self))
+        return false;
+
+    free(native);
+
+    if (is_current) {
+        tinfo->current_window = NULL;
+        tinfo->current_is_stale = true;
+    }
+
+    return true;
 }
 
 WAFFLE_API bool
@@ -165,7 +283,7 @@ waffle_window_show(struct waffle_window *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
-    return api_platform->vtbl->window.show(wc_self);
+    return wc_self->api.platform->vtbl->window.show(wc_self);
 }
 
 WAFFLE_API bool
@@ -183,8 +301,15 @@ waffle_window_resize(
     if (!api_check_entry(obj_list, 1))
         return false;
 
-    if (api_platform->vtbl->window.resize) {
-        return api_platform->vtbl->window.resize(wc_self, width, height);
+    if (wc_self->api.platform->vtbl->window.resize) {
+        if (!wc_self->api.platform->vtbl->window.resize(wc_self, width, height))
+            return false;
+
+        // The resize may have replaced the surface behind the cached
+        // native handles.
+        free(wc_self->native);
+        wc_self->native = NULL;
+        return true;
     }
     else {
         wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
@@ -201,10 +326,10 @@ waffle_window_swap_buffers(struct waffle_window *self)
         wc_self ? &wc_self->api : NULL,
     };
 
-    if (!api_check_entry(obj_list, 1))
+    if (!api_check_entry_hot(obj_list, 1))
         return false;
 
-    return api_platform->vtbl->window.swap_buffers(wc_self);
+    return wc_self->api.platform->vtbl->window.swap_buffers(wc_self);
 }
 
 WAFFLE_API union waffle_native_window*
@@ -219,11 +344,35 @@ waffle_window_get_native(struct waffle_window *self)
     if (!api_check_entry(obj_list, 1))
         return NULL;
 
-    if (api_platform->vtbl->window.get_native) {
-        return api_platform->vtbl->window.get_native(wc_self);
+    if (wc_self->api.platform->vtbl->window.get_native) {
+        return wc_self->api.platform->vtbl->window.get_native(wc_self);
     }
     else {
         wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
         return NULL;
     }
 }
+
+WAFFLE_API const union waffle_native_window*
+waffle_window_peek_native(struct waffle_window *self)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry_hot(obj_list, 1))
+        return NULL;
+
+    if (wc_self->native)
+        return wc_self->native;
+
+    if (!wc_self->api.platform->vtbl->window.get_native) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self->native = wc_self->api.platform->vtbl->window.get_native(wc_self);
+    return wc_self->native;
+}
@@ -0,0 +1,425 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief A persistent cache of results that are expensive to compute.
+///
+/// Each result lives in its own file under $XDG_CACHE_HOME/waffle, named
+/// after its key. A file is a fixed-size header followed by the result's
+/// bytes, with no pointers, so it can be mapped and read in place.
+
+#if defined(__linux__)
+#define _GNU_SOURCE // for dl_iterate_phdr() and environ
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <link.h>
+#endif
+
+#include "wcore_cache.h"
+
+#define WCORE_CACHE_MAGIC 0x43464157u // "WAFC"
+#define WCORE_CACHE_FORMAT_VERSION 1
+
+struct wcore_cache_header {
+    uint32_t magic;
+    uint32_t format_version;
+    uint64_t hash;
+    uint32_t size;
+    uint32_t checksum;
+};
+
+#define FNV1A_64_OFFSET 0xcbf29ce484222325ull
+#define FNV1A_64_PRIME 0x00000100000001b3ull
+
+static uint64_t
+fnv1a_64(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= FNV1A_64_PRIME;
+    }
+
+    return hash;
+}
+
+void
+wcore_cache_key_init(struct wcore_cache_key *key, const char *kind)
+{
+    const uint32_t format_version = WCORE_CACHE_FORMAT_VERSION;
+
+    key->kind = kind;
+    key->hash = FNV1A_64_OFFSET;
+    wcore_cache_key_add(key, &format_version, sizeof(format_version));
+    wcore_cache_key_add_string(key, kind);
+}
+
+void
+wcore_cache_key_add(struct wcore_cache_key *key, const void *data, size_t size)
+{
+    key->hash = fnv1a_64(key->hash, data, size);
+}
+
+void
+wcore_cache_key_add_string(struct wcore_cache_key *key, const char *s)
+{
+    // Include the terminator, so that "ab" + "c" differs from "a" + "bc",
+    // and null differs from "".
+    if (s)
+        wcore_cache_key_add(key, s, strlen(s) + 1);
+    else
+        wcore_cache_key_add(key, "", 0);
+}
+
+#if defined(__linux__)
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
+/// Libraries whose build determines what the driver reports. The EGL and GL
+/// libraries may be GLVND dispatchers, in which case the vendor libraries
+/// and drivers they load match too.
+static const char *const driver_lib_prefixes[] = {
+    "libEGL",
+    "libGL",
+    "libOpenGL",
+    "libglapi",
+    "libgallium",
+    "libnvidia-",
+};
+
+/// Environment variables that change what the driver reports.
+static const char *const driver_env_prefixes[] = {
+    "MESA_",
+    "LIBGL_",
+    "GALLIUM_",
+    "__EGL_",
+    "__GLX_",
+    "__GL_",
+    "WAFFLE_LIB",
+};
+
+static bool
+is_driver_lib(const char *path)
+{
+    const char *name = strrchr(path, '/');
+
+    name = name ? name + 1 : path;
+
+    if (strstr(name, "_dri.so"))
+        return true;
+
+    for (size_t i = 0; i < ARRAY_SIZE(driver_lib_prefixes); ++i) {
+        const char *prefix = driver_lib_prefixes[i];
+        if (strncmp(name, prefix, strlen(prefix)) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+/// Hash the library's GNU build ID. Return false if it has none.
+static bool
+hash_build_id(const struct dl_phdr_info *info, uint64_t *hash)
+{
+    for (int i = 0; i < info->dlpi_phnum; ++i) {
+        const ElfW(Phdr) *phdr = &info->dlpi_phdr[i];
+        size_t align = phdr->p_align == 8 ? 8 : 4;
+        const char *p;
+        const char *end;
+
+        if (phdr->p_type != PT_NOTE)
+            continue;
+
+        p = (const char*) (info->dlpi_addr + phdr->p_vaddr);
+        end = p + phdr->p_memsz;
+
+        while ((size_t) (end - p) >= sizeof(ElfW(Nhdr))) {
+            const ElfW(Nhdr) *note = (const ElfW(Nhdr)*) p;
+            size_t desc_offset = sizeof(*note) +
+                                 ((note->n_namesz + align - 1) & ~(align - 1));
+            size_t next = desc_offset +
+                          ((note->n_descsz + align - 1) & ~(align - 1));
+
+            if (next > (size_t) (end - p))
+                break;
+
+            if (note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4 &&
+                memcmp(p + sizeof(*note), "GNU", 4) == 0) {
+                *hash = fnv1a_64(*hash, p + desc_offset, note->n_descsz);
+                return true;
+            }
+
+            p += next;
+        }
+    }
+
+    return false;
+}
+
+static int
+add_driver_lib(struct dl_phdr_info *info, size_t size, void *data)
+{
+    uint64_t *sum = data;
+    uint64_t hash = FNV1A_64_OFFSET;
+    struct stat st;
+
+    (void) size;
+
+    if (!info->dlpi_name || !is_driver_lib(info->dlpi_name))
+        return 0;
+
+    hash = fnv1a_64(hash, info->dlpi_name, strlen(info->dlpi_name));
+
+    // Without a build ID, a rebuilt library is recognized by its file.
+    if (!hash_build_id(info, &hash)) {
+        if (stat(info->dlpi_name, &st) != 0)
+            return 0;
+
+        hash = fnv1a_64(hash, &st.st_ino, sizeof(st.st_ino));
+        hash = fnv1a_64(hash, &st.st_size, sizeof(st.st_size));
+        hash = fnv1a_64(hash, &st.st_mtime, sizeof(st.st_mtime));
+    }
+
+    // Sum, so that the load order does not matter.
+    *sum += hash;
+    return 0;
+}
+
+bool
+wcore_cache_key_add_driver(struct wcore_cache_key *key)
+{
+    uint64_t libs = 0;
+    uint64_t env = 0;
+
+    dl_iterate_phdr(add_driver_lib, &libs);
+    if (libs == 0)
+        return false;
+
+    for (char **e = environ; *e; ++e) {
+        for (size_t i = 0; i < ARRAY_SIZE(driver_env_prefixes); ++i) {
+            const char *prefix = driver_env_prefixes[i];
+            if (strncmp(*e, prefix, strlen(prefix)) == 0) {
+                env += fnv1a_64(FNV1A_64_OFFSET, *e, strlen(*e));
+                break;
+            }
+        }
+    }
+
+    wcore_cache_key_add(key, &libs, sizeof(libs));
+    wcore_cache_key_add(key, &env, sizeof(env));
+    return true;
+}
+
+#else // !__linux__
+
+bool
+wcore_cache_key_add_driver(struct wcore_cache_key *key)
+{
+    (void) key;
+    return false;
+}
+
+#endif
+
+#if !defined(_WIN32)
+
+/// Write the cache directory to @a buf, creating it if needed.
+static bool
+get_dir(char *buf, size_t buf_size)
+{
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    int n;
+
+    // The XDG Base Directory Specification ignores relative paths.
+    if (xdg && xdg[0] == '/')
+        n = snprintf(buf, buf_size, "%s", xdg);
+    else if (home && home[0])
+        n = snprintf(buf, buf_size, "%s/.cache", home);
+    else
+        return false;
+
+    if (n < 0 || (size_t) n + strlen("/waffle") >= buf_size)
+        return false;
+
+    if (mkdir(buf, 0700) != 0 && errno != EEXIST)
+        return false;
+
+    strcat(buf, "/waffle");
+    return mkdir(buf, 0700) == 0 || errno == EEXIST;
+}
+
+static bool
+get_path(const struct wcore_cache_key *key, char *buf, size_t buf_size)
+{
+    char dir[4096];
+    int n;
+
+    if (!get_dir(dir, sizeof(dir)))
+        return false;
+
+    n = snprintf(buf, buf_size, "%s/%s-%016llx.bin", dir, key->kind,
+                 (unsigned long long) key->hash);
+    return n >= 0 && (size_t) n < buf_size;
+}
+
+bool
+wcore_cache_load(const struct wcore_cache_key *key, void *data, size_t size)
+{
+    const struct wcore_cache_header *header;
+    char path[4096];
+    struct stat st;
+    void *map;
+    bool ok;
+    int fd;
+
+    if (!get_path(key, path, sizeof(path)))
+        return false;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &st) != 0 ||
+        (size_t) st.st_size != sizeof(*header) + size) {
+        close(fd);
+        return false;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    header = map;
+    ok = header->magic == WCORE_CACHE_MAGIC &&
+         header->format_version == WCORE_CACHE_FORMAT_VERSION &&
+         header->hash == key->hash &&
+         header->size == size &&
+         header->checksum ==
+            (uint32_t) fnv1a_64(FNV1A_64_OFFSET, header + 1, size);
+
+    if (ok)
+        memcpy(data, header + 1, size);
+
+    munmap(map, st.st_size);
+    return ok;
+}
+
+static bool
+write_all(int fd, const void *data, size_t size)
+{
+    const char *p = data;
+
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+
+    return true;
+}
+
+bool
+wcore_cache_store(const struct wcore_cache_key *key,
+                  const void *data,
+                  size_t size)
+{
+    struct wcore_cache_header header = {
+        .magic = WCORE_CACHE_MAGIC,
+        .format_version = WCORE_CACHE_FORMAT_VERSION,
+        .hash = key->hash,
+        .size = size,
+        .checksum = (uint32_t) fnv1a_64(FNV1A_64_OFFSET, data, size),
+    };
+    char path[4096];
+    char tmp_path[4096 + 32];
+    bool ok;
+    int fd;
+
+    if (!get_path(key, path, sizeof(path)))
+        return false;
+
+    // Write to a private file and rename it into place, so that readers
+    // never see a partial file. mkstemp() makes the name unique among
+    // threads as well as processes.
+    snprintf(tmp_path, sizeof(tmp_path), "%s.XXXXXX", path);
+
+    fd = mkstemp(tmp_path);
+    if (fd < 0)
+        return false;
+
+    ok = write_all(fd, &header, sizeof(header)) &&
+         write_all(fd, data, size);
+    ok &= close(fd) == 0;
+    ok = ok && rename(tmp_path, path) == 0;
+
+    if (!ok)
+        unlink(tmp_path);
+
+    return ok;
+}
+
+#else // _WIN32
+
+bool
+wcore_cache_load(const struct wcore_cache_key *key, void *data, size_t size)
+{
+    (void) key;
+    (void) data;
+    (void) size;
+    return false;
+}
+
+bool
+wcore_cache_store(const struct wcore_cache_key *key,
+                  const void *data,
+                  size_t size)
+{
+    (void) key;
+    (void) data;
+    (void) size;
+    return false;
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Identifies one cached result.
+///
+/// The hash covers everything the result depends on. Results whose inputs
+/// changed get a new key, so stale files are never read, only orphaned.
+struct wcore_cache_key {
+    /// @brief Names the kind of result, and prefixes the file name.
+    const char *kind;
+    uint64_t hash;
+};
+
+void
+wcore_cache_key_init(struct wcore_cache_key *key, const char *kind);
+
+void
+wcore_cache_key_add(struct wcore_cache_key *key,
+                    const void *data,
+                    size_t size);
+
+/// @brief Add a string, which may be null.
+void
+wcore_cache_key_add_string(struct wcore_cache_key *key, const char *s);
+
+/// @brief Add the identity of the loaded GL driver stack.
+///
+/// That is, the build IDs of the loaded EGL, GL and driver libraries and
+/// the values of the environment variables that steer them. Return false
+/// if the driver cannot be identified, in which case nothing may be cached.
+bool
+wcore_cache_key_add_driver(struct wcore_cache_key *key);
+
+/// @brief Read the result stored under the key.
+///
+/// Return false if there is none, or if it is damaged or of another size.
+/// Never emits an error.
+bool
+wcore_cache_load(const struct wcore_cache_key *key, void *data, size_t size);
+
+/// @brief Store the result under the key, replacing any earlier one.
+///
+/// The file appears atomically, so concurrent processes never see a
+/// partial one. Never emits an error.
+bool
+wcore_cache_store(const struct wcore_cache_key *key,
+                  const void *data,
+                  size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,281 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define _POSIX_C_SOURCE 200809L // for mkdtemp() and setenv()
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <cmocka.h>
+
+#include "threads.h"
+#include "wcore_cache.h"
+
+struct test_state {
+    char dir[64];
+    char path[128];
+};
+
+static int
+setup(void **state) {
+    struct test_state *ts = calloc(1, sizeof(*ts));
+    if (!ts)
+        return -1;
+
+    strcpy(ts->dir, "/tmp/waffle-cache-XXXXXX");
+    if (!mkdtemp(ts->dir)) {
+        free(ts);
+        return -1;
+    }
+
+    setenv("XDG_CACHE_HOME", ts->dir, 1);
+    snprintf(ts->path, sizeof(ts->path), "%s/waffle", ts->dir);
+    *state = ts;
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    struct test_state *ts = *state;
+    struct dirent *entry;
+    char path[512];
+    DIR *dir;
+
+    dir = opendir(ts->path);
+    if (dir) {
+        while ((entry = readdir(dir))) {
+            if (entry->d_name[0] == '.')
+                continue;
+            snprintf(path, sizeof(path), "%s/%s", ts->path, entry->d_name);
+            unlink(path);
+        }
+        closedir(dir);
+    }
+
+    rmdir(ts->path);
+    rmdir(ts->dir);
+    free(ts);
+    return 0;
+}
+
+/// Return the path of the only file in the cache directory.
+static void
+get_file(struct test_state *ts, char *path, size_t size) {
+    struct dirent *entry;
+    DIR *dir;
+    int count = 0;
+
+    dir = opendir(ts->path);
+    assert_non_null(dir);
+
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.')
+            continue;
+        snprintf(path, size, "%s/%s", ts->path, entry->d_name);
+        ++count;
+    }
+
+    closedir(dir);
+    assert_int_equal(count, 1);
+}
+
+static void
+test_wcore_cache_miss_on_empty(void **state) {
+    struct wcore_cache_key key;
+    int32_t data = 0;
+
+    (void) state;
+
+    wcore_cache_key_init(&key, "test");
+    assert_false(wcore_cache_load(&key, &data, sizeof(data)));
+}
+
+static void
+test_wcore_cache_store_then_load(void **state) {
+    struct wcore_cache_key key;
+    const int32_t stored[] = { 46, 32 };
+    int32_t loaded[2] = { 0 };
+
+    (void) state;
+
+    wcore_cache_key_init(&key, "test");
+    wcore_cache_key_add_string(&key, "llvmpipe");
+
+    assert_true(wcore_cache_store(&key, stored, sizeof(stored)));
+    assert_true(wcore_cache_load(&key, loaded, sizeof(loaded)));
+    assert_memory_equal(loaded, stored, sizeof(stored));
+}
+
+static void
+test_wcore_cache_store_replaces(void **state) {
+    struct wcore_cache_key key;
+    int32_t data = 1;
+
+    (void) state;
+
+    wcore_cache_key_init(&key, "test");
+    assert_true(wcore_cache_store(&key, &data, sizeof(data)));
+    data = 2;
+    assert_true(wcore_cache_store(&key, &data, sizeof(data)));
+
+    data = 0;
+    assert_true(wcore_cache_load(&key, &data, sizeof(data)));
+    assert_int_equal(data, 2);
+}
+
+static void
+test_wcore_cache_key_differs(void **state) {
+    struct wcore_cache_key a, b;
+    int32_t data = 1;
+
+    (void) state;
+
+    wcore_cache_key_init(&a, "test");
+    wcore_cache_key_add_string(&a, "ab");
+    wcore_cache_key_add_string(&a, "c");
+
+    wcore_cache_key_init(&b, "test");
+    wcore_cache_key_add_string(&b, "a");
+    wcore_cache_key_add_string(&b, "bc");
+    assert_int_not_equal(a.hash, b.hash);
+
+    assert_true(wcore_cache_store(&a, &data, sizeof(data)));
+    assert_false(wcore_cache_load(&b, &data, sizeof(data)));
+
+    wcore_cache_key_init(&a, "test");
+    wcore_cache_key_add_string(&a, NULL);
+    wcore_cache_key_init(&b, "test");
+    wcore_cache_key_add_string(&b, "");
+    assert_int_not_equal(a.hash, b.hash);
+}
+
+static void
+test_wcore_cache_wrong_size(void **state) {
+    struct wcore_cache_key key;
+    int32_t data = 1;
+    int64_t big = 0;
+
+    (void) state;
+
+    wcore_cache_key_init(&key, "test");
+    assert_true(wcore_cache_store(&key, &data, sizeof(data)));
+    assert_false(wcore_cache_load(&key, &big, sizeof(big)));
+}
+
+static void
+test_wcore_cache_damaged(void **state) {
+    struct test_state *ts = *state;
+    struct wcore_cache_key key;
+    int32_t data = 1;
+    char path[512];
+    FILE *f;
+
+    wcore_cache_key_init(&key, "test");
+    assert_true(wcore_cache_store(&key, &data, sizeof(data)));
+
+    // Flip the last byte of the data.
+    get_file(ts, path, sizeof(path));
+    f = fopen(path, "r+b");
+    assert_non_null(f);
+    fseek(f, -1, SEEK_END);
+    fputc(0x80, f);
+    fclose(f);
+
+    assert_false(wcore_cache_load(&key, &data, sizeof(data)));
+}
+
+#define STORE_THREADS 8
+#define STORE_SIZE 4096
+
+/// Given to thrd_create() in test wcore_cache_concurrent_store.
+static int
+store_thread_start(void *arg) {
+    uint8_t data[STORE_SIZE];
+    struct wcore_cache_key key;
+    bool ok = true;
+
+    memset(data, (int) (intptr_t) arg, sizeof(data));
+    wcore_cache_key_init(&key, "test");
+
+    for (int i = 0; i < 32; ++i)
+        ok &= wcore_cache_store(&key, data, sizeof(data));
+
+    return ok ? 0 : 1;
+}
+
+static void
+test_wcore_cache_concurrent_store(void **state) {
+    struct test_state *ts = *state;
+    thrd_t threads[STORE_THREADS];
+    uint8_t data[STORE_SIZE];
+    struct wcore_cache_key key;
+    char path[512];
+    int exit_code;
+
+    for (intptr_t i = 0; i < STORE_THREADS; ++i) {
+        assert_int_equal(thrd_create(&threads[i], store_thread_start,
+                                     (void *) (i + 1)),
+                         thrd_success);
+    }
+
+    for (int i = 0; i < STORE_THREADS; ++i) {
+        thrd_join(threads[i], &exit_code);
+        assert_int_equal(exit_code, 0);
+    }
+
+    // The entry is one thread's data, whole, and no temporary file is left.
+    wcore_cache_key_init(&key, "test");
+    assert_true(wcore_cache_load(&key, data, sizeof(data)));
+    assert_in_range(data[0], 1, STORE_THREADS);
+    for (int i = 1; i < STORE_SIZE; ++i)
+        assert_int_equal(data[i], data[0]);
+
+    get_file(ts, path, sizeof(path));
+}
+
+int
+main(void) {
+    const struct CMUnitTest tests[] = {
+        #define unit_test_make(name) cmocka_unit_test_setup_teardown(name, setup, teardown)
+
+        unit_test_make(test_wcore_cache_miss_on_empty),
+        unit_test_make(test_wcore_cache_store_then_load),
+        unit_test_make(test_wcore_cache_store_replaces),
+        unit_test_make(test_wcore_cache_key_differs),
+        unit_test_make(test_wcore_cache_wrong_size),
+        unit_test_make(test_wcore_cache_damaged),
+        unit_test_make(test_wcore_cache_concurrent_store),
+
+        #undef unit_test_make
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -47,6 +47,17 @@ struct wcore_config {
     struct api_object api;
     struct wcore_config_attrs attrs;
     struct wcore_display *display;
+
+    /// @brief Filled on the first call to waffle_config_peek_native().
+    union waffle_native_config *native;
+
+    /// @brief Asynchronous operations started on the object and not yet
+    /// finished. Destroying the object fails while it is nonzero.
+    long async_op_count;
+
+    /// @brief Context pool entries keyed on the config. Destroying the
+    /// object fails while it is nonzero.
+    long pool_count;
 };
 
 static inline struct waffle_config*
@@ -68,7 +79,11 @@ wcore_config_init(struct wcore_config *self,
     assert(display);
 
     self->api.display_id = display->api.display_id;
+    self->api.platform = display->api.platform;
     self->display = display;
+    self->native = NULL;
+    self->async_op_count = 0;
+    self->pool_count = 0;
     memcpy(&self->attrs, attrs, sizeof(*attrs));
 
     return true;
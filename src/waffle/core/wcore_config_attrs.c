@@ -55,6 +55,10 @@ check_keys(const int32_t attrib_list[])
             case WAFFLE_CONTEXT_FORWARD_COMPATIBLE:
             case WAFFLE_CONTEXT_DEBUG:
             case WAFFLE_CONTEXT_ROBUST_ACCESS:
+            case WAFFLE_CONTEXT_NO_ERROR:
+            case WAFFLE_CONTEXT_RELEASE_BEHAVIOR:
+            case WAFFLE_CONTEXT_PRIORITY:
+            case WAFFLE_CONTEXT_NO_CONFIG:
             case WAFFLE_RED_SIZE:
             case WAFFLE_GREEN_SIZE:
             case WAFFLE_BLUE_SIZE:
@@ -65,6 +69,7 @@ check_keys(const int32_t attrib_list[])
             case WAFFLE_SAMPLE_BUFFERS:
             case WAFFLE_DOUBLE_BUFFERED:
             case WAFFLE_ACCUM_BUFFER:
+            case WAFFLE_CONFIG_SORT:
                 break;
             default:
                 wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
@@ -293,6 +298,10 @@ set_misc_defaults(struct wcore_config_attrs *attrs)
 
     attrs->context_debug        = false;
     attrs->context_robust       = false;
+    attrs->context_no_error     = false;
+    attrs->context_no_config    = false;
+    attrs->context_release_behavior = WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH;
+    attrs->context_priority     = WAFFLE_CONTEXT_PRIORITY_MEDIUM;
 
     attrs->rgba_size            = 0;
     attrs->red_size             = 0;
@@ -305,6 +314,7 @@ set_misc_defaults(struct wcore_config_attrs *attrs)
     attrs->samples              = 0;
     attrs->double_buffered      = true;
     attrs->accum_buffer         = false;
+    attrs->config_sort          = WAFFLE_CONFIG_SORT_NATIVE;
 
     return true;
 }
@@ -369,10 +379,56 @@ parse_misc(struct wcore_config_attrs *attrs,
 
             CASE_BOOL(WAFFLE_CONTEXT_DEBUG, context_debug, false);
             CASE_BOOL(WAFFLE_CONTEXT_ROBUST_ACCESS, context_robust, false);
+            CASE_BOOL(WAFFLE_CONTEXT_NO_ERROR, context_no_error, false);
+            CASE_BOOL(WAFFLE_CONTEXT_NO_CONFIG, context_no_config, false);
             CASE_BOOL(WAFFLE_SAMPLE_BUFFERS, sample_buffers, DEFAULT_SAMPLE_BUFFERS);
             CASE_BOOL(WAFFLE_DOUBLE_BUFFERED, double_buffered, DEFAULT_DOUBLE_BUFFERED);
             CASE_BOOL(WAFFLE_ACCUM_BUFFER, accum_buffer, DEFAULT_ACCUM_BUFFER);
 
+            case WAFFLE_CONTEXT_RELEASE_BEHAVIOR:
+                switch (value) {
+                    case WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH:
+                    case WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE:
+                        attrs->context_release_behavior = value;
+                        break;
+                    default:
+                        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                                     "WAFFLE_CONTEXT_RELEASE_BEHAVIOR has bad "
+                                     "value 0x%x", value);
+                        return false;
+                }
+                break;
+
+            case WAFFLE_CONTEXT_PRIORITY:
+                switch (value) {
+                    case WAFFLE_CONTEXT_PRIORITY_LOW:
+                    case WAFFLE_CONTEXT_PRIORITY_MEDIUM:
+                    case WAFFLE_CONTEXT_PRIORITY_HIGH:
+                    case WAFFLE_CONTEXT_PRIORITY_REALTIME:
+                        attrs->context_priority = value;
+                        break;
+                    default:
+                        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                                     "WAFFLE_CONTEXT_PRIORITY has bad value "
+                                     "0x%x", value);
+                        return false;
+                }
+                break;
+
+            case WAFFLE_CONFIG_SORT:
+                switch (value) {
+                    case WAFFLE_CONFIG_SORT_NATIVE:
+                    case WAFFLE_CONFIG_SORT_SMALLEST:
+                        attrs->config_sort = value;
+                        break;
+                    default:
+                        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                                     "WAFFLE_CONFIG_SORT has bad value 0x%x",
+                                     value);
+                        return false;
+                }
+                break;
+
             default:
                 wcore_error_internal("%s", "bad attribute key should have "
                                      "been found by check_keys()");
@@ -414,6 +470,17 @@ check_final(struct wcore_config_attrs *attrs)
         return false;
     }
 
+    // From the EGL_KHR_create_context_no_error and
+    // GLX_ARB_create_context_no_error specs: BadMatch is generated if the
+    // no error attribute is true and the debug or robust access flag is set.
+    if (attrs->context_no_error &&
+        (attrs->context_debug || attrs->context_robust)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "%s", "WAFFLE_CONTEXT_NO_ERROR must be false for a "
+                     "debug or robust access context");
+        return false;
+    }
+
     return true;
 }
 
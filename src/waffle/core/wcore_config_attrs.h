@@ -52,9 +52,20 @@ struct wcore_config_attrs {
 
     int32_t samples;
 
+    /// @brief A WAFFLE_CONFIG_SORT_* value.
+    int32_t config_sort;
+
+    /// @brief A WAFFLE_CONTEXT_RELEASE_BEHAVIOR_* value.
+    int32_t context_release_behavior;
+
+    /// @brief A WAFFLE_CONTEXT_PRIORITY_* value.
+    int32_t context_priority;
+
     bool context_forward_compatible;
     bool context_debug;
     bool context_robust;
+    bool context_no_error;
+    bool context_no_config;
     bool double_buffered;
     bool sample_buffers;
     bool accum_buffer;
@@ -67,6 +67,10 @@ setup(void **state) {
         .samples                = 0,
 
         .double_buffered        = true,
+
+        .config_sort            = WAFFLE_CONFIG_SORT_NATIVE,
+        .context_release_behavior = WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH,
+        .context_priority       = WAFFLE_CONTEXT_PRIORITY_MEDIUM,
     };
 
     struct test_state_wcore_config_attrs *ts;
@@ -1089,6 +1093,140 @@ test_wcore_config_attrs_debug_gles3(void **state) {
     assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
 }
 
+static void
+test_wcore_config_attrs_no_error_gles2(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_CONTEXT_NO_ERROR,                true,
+        0,
+    };
+
+    ts->expect_attrs.context_api = WAFFLE_CONTEXT_OPENGL_ES2;
+    ts->expect_attrs.context_major_version = 2;
+    ts->expect_attrs.context_no_error = true;
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
+static void
+test_wcore_config_attrs_no_error_debug(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_NO_ERROR,                true,
+        WAFFLE_CONTEXT_DEBUG,                   true,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_no_error_robust(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES3,
+        WAFFLE_CONTEXT_ROBUST_ACCESS,           true,
+        WAFFLE_CONTEXT_NO_ERROR,                true,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_release_behavior_none(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR,        WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE,
+        0,
+    };
+
+    ts->expect_attrs.context_api = WAFFLE_CONTEXT_OPENGL_ES2;
+    ts->expect_attrs.context_major_version = 2;
+    ts->expect_attrs.context_release_behavior = WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE;
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
+static void
+test_wcore_config_attrs_release_behavior_is_bad(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR,        true,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_priority_high(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_CONTEXT_PRIORITY,                WAFFLE_CONTEXT_PRIORITY_HIGH,
+        0,
+    };
+
+    ts->expect_attrs.context_api = WAFFLE_CONTEXT_OPENGL_ES2;
+    ts->expect_attrs.context_major_version = 2;
+    ts->expect_attrs.context_priority = WAFFLE_CONTEXT_PRIORITY_HIGH;
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
+static void
+test_wcore_config_attrs_priority_is_bad(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_PRIORITY,                WAFFLE_DONT_CARE,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_no_config(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES3,
+        WAFFLE_CONTEXT_NO_CONFIG,               true,
+        0,
+    };
+
+    ts->expect_attrs.context_api = WAFFLE_CONTEXT_OPENGL_ES3;
+    ts->expect_attrs.context_major_version = 3;
+    ts->expect_attrs.context_no_config = true;
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
 int
 main(void) {
     const struct CMUnitTest tests[] = {
@@ -1151,6 +1289,14 @@ main(void) {
         unit_test_make(test_wcore_config_attrs_debug_gles1),
         unit_test_make(test_wcore_config_attrs_debug_gles2),
         unit_test_make(test_wcore_config_attrs_debug_gles3),
+        unit_test_make(test_wcore_config_attrs_no_error_gles2),
+        unit_test_make(test_wcore_config_attrs_no_error_debug),
+        unit_test_make(test_wcore_config_attrs_no_error_robust),
+        unit_test_make(test_wcore_config_attrs_release_behavior_none),
+        unit_test_make(test_wcore_config_attrs_release_behavior_is_bad),
+        unit_test_make(test_wcore_config_attrs_priority_high),
+        unit_test_make(test_wcore_config_attrs_priority_is_bad),
+        unit_test_make(test_wcore_config_attrs_no_config),
 
         #undef unit_test_make
     };
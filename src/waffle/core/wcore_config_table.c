@@ -0,0 +1,265 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "wcore_config_table.h"
+#include "wcore_error.h"
+#include "wcore_util.h"
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
+enum {
+    WCORE_CONFIG_COLUMN_COUNT = 0
+#define X(name) + 1
+    WCORE_CONFIG_TABLE_COLUMNS(X)
+#undef X
+};
+
+/// @brief Sort keys of one matching config. Smaller sorts first.
+struct wcore_config_rank {
+    int32_t key[10];
+    int32_t index;
+};
+
+struct wcore_config_table*
+wcore_config_table_create(int32_t capacity)
+{
+    struct wcore_config_table *self;
+    int32_t *column;
+
+    // One allocation: the table, the native handles, then the columns.
+    self = wcore_calloc(sizeof(*self) +
+                        capacity * sizeof(void*) +
+                        capacity * WCORE_CONFIG_COLUMN_COUNT * sizeof(int32_t));
+    if (!self)
+        return NULL;
+
+    self->native = (void**) (self + 1);
+    column = (int32_t*) (self->native + capacity);
+
+#define X(name) \
+    self->name = column; \
+    column += capacity;
+    WCORE_CONFIG_TABLE_COLUMNS(X)
+#undef X
+
+    return self;
+}
+
+void
+wcore_config_table_destroy(struct wcore_config_table *self)
+{
+    free(self);
+}
+
+/// Clear the matches whose column value is less than @a want.
+static void
+match_at_least(const int32_t *column, int32_t count, int32_t want,
+               uint8_t *match)
+{
+    if (want == WAFFLE_DONT_CARE)
+        return;
+
+    for (int32_t i = 0; i < count; ++i)
+        match[i] &= (column[i] == WAFFLE_DONT_CARE) | (column[i] >= want);
+}
+
+/// Clear the matches whose column value is not @a want.
+static void
+match_exact(const int32_t *column, int32_t count, int32_t want,
+            uint8_t *match)
+{
+    if (want == WAFFLE_DONT_CARE)
+        return;
+
+    for (int32_t i = 0; i < count; ++i)
+        match[i] &= (column[i] == WAFFLE_DONT_CARE) | (column[i] == want);
+}
+
+/// Clear the matches whose column has none of the bits of @a want.
+static void
+match_mask(const int32_t *column, int32_t count, int32_t want,
+           uint8_t *match)
+{
+    for (int32_t i = 0; i < count; ++i)
+        match[i] &= (column[i] & want) != 0;
+}
+
+static int32_t
+api_bit(int32_t context_api)
+{
+    switch (context_api) {
+        case WAFFLE_CONTEXT_OPENGL:     return WCORE_CONFIG_API_OPENGL;
+        case WAFFLE_CONTEXT_OPENGL_ES1: return WCORE_CONFIG_API_OPENGL_ES1;
+        case WAFFLE_CONTEXT_OPENGL_ES2: return WCORE_CONFIG_API_OPENGL_ES2;
+        case WAFFLE_CONTEXT_OPENGL_ES3: return WCORE_CONFIG_API_OPENGL_ES3;
+        default:                        return 0;
+    }
+}
+
+/// Treat WAFFLE_DONT_CARE, which the platform may store, as 0.
+static inline int32_t
+value(const int32_t *column, int32_t i)
+{
+    return column[i] == WAFFLE_DONT_CARE ? 0 : column[i];
+}
+
+/// Rank as eglChooseConfig() and glXChooseFBConfig() do. See the EGL 1.5
+/// spec, section 3.4.1.2, and the GLX 1.4 spec, section 3.3.3.
+static void
+rank_native(const struct wcore_config_table *self,
+            const struct wcore_config_attrs *attrs,
+            int32_t i,
+            struct wcore_config_rank *rank)
+{
+    int32_t color_bits = 0;
+
+    // Only the channels requested with a nonzero size count, and more is
+    // better.
+    if (attrs->red_size > 0)
+        color_bits += value(self->red_size, i);
+    if (attrs->green_size > 0)
+        color_bits += value(self->green_size, i);
+    if (attrs->blue_size > 0)
+        color_bits += value(self->blue_size, i);
+    if (attrs->alpha_size > 0)
+        color_bits += value(self->alpha_size, i);
+
+    rank->key[0] = self->caveat[i];
+    rank->key[1] = -color_bits;
+    rank->key[2] = value(self->buffer_size, i);
+    rank->key[3] = value(self->double_buffered, i);
+    rank->key[4] = value(self->sample_buffers, i);
+    rank->key[5] = value(self->samples, i);
+    rank->key[6] = self->prefer_larger_depth ? -value(self->depth_size, i)
+                                             : value(self->depth_size, i);
+    rank->key[7] = value(self->stencil_size, i);
+    rank->key[8] = -value(self->accum_size, i);
+    rank->key[9] = self->id[i];
+}
+
+/// Rank by the estimated bits per pixel of all buffers, smallest first.
+/// Slow configs still sort last.
+static void
+rank_smallest(const struct wcore_config_table *self,
+              int32_t i,
+              struct wcore_config_rank *rank)
+{
+    int32_t samples = value(self->samples, i);
+    int32_t color_bits = value(self->buffer_size, i);
+    int32_t bits;
+
+    if (self->double_buffered[i] != false)
+        color_bits *= 2;
+
+    bits = (color_bits + value(self->depth_size, i) +
+            value(self->stencil_size, i)) * (samples > 1 ? samples : 1) +
+           4 * value(self->accum_size, i);
+
+    memset(rank, 0, sizeof(*rank));
+    rank->key[0] = self->caveat[i];
+    rank->key[1] = bits;
+    rank->key[2] = samples;
+    rank->key[3] = value(self->depth_size, i);
+    rank->key[4] = value(self->stencil_size, i);
+    rank->key[5] = value(self->buffer_size, i);
+    rank->key[6] = self->id[i];
+}
+
+static int
+compare_rank(const void *a, const void *b)
+{
+    const struct wcore_config_rank *ra = a;
+    const struct wcore_config_rank *rb = b;
+
+    for (size_t k = 0; k < ARRAY_SIZE(ra->key); ++k) {
+        if (ra->key[k] != rb->key[k])
+            return ra->key[k] < rb->key[k] ? -1 : 1;
+    }
+
+    return ra->index < rb->index ? -1 : ra->index > rb->index;
+}
+
+int32_t
+wcore_config_table_match(const struct wcore_config_table *self,
+                         const struct wcore_config_attrs *attrs,
+                         int32_t *indices)
+{
+    const int32_t count = self->count;
+    struct wcore_config_rank *ranks;
+    uint8_t *match;
+    int32_t num_matches = 0;
+
+    if (count == 0)
+        return 0;
+
+    match = wcore_malloc(count);
+    ranks = wcore_malloc(count * sizeof(*ranks));
+    if (!match || !ranks) {
+        free(match);
+        free(ranks);
+        return -1;
+    }
+
+    memset(match, 1, count);
+    match_mask(self->apis, count, api_bit(attrs->context_api), match);
+    match_at_least(self->red_size, count, attrs->red_size, match);
+    match_at_least(self->green_size, count, attrs->green_size, match);
+    match_at_least(self->blue_size, count, attrs->blue_size, match);
+    match_at_least(self->alpha_size, count, attrs->alpha_size, match);
+    match_at_least(self->buffer_size, count, attrs->rgba_size, match);
+    match_at_least(self->depth_size, count, attrs->depth_size, match);
+    match_at_least(self->stencil_size, count, attrs->stencil_size, match);
+    match_at_least(self->sample_buffers, count, attrs->sample_buffers, match);
+    match_at_least(self->samples, count, attrs->samples, match);
+    match_at_least(self->accum_size, count, attrs->accum_buffer, match);
+    match_exact(self->double_buffered, count, attrs->double_buffered, match);
+
+    for (int32_t i = 0; i < count; ++i) {
+        struct wcore_config_rank *rank = &ranks[num_matches];
+
+        if (!match[i])
+            continue;
+
+        if (attrs->config_sort == WAFFLE_CONFIG_SORT_SMALLEST)
+            rank_smallest(self, i, rank);
+        else
+            rank_native(self, attrs, i, rank);
+
+        rank->index = i;
+        ++num_matches;
+    }
+
+    qsort(ranks, num_matches, sizeof(*ranks), compare_rank);
+
+    for (int32_t i = 0; i < num_matches; ++i)
+        indices[i] = ranks[i].index;
+
+    free(match);
+    free(ranks);
+    return num_matches;
+}
@@ -0,0 +1,117 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "wcore_config_attrs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct wcore_display;
+
+/// @brief The WAFFLE_CONTEXT_* APIs, as bits of the `apis` column.
+enum wcore_config_api_bit {
+    WCORE_CONFIG_API_OPENGL     = 1 << 0,
+    WCORE_CONFIG_API_OPENGL_ES1 = 1 << 1,
+    WCORE_CONFIG_API_OPENGL_ES2 = 1 << 2,
+    WCORE_CONFIG_API_OPENGL_ES3 = 1 << 3,
+};
+
+/// @brief Values of the `caveat` column, in the order they sort.
+enum wcore_config_caveat {
+    WCORE_CONFIG_CAVEAT_NONE            = 0,
+    WCORE_CONFIG_CAVEAT_SLOW            = 1,
+    WCORE_CONFIG_CAVEAT_NON_CONFORMANT  = 2,
+};
+
+/// Columns whose value is WAFFLE_DONT_CARE match any request.
+#define WCORE_CONFIG_TABLE_COLUMNS(X) \
+    X(red_size) \
+    X(green_size) \
+    X(blue_size) \
+    X(alpha_size) \
+    X(buffer_size) \
+    X(depth_size) \
+    X(stencil_size) \
+    X(sample_buffers) \
+    X(samples) \
+    X(double_buffered) \
+    X(accum_size) /* of the smallest accumulation channel */ \
+    X(caveat) \
+    X(apis) \
+    X(visual) \
+    X(id)
+
+/// @brief All configs of a display, one column per attribute.
+///
+/// Matching a request reads each column front to back, which the compiler
+/// can vectorize, and never calls into the driver.
+struct wcore_config_table {
+    int32_t count;
+
+#define X(name) int32_t *name;
+    WCORE_CONFIG_TABLE_COLUMNS(X)
+#undef X
+
+    /// @brief The native configs, such as EGLConfig or GLXFBConfig.
+    void **native;
+
+    /// @brief Sort deeper depth buffers first, as GLX does. EGL sorts them
+    /// last.
+    bool prefer_larger_depth;
+};
+
+/// @brief Allocate a table with room for @a capacity configs.
+///
+/// The count starts at 0; the caller appends rows by filling the columns
+/// at index `count++`.
+struct wcore_config_table*
+wcore_config_table_create(int32_t capacity);
+
+void
+wcore_config_table_destroy(struct wcore_config_table *self);
+
+/// @brief Find the configs that satisfy @a attrs.
+///
+/// Write their indices to @a indices, which must have room for `count`
+/// entries, ordered by `attrs->config_sort`, best first. Return how many
+/// matched, or -1 on error.
+int32_t
+wcore_config_table_match(const struct wcore_config_table *self,
+                         const struct wcore_config_attrs *attrs,
+                         int32_t *indices);
+
+/// @brief Create a table of all of a display's configs.
+typedef struct wcore_config_table*
+(*wcore_config_table_create_func)(struct wcore_display *display);
+
+#ifdef __cplusplus
+}
+#endif
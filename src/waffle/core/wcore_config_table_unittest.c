@@ -0,0 +1,260 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "wcore_config_table.h"
+#include "wcore_error.h"
+
+struct row {
+    int32_t red, green, blue, alpha;
+    int32_t depth, stencil;
+    int32_t samples;
+    int32_t double_buffered;
+    int32_t caveat;
+    int32_t apis;
+};
+
+static const struct row rows[] = {
+    // id 0: plain RGBA8
+    {  8,  8,  8,  8,   0, 0, 0, 1, WCORE_CONFIG_CAVEAT_NONE, WCORE_CONFIG_API_OPENGL },
+    // id 1: RGBA8 with depth and stencil
+    {  8,  8,  8,  8,  24, 8, 0, 1, WCORE_CONFIG_CAVEAT_NONE, WCORE_CONFIG_API_OPENGL },
+    // id 2: RGB565, buffering chosen by the surface as on EGL
+    {  5,  6,  5,  0,  16, 0, 0, WAFFLE_DONT_CARE, WCORE_CONFIG_CAVEAT_NONE, WCORE_CONFIG_API_OPENGL },
+    // id 3: RGBA8, 4x multisampled
+    {  8,  8,  8,  8,  24, 8, 4, 1, WCORE_CONFIG_CAVEAT_NONE, WCORE_CONFIG_API_OPENGL },
+    // id 4: RGBA8, slow
+    {  8,  8,  8,  8,   0, 0, 0, 1, WCORE_CONFIG_CAVEAT_SLOW, WCORE_CONFIG_API_OPENGL },
+    // id 5: RGB10A2, ES2 only
+    { 10, 10, 10,  2,   0, 0, 0, 1, WCORE_CONFIG_CAVEAT_NONE, WCORE_CONFIG_API_OPENGL_ES2 },
+};
+
+#define NUM_ROWS ((int32_t) (sizeof(rows) / sizeof(rows[0])))
+
+static int
+setup(void **state) {
+    struct wcore_config_table *table;
+
+    table = wcore_config_table_create(NUM_ROWS);
+    if (!table)
+        return -1;
+
+    for (int32_t i = 0; i < NUM_ROWS; ++i) {
+        int32_t n = table->count++;
+
+        table->red_size[n] = rows[i].red;
+        table->green_size[n] = rows[i].green;
+        table->blue_size[n] = rows[i].blue;
+        table->alpha_size[n] = rows[i].alpha;
+        table->buffer_size[n] = rows[i].red + rows[i].green +
+                                rows[i].blue + rows[i].alpha;
+        table->depth_size[n] = rows[i].depth;
+        table->stencil_size[n] = rows[i].stencil;
+        table->sample_buffers[n] = rows[i].samples > 0;
+        table->samples[n] = rows[i].samples;
+        table->double_buffered[n] = rows[i].double_buffered;
+        table->accum_size[n] = 0;
+        table->caveat[n] = rows[i].caveat;
+        table->apis[n] = rows[i].apis;
+        table->visual[n] = 0;
+        table->id[n] = i;
+        table->native[n] = NULL;
+    }
+
+    *state = table;
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    wcore_config_table_destroy(*state);
+    return 0;
+}
+
+static void
+parse(struct wcore_config_attrs *attrs, const int32_t attrib_list[]) {
+    wcore_error_reset();
+    assert_true(wcore_config_attrs_parse(attrib_list, attrs));
+}
+
+static void
+test_wcore_config_table_match_api(void **state) {
+    const struct wcore_config_table *table = *state;
+    struct wcore_config_attrs attrs;
+    int32_t indices[NUM_ROWS];
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL_ES2,
+        0,
+    };
+
+    parse(&attrs, attrib_list);
+    assert_int_equal(wcore_config_table_match(table, &attrs, indices), 1);
+    assert_int_equal(indices[0], 5);
+}
+
+static void
+test_wcore_config_table_match_none(void **state) {
+    const struct wcore_config_table *table = *state;
+    struct wcore_config_attrs attrs;
+    int32_t indices[NUM_ROWS];
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_SAMPLES, 8,
+        0,
+    };
+
+    parse(&attrs, attrib_list);
+    assert_int_equal(wcore_config_table_match(table, &attrs, indices), 0);
+}
+
+static void
+test_wcore_config_table_match_at_least(void **state) {
+    const struct wcore_config_table *table = *state;
+    struct wcore_config_attrs attrs;
+    int32_t indices[NUM_ROWS];
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_DEPTH_SIZE, 16,
+        0,
+    };
+
+    parse(&attrs, attrib_list);
+    assert_int_equal(wcore_config_table_match(table, &attrs, indices), 3);
+
+    // EGL and GLX sort smaller buffers, then fewer samples, first.
+    assert_int_equal(indices[0], 2);
+    assert_int_equal(indices[1], 1);
+    assert_int_equal(indices[2], 3);
+}
+
+static void
+test_wcore_config_table_sort_native(void **state) {
+    const struct wcore_config_table *table = *state;
+    struct wcore_config_attrs attrs;
+    int32_t indices[NUM_ROWS];
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_RED_SIZE, 1,
+        0,
+    };
+
+    parse(&attrs, attrib_list);
+    assert_int_equal(wcore_config_table_match(table, &attrs, indices), 5);
+
+    // Deeper red first, then smaller depth, and slow configs last.
+    assert_int_equal(indices[0], 0);
+    assert_int_equal(indices[1], 1);
+    assert_int_equal(indices[2], 3);
+    assert_int_equal(indices[3], 2);
+    assert_int_equal(indices[4], 4);
+}
+
+static void
+test_wcore_config_table_sort_native_larger_depth(void **state) {
+    struct wcore_config_table *table = *state;
+    struct wcore_config_attrs attrs;
+    int32_t indices[NUM_ROWS];
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL,
+        0,
+    };
+
+    table->prefer_larger_depth = true;
+    parse(&attrs, attrib_list);
+    assert_int_equal(wcore_config_table_match(table, &attrs, indices), 5);
+    assert_int_equal(indices[0], 2);
+    assert_int_equal(indices[1], 1);
+    assert_int_equal(indices[2], 0);
+}
+
+static void
+test_wcore_config_table_sort_smallest(void **state) {
+    const struct wcore_config_table *table = *state;
+    struct wcore_config_attrs attrs;
+    int32_t indices[NUM_ROWS];
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONFIG_SORT, WAFFLE_CONFIG_SORT_SMALLEST,
+        0,
+    };
+
+    parse(&attrs, attrib_list);
+    assert_int_equal(wcore_config_table_match(table, &attrs, indices), 5);
+
+    // 16*2+16 bits, 32*2, 32*2+32, (32*2+32)*4, then the slow config.
+    assert_int_equal(indices[0], 2);
+    assert_int_equal(indices[1], 0);
+    assert_int_equal(indices[2], 1);
+    assert_int_equal(indices[3], 3);
+    assert_int_equal(indices[4], 4);
+}
+
+static void
+test_wcore_config_table_sort_bad_value(void **state) {
+    struct wcore_config_attrs attrs;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONFIG_SORT, WAFFLE_DONT_CARE,
+        0,
+    };
+
+    (void) state;
+
+    wcore_error_reset();
+    assert_false(wcore_config_attrs_parse(attrib_list, &attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+int
+main(void) {
+    const struct CMUnitTest tests[] = {
+        #define unit_test_make(name) cmocka_unit_test_setup_teardown(name, setup, teardown)
+
+        unit_test_make(test_wcore_config_table_match_api),
+        unit_test_make(test_wcore_config_table_match_none),
+        unit_test_make(test_wcore_config_table_match_at_least),
+        unit_test_make(test_wcore_config_table_sort_native),
+        unit_test_make(test_wcore_config_table_sort_native_larger_depth),
+        unit_test_make(test_wcore_config_table_sort_smallest),
+        unit_test_make(test_wcore_config_table_sort_bad_value),
+
+        #undef unit_test_make
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -32,6 +32,7 @@
 #include "api_object.h"
 
 #include "wcore_config.h"
+#include "wcore_ext_set.h"
 #include "wcore_util.h"
 
 struct wcore_context;
@@ -42,6 +43,38 @@ struct wcore_context {
     struct api_object api;
     enum waffle_enum context_api; // WAFFLE_CONTEXT_*
     struct wcore_display *display;
+
+    /// @brief Filled on the first call to waffle_context_get_gl_dispatch().
+    struct waffle_gl_dispatch *gl_dispatch;
+
+    /// @brief Filled on the first call to waffle_context_peek_native().
+    union waffle_native_context *native;
+
+    /// @brief True once gl_version and gl_extensions are filled.
+    ///
+    /// They are filled on the first call to
+    /// waffle_context_get_gl_version() or waffle_context_has_gl_extension().
+    bool gl_info_valid;
+    int32_t gl_major_version;
+    int32_t gl_minor_version;
+    struct wcore_ext_set gl_extensions;
+
+    /// @brief Asynchronous operations that create a context sharing with
+    /// this one and are not yet finished. Destroying the context fails while
+    /// it is nonzero.
+    long async_op_count;
+
+    /// @brief Context pool entries keyed on this context as their shared
+    /// context. Destroying the context fails while it is nonzero.
+    long pool_count;
+
+    /// @brief Number of threads whose waffle_make_current() bound the
+    /// context, 0 or 1.
+    long current_count;
+
+    /// @brief The pool that created the context and still has an entry for
+    /// it, or null.
+    struct waffle_context_pool *pool;
 };
 
 static inline struct waffle_context*
@@ -62,8 +95,16 @@ wcore_context_init(struct wcore_context *self,
     assert(config);
 
     self->api.display_id = config->display->api.display_id;
+    self->api.platform = config->api.platform;
     self->context_api = config->attrs.context_api;
     self->display = config->display;
+    self->gl_dispatch = NULL;
+    self->native = NULL;
+    self->gl_info_valid = false;
+    self->async_op_count = 0;
+    self->pool_count = 0;
+    self->current_count = 0;
+    self->pool = NULL;
 
     return true;
 }
@@ -71,7 +112,9 @@ wcore_context_init(struct wcore_context *self,
 static inline bool
 wcore_context_teardown(struct wcore_context *self)
 {
-    (void) self;
     assert(self);
+    free(self->gl_dispatch);
+    if (self->gl_info_valid)
+        wcore_ext_set_teardown(&self->gl_extensions);
     return true;
 }
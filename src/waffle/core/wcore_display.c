@@ -27,6 +27,7 @@
 #include <stdio.h>
 
 #include "wcore_display.h"
+#include "wcore_error.h"
 
 static mtx_t mutex;
 
@@ -46,12 +47,29 @@ wcore_display_init(struct wcore_display *self,
     assert(self);
     assert(platform);
 
+    if (mtx_init(&self->config_table_mutex, mtx_plain) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        return false;
+    }
+
+    if (mtx_init(&self->capabilities_mutex, mtx_plain) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        mtx_destroy(&self->config_table_mutex);
+        return false;
+    }
+
     call_once(&flag, wcore_display_init_once);
     mtx_lock(&mutex);
     self->api.display_id = ++id_counter;
     mtx_unlock(&mutex);
 
+    self->api.platform = platform;
     self->platform = platform;
+    self->native = NULL;
+    self->capabilities = NULL;
+    self->config_table = NULL;
+    self->async_op_count = 0;
+    self->pool_count = 0;
 
     if (self->api.display_id == 0) {
         fprintf(stderr, "waffle: error: internal counter wrapped to 0\n");
@@ -60,3 +78,21 @@ wcore_display_init(struct wcore_display *self,
 
     return true;
 }
+
+const struct wcore_config_table*
+wcore_display_get_config_table(struct wcore_display *self,
+                               wcore_config_table_create_func create)
+{
+    struct wcore_config_table *table;
+
+    assert(self);
+    assert(create);
+
+    mtx_lock(&self->config_table_mutex);
+    if (!self->config_table)
+        self->config_table = create(self);
+    table = self->config_table;
+    mtx_unlock(&self->config_table_mutex);
+
+    return table;
+}
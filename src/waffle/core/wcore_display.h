@@ -31,6 +31,7 @@
 
 #include "api_object.h"
 
+#include "wcore_config_table.h"
 #include "wcore_util.h"
 
 #ifdef __cplusplus
@@ -39,11 +40,38 @@ extern "C" {
 
 struct wcore_display;
 struct wcore_platform;
+struct waffle_display_capabilities;
 union waffle_native_display;
 
 struct wcore_display {
     struct api_object api;
     struct wcore_platform *platform;
+
+    /// @brief Filled on the first call to waffle_display_peek_native().
+    union waffle_native_display *native;
+
+    /// @brief Filled on the first call to waffle_display_get_capabilities().
+    struct waffle_display_capabilities *capabilities;
+
+    /// @brief Serializes filling capabilities, which creates a context per
+    /// client API.
+    mtx_t capabilities_mutex;
+
+    /// @brief Filled on the first call to wcore_display_get_config_table().
+    /// Freed by waffle_display_disconnect().
+    struct wcore_config_table *config_table;
+
+    /// @brief Serializes filling config_table, which queries every native
+    /// config, without blocking other displays.
+    mtx_t config_table_mutex;
+
+    /// @brief Asynchronous operations started on the object and not yet
+    /// finished. Destroying the object fails while it is nonzero.
+    long async_op_count;
+
+    /// @brief Context pools created on the display. Destroying the object
+    /// fails while it is nonzero.
+    long pool_count;
 };
 
 static inline struct waffle_display*
@@ -60,12 +88,25 @@ bool
 wcore_display_init(struct wcore_display *self,
                    struct wcore_platform *platform);
 
+/// @brief Return the display's config table, creating it on first use.
+///
+/// The table lives until the display is destroyed. Return NULL if
+/// @a create fails.
+const struct wcore_config_table*
+wcore_display_get_config_table(struct wcore_display *self,
+                               wcore_config_table_create_func create);
 
 static inline bool
 wcore_display_teardown(struct wcore_display *self)
 {
-    (void) self;
     assert(self);
+
+    // Zero if wcore_display_init() failed or never ran.
+    if (self->api.display_id != 0) {
+        mtx_destroy(&self->config_table_mutex);
+        mtx_destroy(&self->capabilities_mutex);
+    }
+
     return true;
 }
 
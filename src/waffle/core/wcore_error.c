@@ -27,6 +27,7 @@
 #include <inttypes.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -37,101 +38,601 @@
 
 enum {
     WCORE_ERROR_MESSAGE_BUFSIZE = 1024,
+
+    /// Maximum number of arguments, including `*` widths and precisions,
+    /// that an error record captures.
+    WCORE_ERROR_MAX_ARGS = 8,
+
+    /// Size of the buffer that holds the string arguments of an error
+    /// record.
+    WCORE_ERROR_TEXT_BUFSIZE = 512,
+
+    /// Number of recent errors kept per thread.
+    WCORE_ERROR_HISTORY_SIZE = 8,
+};
+
+enum wcore_error_arg_type {
+    WCORE_ERROR_ARG_INT,
+    WCORE_ERROR_ARG_UINT,
+    WCORE_ERROR_ARG_LONG,
+    WCORE_ERROR_ARG_ULONG,
+    WCORE_ERROR_ARG_LLONG,
+    WCORE_ERROR_ARG_ULLONG,
+    WCORE_ERROR_ARG_INTMAX,
+    WCORE_ERROR_ARG_UINTMAX,
+    WCORE_ERROR_ARG_SIZE,
+    WCORE_ERROR_ARG_PTRDIFF,
+    WCORE_ERROR_ARG_DOUBLE,
+    WCORE_ERROR_ARG_LDOUBLE,
+    WCORE_ERROR_ARG_STRING,
+    WCORE_ERROR_ARG_POINTER,
 };
 
-struct wcore_error_tinfo {
-    bool is_enabled;
+union wcore_error_arg {
+    int i;
+    unsigned u;
+    long l;
+    unsigned long ul;
+    long long ll;
+    unsigned long long ull;
+    intmax_t im;
+    uintmax_t uim;
+    size_t z;
+    ptrdiff_t t;
+    double d;
+    long double ld;
+    const void *p;
+
+    /// Offset of a string argument in wcore_error_record::text, or -1 if
+    /// the argument was null.
+    ptrdiff_t s;
+};
+
+/// @brief An error, captured cheaply when it is emitted.
+///
+/// The message is formatted only when someone asks for it. String arguments
+/// are copied into @a text, because they often point to transient buffers,
+/// such as the result of dlerror().
+struct wcore_error_record {
     enum waffle_error code;
+
+    /// Null if the error has no message. Format strings are string literals,
+    /// so the pointer remains valid.
+    const char *format;
+
+    /// If true, then @a format could not be captured and @a text holds the
+    /// message formatted when the error was emitted.
+    bool is_formatted;
+
+    /// Nonzero for wcore_error_errno().
+    int errnum;
+
+    /// Non-null for wcore_error_internal().
+    const char *file;
+    int line;
+
+    int num_args;
+    union wcore_error_arg args[WCORE_ERROR_MAX_ARGS];
+
+    size_t text_len;
+    char text[WCORE_ERROR_TEXT_BUFSIZE];
+};
+
+struct wcore_error_log {
+    /// The error reported by wcore_error_get_info(). Valid if the
+    /// thread's error code is not WAFFLE_NO_ERROR.
+    struct wcore_error_record current;
+
+    /// True if @a message holds the formatted message of @a current.
+    bool message_is_formatted;
     char message[WCORE_ERROR_MESSAGE_BUFSIZE];
 
-    /// @brief The user-visible portion of the error state.
-    struct waffle_error_info user_info;
+    /// Ring of the most recent errors, including those that did not become
+    /// the current error because an earlier one was pending.
+    struct wcore_error_record history[WCORE_ERROR_HISTORY_SIZE];
+
+    /// Number of errors ever added to @a history.
+    uint64_t history_total;
+
+    char history_message[WCORE_ERROR_MESSAGE_BUFSIZE];
+    struct waffle_error_info history_info;
+};
+
+/// A parsed printf conversion specification.
+struct wcore_error_spec {
+    /// Points one past the conversion specifier.
+    const char *end;
+
+    bool width_is_star;
+    bool precision_is_star;
+
+    /// Value of an explicit precision, or -1.
+    int precision;
+
+    enum wcore_error_arg_type type;
 };
 
-struct wcore_error_tinfo*
-wcore_error_tinfo_create(void)
+/// Parse the conversion specification that begins at @a f, which points to
+/// a '%'. Return false if the specification is one that error records do
+/// not support, such as %n or wide characters.
+static bool
+wcore_error_parse_spec(const char *f, struct wcore_error_spec *spec)
 {
-    struct wcore_error_tinfo *self = malloc(sizeof(*self));
-    if (!self)
-        return NULL;
+    enum { LEN_NONE, LEN_HH, LEN_H, LEN_L, LEN_LL, LEN_J, LEN_Z, LEN_T,
+           LEN_LD } len = LEN_NONE;
 
-    self->is_enabled = true;
-    self->code = WAFFLE_NO_ERROR;
-    self->message[0] = 0;
+    spec->width_is_star = false;
+    spec->precision_is_star = false;
+    spec->precision = -1;
+
+    ++f;
 
-    return self;
+    while (*f && strchr("-+ #0", *f))
+        ++f;
+
+    if (*f == '*') {
+        spec->width_is_star = true;
+        ++f;
+    } else {
+        while (*f >= '0' && *f <= '9')
+            ++f;
+    }
+
+    if (*f == '.') {
+        ++f;
+        if (*f == '*') {
+            spec->precision_is_star = true;
+            ++f;
+        } else {
+            spec->precision = 0;
+            while (*f >= '0' && *f <= '9')
+                spec->precision = 10 * spec->precision + (*f++ - '0');
+        }
+    }
+
+    switch (*f) {
+        case 'h':
+            len = (f[1] == 'h') ? LEN_HH : LEN_H;
+            f += (len == LEN_HH) ? 2 : 1;
+            break;
+        case 'l':
+            len = (f[1] == 'l') ? LEN_LL : LEN_L;
+            f += (len == LEN_LL) ? 2 : 1;
+            break;
+        case 'j': len = LEN_J;  ++f; break;
+        case 'z': len = LEN_Z;  ++f; break;
+        case 't': len = LEN_T;  ++f; break;
+        case 'L': len = LEN_LD; ++f; break;
+        default:
+            break;
+    }
+
+    switch (*f) {
+        case 'd':
+        case 'i':
+            switch (len) {
+                case LEN_NONE:
+                case LEN_HH:
+                case LEN_H:  spec->type = WCORE_ERROR_ARG_INT;     break;
+                case LEN_L:  spec->type = WCORE_ERROR_ARG_LONG;    break;
+                case LEN_LL: spec->type = WCORE_ERROR_ARG_LLONG;   break;
+                case LEN_J:  spec->type = WCORE_ERROR_ARG_INTMAX;  break;
+                case LEN_Z:  spec->type = WCORE_ERROR_ARG_SIZE;    break;
+                case LEN_T:  spec->type = WCORE_ERROR_ARG_PTRDIFF; break;
+                default:     return false;
+            }
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            switch (len) {
+                case LEN_NONE:
+                case LEN_HH:
+                case LEN_H:  spec->type = WCORE_ERROR_ARG_UINT;    break;
+                case LEN_L:  spec->type = WCORE_ERROR_ARG_ULONG;   break;
+                case LEN_LL: spec->type = WCORE_ERROR_ARG_ULLONG;  break;
+                case LEN_J:  spec->type = WCORE_ERROR_ARG_UINTMAX; break;
+                case LEN_Z:  spec->type = WCORE_ERROR_ARG_SIZE;    break;
+                case LEN_T:  spec->type = WCORE_ERROR_ARG_PTRDIFF; break;
+                default:     return false;
+            }
+            break;
+        case 'c':
+            if (len != LEN_NONE)
+                return false;
+            spec->type = WCORE_ERROR_ARG_INT;
+            break;
+        case 'a': case 'A':
+        case 'e': case 'E':
+        case 'f': case 'F':
+        case 'g': case 'G':
+            if (len == LEN_LD)
+                spec->type = WCORE_ERROR_ARG_LDOUBLE;
+            else if (len == LEN_NONE || len == LEN_L)
+                spec->type = WCORE_ERROR_ARG_DOUBLE;
+            else
+                return false;
+            break;
+        case 's':
+            if (len != LEN_NONE)
+                return false;
+            spec->type = WCORE_ERROR_ARG_STRING;
+            break;
+        case 'p':
+            if (len != LEN_NONE)
+                return false;
+            spec->type = WCORE_ERROR_ARG_POINTER;
+            break;
+        default:
+            return false;
+    }
+
+    spec->end = f + 1;
+    return true;
 }
 
-bool
-wcore_error_tinfo_destroy(struct wcore_error_tinfo *self)
+/// Capture @a format and its arguments into @a r without formatting.
+/// Return false if they cannot be captured.
+static bool
+wcore_error_record_capture(struct wcore_error_record *r,
+                           const char *format, va_list ap)
 {
-    free(self);
+    for (const char *f = format; *f; ) {
+        struct wcore_error_spec spec;
+        union wcore_error_arg *arg;
+        int precision;
+
+        if (*f != '%') {
+            ++f;
+            continue;
+        }
+
+        if (f[1] == '%') {
+            f += 2;
+            continue;
+        }
+
+        if (!wcore_error_parse_spec(f, &spec))
+            return false;
+
+        if (r->num_args + spec.width_is_star + spec.precision_is_star + 1 >
+            WCORE_ERROR_MAX_ARGS)
+            return false;
+
+        if (spec.width_is_star)
+            r->args[r->num_args++].i = va_arg(ap, int);
+
+        precision = spec.precision;
+        if (spec.precision_is_star) {
+            precision = va_arg(ap, int);
+            r->args[r->num_args++].i = precision;
+        }
+
+        arg = &r->args[r->num_args++];
+
+        switch (spec.type) {
+            case WCORE_ERROR_ARG_INT:     arg->i = va_arg(ap, int); break;
+            case WCORE_ERROR_ARG_UINT:    arg->u = va_arg(ap, unsigned); break;
+            case WCORE_ERROR_ARG_LONG:    arg->l = va_arg(ap, long); break;
+            case WCORE_ERROR_ARG_ULONG:   arg->ul = va_arg(ap, unsigned long); break;
+            case WCORE_ERROR_ARG_LLONG:   arg->ll = va_arg(ap, long long); break;
+            case WCORE_ERROR_ARG_ULLONG:  arg->ull = va_arg(ap, unsigned long long); break;
+            case WCORE_ERROR_ARG_INTMAX:  arg->im = va_arg(ap, intmax_t); break;
+            case WCORE_ERROR_ARG_UINTMAX: arg->uim = va_arg(ap, uintmax_t); break;
+            case WCORE_ERROR_ARG_SIZE:    arg->z = va_arg(ap, size_t); break;
+            case WCORE_ERROR_ARG_PTRDIFF: arg->t = va_arg(ap, ptrdiff_t); break;
+            case WCORE_ERROR_ARG_DOUBLE:  arg->d = va_arg(ap, double); break;
+            case WCORE_ERROR_ARG_LDOUBLE: arg->ld = va_arg(ap, long double); break;
+            case WCORE_ERROR_ARG_POINTER: arg->p = va_arg(ap, void*); break;
+            case WCORE_ERROR_ARG_STRING: {
+                const char *s = va_arg(ap, const char*);
+                size_t len;
+
+                if (!s) {
+                    arg->s = -1;
+                    break;
+                }
+
+                // Honor the precision, because the string need not be
+                // null-terminated.
+                len = 0;
+                while (s[len] && (precision < 0 || len < (size_t) precision))
+                    ++len;
+
+                if (r->text_len + len + 1 > WCORE_ERROR_TEXT_BUFSIZE)
+                    return false;
+
+                arg->s = r->text_len;
+                memcpy(r->text + r->text_len, s, len);
+                r->text_len += len;
+                r->text[r->text_len++] = '\0';
+                break;
+            }
+        }
+
+        f = spec.end;
+    }
+
     return true;
 }
 
-void
-_wcore_error_enable(void)
+/// A bounded string builder. Output is silently truncated.
+struct wcore_error_buf {
+    char *data;
+    size_t size;
+    size_t len;
+};
+
+static void WCORE_PRINTFLIKE(2, 3)
+wcore_error_buf_printf(struct wcore_error_buf *b, const char *format, ...)
+{
+    va_list ap;
+    int printed;
+
+    if (b->len + 1 >= b->size)
+        return;
+
+    va_start(ap, format);
+    printed = vsnprintf(b->data + b->len, b->size - b->len, format, ap);
+    va_end(ap);
+
+    if (printed < 0)
+        return;
+
+    b->len += printed;
+    if (b->len >= b->size)
+        b->len = b->size - 1;
+}
+
+/// Replay the captured format and arguments of @a r into @a b.
+static void
+wcore_error_record_format_args(const struct wcore_error_record *r,
+                               struct wcore_error_buf *b)
+{
+    const union wcore_error_arg *arg = r->args;
+    const char *f = r->format;
+
+    while (*f) {
+        struct wcore_error_spec spec;
+        char one[64];
+        size_t n = 0;
+
+        if (*f != '%') {
+            const char *next = strchr(f, '%');
+            int len = next ? (int) (next - f) : (int) strlen(f);
+
+            wcore_error_buf_printf(b, "%.*s", len, f);
+            f += len;
+            continue;
+        }
+
+        if (f[1] == '%') {
+            wcore_error_buf_printf(b, "%%");
+            f += 2;
+            continue;
+        }
+
+        // Capture succeeded, so parsing succeeds.
+        wcore_error_parse_spec(f, &spec);
+
+        // Rebuild the specification with each '*' replaced by its value.
+        for (const char *c = f; c < spec.end && n + 16 < sizeof(one); ++c) {
+            if (*c == '*')
+                n += snprintf(one + n, sizeof(one) - n, "%d", (arg++)->i);
+            else
+                one[n++] = *c;
+        }
+        one[n] = '\0';
+
+        switch (spec.type) {
+            case WCORE_ERROR_ARG_INT:     wcore_error_buf_printf(b, one, arg->i); break;
+            case WCORE_ERROR_ARG_UINT:    wcore_error_buf_printf(b, one, arg->u); break;
+            case WCORE_ERROR_ARG_LONG:    wcore_error_buf_printf(b, one, arg->l); break;
+            case WCORE_ERROR_ARG_ULONG:   wcore_error_buf_printf(b, one, arg->ul); break;
+            case WCORE_ERROR_ARG_LLONG:   wcore_error_buf_printf(b, one, arg->ll); break;
+            case WCORE_ERROR_ARG_ULLONG:  wcore_error_buf_printf(b, one, arg->ull); break;
+            case WCORE_ERROR_ARG_INTMAX:  wcore_error_buf_printf(b, one, arg->im); break;
+            case WCORE_ERROR_ARG_UINTMAX: wcore_error_buf_printf(b, one, arg->uim); break;
+            case WCORE_ERROR_ARG_SIZE:    wcore_error_buf_printf(b, one, arg->z); break;
+            case WCORE_ERROR_ARG_PTRDIFF: wcore_error_buf_printf(b, one, arg->t); break;
+            case WCORE_ERROR_ARG_DOUBLE:  wcore_error_buf_printf(b, one, arg->d); break;
+            case WCORE_ERROR_ARG_LDOUBLE: wcore_error_buf_printf(b, one, arg->ld); break;
+            case WCORE_ERROR_ARG_POINTER: wcore_error_buf_printf(b, one, arg->p); break;
+            case WCORE_ERROR_ARG_STRING:
+                wcore_error_buf_printf(b, one,
+                                       arg->s < 0 ? "(null)" : r->text + arg->s);
+                break;
+        }
+
+        ++arg;
+        f = spec.end;
+    }
+}
+
+static void
+wcore_error_record_format(const struct wcore_error_record *r,
+                          char *message, size_t size)
 {
-    wcore_tinfo_get()->error->is_enabled = true;
+    struct wcore_error_buf b = {
+        .data = message,
+        .size = size,
+        .len = 0,
+    };
+
+    message[0] = '\0';
+
+    if (r->file) {
+        wcore_error_buf_printf(&b, "waffle: internal error: %s:%d: ",
+                               r->file, r->line);
+    }
+
+    if (r->is_formatted)
+        wcore_error_buf_printf(&b, "%s", r->text);
+    else if (r->format)
+        wcore_error_record_format_args(r, &b);
+
+    if (r->errnum) {
+        if (r->format)
+            wcore_error_buf_printf(&b, ": ");
+
+        if (b.len + 1 < b.size)
+            strerror_r(r->errnum, b.data + b.len, b.size - b.len);
+    }
+
+    if (r->file) {
+        size_t len = strlen(b.data);
+
+        b.len = len;
+        wcore_error_buf_printf(&b, " ; Please report bug at https://gitlab.freedesktop.org/mesa/waffle/issues");
+    }
+}
+
+static struct wcore_error_log*
+wcore_error_get_log(struct wcore_error_tinfo *t)
+{
+    // Failure to allocate is not fatal. The error code is still emitted,
+    // but without a message.
+    if (!t->log)
+        t->log = calloc(1, sizeof(*t->log));
+
+    return t->log;
+}
+
+/// Start a record in the history ring and return it, or return null if the
+/// log cannot be allocated.
+static struct wcore_error_record*
+wcore_error_record_begin(struct wcore_error_tinfo *t, enum waffle_error code)
+{
+    struct wcore_error_log *log = wcore_error_get_log(t);
+    struct wcore_error_record *r;
+
+    if (!log)
+        return NULL;
+
+    r = &log->history[log->history_total++ % WCORE_ERROR_HISTORY_SIZE];
+    r->code = code;
+    r->format = NULL;
+    r->is_formatted = false;
+    r->errnum = 0;
+    r->file = NULL;
+    r->line = 0;
+    r->num_args = 0;
+    r->text_len = 0;
+    return r;
+}
+
+/// Capture the message of @a r. If the format cannot be captured, fall back
+/// to formatting it now.
+static void
+wcore_error_record_set_message(struct wcore_error_record *r,
+                               const char *format, va_list ap)
+{
+    va_list ap_copy;
+
+    if (!format)
+        return;
+
+    va_copy(ap_copy, ap);
+
+    if (!wcore_error_record_capture(r, format, ap_copy)) {
+        vsnprintf(r->text, WCORE_ERROR_TEXT_BUFSIZE, format, ap);
+        r->is_formatted = true;
+        r->num_args = 0;
+    }
+
+    va_end(ap_copy);
+    r->format = format;
+}
+
+/// Make @a r the thread's current error.
+static void
+wcore_error_record_commit(struct wcore_error_tinfo *t,
+                          enum waffle_error code,
+                          const struct wcore_error_record *r)
+{
+    t->code = code;
+
+    if (!r)
+        return;
+
+    t->log->current = *r;
+    t->log->message_is_formatted = false;
 }
 
 void
-_wcore_error_disable(void)
+wcore_error_tinfo_init(struct wcore_error_tinfo *self)
 {
-    wcore_tinfo_get()->error->is_enabled = false;
+    self->is_enabled = true;
+    self->code = WAFFLE_NO_ERROR;
+    self->log = NULL;
 }
 
 void
-wcore_error_reset(void)
+wcore_error_tinfo_teardown(struct wcore_error_tinfo *self)
 {
-    struct wcore_error_tinfo *t = wcore_tinfo_get()->error;
+    free(self->log);
+    self->log = NULL;
+}
 
-    if (!t->is_enabled)
-        return;
+void
+_wcore_error_enable(void)
+{
+    wcore_tinfo_get()->error.is_enabled = true;
+}
 
-    t->code = WAFFLE_NO_ERROR;
-    t->message[0] = '\0';
+void
+_wcore_error_disable(void)
+{
+    wcore_tinfo_get()->error.is_enabled = false;
 }
 
 void
 wcore_error(enum waffle_error error)
 {
-    struct wcore_error_tinfo *t = wcore_tinfo_get()->error;
+    struct wcore_error_tinfo *t = &wcore_tinfo_get()->error;
+    struct wcore_error_record *r;
 
     if (!t->is_enabled)
         return;
 
+    r = wcore_error_record_begin(t, error);
+
     if (t->code != WAFFLE_NO_ERROR) {
         // Waffle is incapable of emitting a sequence of errors. The first
         // error emitted will likely be the most significant one the
-        // sequence, so don't clobber it.
+        // sequence, so don't clobber it. The history keeps the others.
         return;
     }
 
-    t->code = error;
-    t->message[0] = '\0';
+    wcore_error_record_commit(t, error, r);
 }
 
 void
 wcore_errorf(enum waffle_error error, const char *format, ...)
 {
-    struct wcore_error_tinfo *t = wcore_tinfo_get()->error;
+    struct wcore_error_tinfo *t = &wcore_tinfo_get()->error;
+    struct wcore_error_record *r;
     va_list ap;
 
     if (!t->is_enabled)
         return;
 
+    r = wcore_error_record_begin(t, error);
+    if (r) {
+        va_start(ap, format);
+        wcore_error_record_set_message(r, format, ap);
+        va_end(ap);
+    }
+
     if (t->code != WAFFLE_NO_ERROR) {
         // Waffle is incapable of emitting a sequence of errors. The first
         // error emitted will likely be the most significant one the
-        // sequence, so don't clobber it.
+        // sequence, so don't clobber it. The history keeps the others.
         return;
     }
 
-    t->code = error;
-    va_start(ap, format);
-    vsnprintf(t->message, WCORE_ERROR_MESSAGE_BUFSIZE - 1, format, ap);
-    va_end(ap);
+    wcore_error_record_commit(t, error, r);
 }
 
 void
@@ -139,35 +640,22 @@ wcore_error_errno(const char *format, ...)
 {
    int saved_errno = errno;
 
-   struct wcore_error_tinfo *t = wcore_tinfo_get()->error;
-   char *cur = t->message;
-   char *end = t->message + WCORE_ERROR_MESSAGE_BUFSIZE;
-   int printed;
+   struct wcore_error_tinfo *t = &wcore_tinfo_get()->error;
+   struct wcore_error_record *r;
+   va_list ap;
 
    if (!t->is_enabled)
        return;
 
-   t->code = WAFFLE_ERROR_UNKNOWN;
-
-   if (format) {
-       va_list ap;
-
+   r = wcore_error_record_begin(t, WAFFLE_ERROR_UNKNOWN);
+   if (r) {
        va_start(ap, format);
-       printed = vsnprintf(cur, end - cur, format, ap);
-       cur += printed;
+       wcore_error_record_set_message(r, format, ap);
        va_end(ap);
-
-       if (printed < 0 || cur >= end)
-           return;
-
-       printed = snprintf(cur, end - cur, ": ");
-       cur += printed;
-
-       if (printed < 0 || cur >= end)
-           return;
+       r->errnum = saved_errno;
    }
 
-   strerror_r(saved_errno, cur, end - cur);
+   wcore_error_record_commit(t, WAFFLE_ERROR_UNKNOWN, r);
 }
 
 void
@@ -180,55 +668,87 @@ wcore_error_bad_attribute(intptr_t attr)
 void
 _wcore_error_internal(const char *file, int line, const char *format, ...)
 {
-    struct wcore_error_tinfo *t = wcore_tinfo_get()->error;
-
-    char *cur = t->message;
-    char *end = t->message + WCORE_ERROR_MESSAGE_BUFSIZE;
-    int printed;
+    struct wcore_error_tinfo *t = &wcore_tinfo_get()->error;
+    struct wcore_error_record *r;
+    va_list ap;
 
     if (!t->is_enabled)
         return;
 
-    // If an error has already been emitted, then clobber it. Internal errors
-    // get priority.
-    t->code = WAFFLE_ERROR_INTERNAL;
-
-    printed = snprintf(cur, end - cur,
-                       "waffle: internal error: %s:%d: ", file, line);
-    cur += printed;
-
-    if (printed < 0  || cur >= end)
-        return;
-
-    if (format) {
-        va_list ap;
-
+    r = wcore_error_record_begin(t, WAFFLE_ERROR_INTERNAL);
+    if (r) {
         va_start(ap, format);
-        printed = vsnprintf(cur, end - cur, format, ap);
-        cur += printed;
+        wcore_error_record_set_message(r, format, ap);
         va_end(ap);
-
-        if (printed < 0 || cur >= end)
-            return;
+        r->file = file;
+        r->line = line;
     }
 
-    snprintf(cur, end - cur, " ; Please report bug at https://gitlab.freedesktop.org/mesa/waffle/issues");
+    // If an error has already been emitted, then clobber it. Internal errors
+    // get priority.
+    wcore_error_record_commit(t, WAFFLE_ERROR_INTERNAL, r);
 }
 
 enum waffle_error
 wcore_error_get_code(void)
 {
-    return wcore_tinfo_get()->error->code;
+    return wcore_tinfo_get()->error.code;
 }
 
 const struct waffle_error_info*
 wcore_error_get_info(void)
 {
-    struct wcore_error_tinfo *info = wcore_tinfo_get()->error;
+    struct wcore_error_tinfo *info = &wcore_tinfo_get()->error;
+    struct wcore_error_log *log = info->log;
 
     info->user_info.code = info->code;
-    info->user_info.message = info->message;
-    info->user_info.message_length = strlen(info->message);
+    info->user_info.message = "";
 
+    if (info->code != WAFFLE_NO_ERROR && log) {
+        if (!log->message_is_formatted) {
+            wcore_error_record_format(&log->current, log->message,
+                                      sizeof(log->message));
+            log->message_is_formatted = true;
+        }
+
+        info->user_info.message = log->message;
+    }
+
+    info->user_info.message_length = strlen(info->user_info.message);
     return &info->user_info;
 }
+
+uint32_t
+wcore_error_get_history_count(void)
+{
+    struct wcore_error_log *log = wcore_tinfo_get()->error.log;
+
+    if (!log)
+        return 0;
+
+    if (log->history_total < WCORE_ERROR_HISTORY_SIZE)
+        return log->history_total;
+
+    return WCORE_ERROR_HISTORY_SIZE;
+}
+
+const struct waffle_error_info*
+wcore_error_get_history_info(uint32_t index)
+{
+    struct wcore_error_log *log = wcore_tinfo_get()->error.log;
+    const struct wcore_error_record *r;
+
+    if (index >= wcore_error_get_history_count())
+        return NULL;
+
+    r = &log->history[(log->history_total - 1 - index) %
+                      WCORE_ERROR_HISTORY_SIZE];
+
+    wcore_error_record_format(r, log->history_message,
+                              sizeof(log->history_message));
+
+    log->history_info.code = r->code;
+    log->history_info.message = log->history_message;
+    log->history_info.message_length = strlen(log->history_message);
+    return &log->history_info;
+}
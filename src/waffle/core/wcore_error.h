@@ -28,6 +28,7 @@
 #include <stdbool.h>
 
 #include "waffle.h"
+#include "wcore_tinfo.h"
 
 #if defined(__GNUC__)
 #define WCORE_PRINTFLIKE(f, a) __attribute__((__format__(__printf__, f, a)))
@@ -39,18 +40,25 @@
 extern "C" {
 #endif
 
-/// @brief Thread-local info for the wcore_error module.
-struct wcore_error_tinfo;
-
-struct wcore_error_tinfo*
-wcore_error_tinfo_create(void);
+void
+wcore_error_tinfo_init(struct wcore_error_tinfo *self);
 
-bool
-wcore_error_tinfo_destroy(struct wcore_error_tinfo *self);
+void
+wcore_error_tinfo_teardown(struct wcore_error_tinfo *self);
 
 /// @brief Reset the error state to WAFFLE_NO_ERROR.
-void
-wcore_error_reset(void);
+///
+/// Every API entry point calls this, so it is inline.
+static inline void
+wcore_error_reset(void)
+{
+    struct wcore_error_tinfo *t = &wcore_tinfo_get()->error;
+
+    if (!t->is_enabled)
+        return;
+
+    t->code = WAFFLE_NO_ERROR;
+}
 
 /// @brief Set error code for client.
 ///
@@ -93,9 +101,22 @@ enum waffle_error
 wcore_error_get_code(void);
 
 /// @brief Get the user-visible portion of the error state.
+///
+/// The message is formatted here, not when the error is emitted.
 const struct waffle_error_info*
 wcore_error_get_info(void);
 
+/// @brief Get the number of errors in the thread's error history.
+uint32_t
+wcore_error_get_history_count(void);
+
+/// @brief Get an error from the thread's error history.
+///
+/// Index 0 is the most recent error. Return null if @a index is out of
+/// range.
+const struct waffle_error_info*
+wcore_error_get_history_info(uint32_t index);
+
 void WCORE_PRINTFLIKE(3, 4)
     _wcore_error_internal(const char *file, int line, const char *format, ...);
 
@@ -23,6 +23,7 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <errno.h>
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -122,6 +123,125 @@ test_wcore_error_disable_then_error_internal(void **state) {
     assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_NOT_INITIALIZED);
 }
 
+static void
+test_wcore_error_string_arg_is_copied(void **state) {
+    char name[] = "libGL.so.1";
+
+    wcore_error_reset();
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN, "dlopen(\"%s\") failed", name);
+
+    // The message is formatted lazily, so it must not depend on the
+    // caller's buffer.
+    strcpy(name, "clobbered");
+    assert_string_equal(wcore_error_get_info()->message,
+                        "dlopen(\"libGL.so.1\") failed");
+}
+
+static void
+test_wcore_error_format_conversions(void **state) {
+    const char *s = "abcdef";
+
+    wcore_error_reset();
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                 "%d %u %ld %lld %zu %5.2f %c %x %% %.3s %-*s| %.*s",
+                 -1, 2u, 3L, 4LL, (size_t) 5, 6.0, 'z', 0xab,
+                 s, 4, "ab", 2, s);
+    assert_string_equal(wcore_error_get_info()->message,
+                        "-1 2 3 4 5  6.00 z ab % abc ab  | ab");
+}
+
+static void
+test_wcore_error_too_many_args(void **state) {
+    wcore_error_reset();
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN, "%d %d %d %d %d %d %d %d %d %d",
+                 0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+    assert_string_equal(wcore_error_get_info()->message,
+                        "0 1 2 3 4 5 6 7 8 9");
+}
+
+static void
+test_wcore_error_errno(void **state) {
+    char expect[1024];
+
+    snprintf(expect, sizeof(expect), "open: %s", strerror(ENOENT));
+
+    wcore_error_reset();
+    errno = ENOENT;
+    wcore_error_errno("open");
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_UNKNOWN);
+    assert_string_equal(wcore_error_get_info()->message, expect);
+}
+
+static void
+test_wcore_error_history_keeps_suppressed_errors(void **state) {
+    const struct waffle_error_info *info;
+    uint32_t count;
+
+    wcore_error_reset();
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN, "first %d", 1);
+    wcore_errorf(WAFFLE_ERROR_BAD_ALLOC, "second %d", 2);
+    wcore_error(WAFFLE_ERROR_BAD_PARAMETER);
+
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_UNKNOWN);
+    assert_string_equal(wcore_error_get_info()->message, "first 1");
+
+    count = wcore_error_get_history_count();
+    assert_true(count >= 3);
+
+    info = wcore_error_get_history_info(0);
+    assert_int_equal(info->code, WAFFLE_ERROR_BAD_PARAMETER);
+    assert_string_equal(info->message, "");
+
+    info = wcore_error_get_history_info(1);
+    assert_int_equal(info->code, WAFFLE_ERROR_BAD_ALLOC);
+    assert_string_equal(info->message, "second 2");
+
+    info = wcore_error_get_history_info(2);
+    assert_int_equal(info->code, WAFFLE_ERROR_UNKNOWN);
+    assert_string_equal(info->message, "first 1");
+
+    assert_null(wcore_error_get_history_info(count));
+
+    // Resetting the error state does not clear the history.
+    wcore_error_reset();
+    assert_int_equal(wcore_error_get_history_count(), count);
+}
+
+static void
+test_wcore_error_history_is_bounded(void **state) {
+    char oldest[32];
+    uint32_t count;
+
+    for (int i = 0; i < 100; ++i) {
+        wcore_error_reset();
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "error %d", i);
+    }
+
+    count = wcore_error_get_history_count();
+    assert_true(count > 0 && count < 100);
+    assert_string_equal(wcore_error_get_history_info(0)->message, "error 99");
+
+    snprintf(oldest, sizeof(oldest), "error %d", 100 - (int) count);
+    assert_string_equal(wcore_error_get_history_info(count - 1)->message,
+                        oldest);
+}
+
+static void
+test_wcore_error_disabled_errors_are_not_in_history(void **state) {
+    uint32_t count;
+
+    wcore_error_reset();
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN, "visible");
+    count = wcore_error_get_history_count();
+
+    WCORE_ERROR_DISABLED(
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE, "hidden");
+    );
+
+    assert_int_equal(wcore_error_get_history_count(), count);
+    assert_string_equal(wcore_error_get_history_info(0)->message, "visible");
+}
+
 /// Number of threads in test wcore_error.thread_local.
 enum {
     NUM_THREADS = 3,
@@ -238,6 +358,13 @@ main(void) {
         cmocka_unit_test(test_wcore_error_disable_then_error),
         cmocka_unit_test(test_wcore_error_disable_then_errorf),
         cmocka_unit_test(test_wcore_error_disable_then_error_internal),
+        cmocka_unit_test(test_wcore_error_string_arg_is_copied),
+        cmocka_unit_test(test_wcore_error_format_conversions),
+        cmocka_unit_test(test_wcore_error_too_many_args),
+        cmocka_unit_test(test_wcore_error_errno),
+        cmocka_unit_test(test_wcore_error_history_keeps_suppressed_errors),
+        cmocka_unit_test(test_wcore_error_history_is_bounded),
+        cmocka_unit_test(test_wcore_error_disabled_errors_are_not_in_history),
         cmocka_unit_test(test_wcore_error_thread_local),
     };
 
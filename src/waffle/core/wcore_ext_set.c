@@ -0,0 +1,163 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wcore_error.h"
+#include "wcore_ext_set.h"
+#include "wcore_util.h"
+
+/// Return the slot that holds @a name, or the empty slot where it belongs.
+static struct wcore_ext_set_entry*
+wcore_ext_set_find(const struct wcore_ext_set *self,
+                   const char *name, size_t len, uint32_t hash)
+{
+    size_t mask = self->capacity - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        struct wcore_ext_set_entry *e = &self->entries[i];
+
+        if (!e->name)
+            return e;
+
+        if (e->hash == hash && e->len == len &&
+            memcmp(e->name, name, len) == 0)
+            return e;
+    }
+}
+
+bool
+wcore_ext_set_init(struct wcore_ext_set *self, const char *extension_string)
+{
+    size_t len;
+    size_t max_count = 1;
+    size_t capacity = 1;
+    size_t entries_size;
+    char *p;
+
+    assert(self);
+
+    self->names = NULL;
+    self->entries = NULL;
+    self->capacity = 0;
+    self->count = 0;
+
+    if (!extension_string || !extension_string[0])
+        return true;
+
+    // Each separator ends at most one name, so counting separators bounds
+    // the table size up front and the table never needs to grow.
+    len = strlen(extension_string);
+    for (size_t i = 0; i < len; ++i)
+        max_count += extension_string[i] == ' ';
+
+    // Keep the load factor at or below 1/2.
+    while (capacity < 2 * max_count)
+        capacity *= 2;
+
+    if (!wcore_mul_size(&entries_size, capacity, sizeof(*self->entries))) {
+        wcore_error(WAFFLE_ERROR_BAD_ALLOC);
+        goto error;
+    }
+
+    self->entries = wcore_calloc(entries_size);
+    if (!self->entries)
+        goto error;
+
+    self->names = wcore_malloc(len + 1);
+    if (!self->names)
+        goto error;
+
+    memcpy(self->names, extension_string, len + 1);
+    self->capacity = capacity;
+
+    p = self->names;
+    while (*p) {
+        struct wcore_ext_set_entry *e;
+        char *end;
+        size_t name_len;
+        uint32_t hash;
+
+        if (*p == ' ') {
+            *p++ = '\0';
+            continue;
+        }
+
+        for (end = p; *end && *end != ' '; ++end)
+            continue;
+
+        name_len = end - p;
+        hash = wcore_hash_string(p, name_len);
+
+        e = wcore_ext_set_find(self, p, name_len, hash);
+        if (!e->name) {
+            e->name = p;
+            e->len = name_len;
+            e->hash = hash;
+            self->count++;
+        }
+
+        p = end;
+    }
+
+    return true;
+
+error:
+    wcore_ext_set_teardown(self);
+    return false;
+}
+
+void
+wcore_ext_set_teardown(struct wcore_ext_set *self)
+{
+    assert(self);
+
+    free(self->entries);
+    free(self->names);
+    self->names = NULL;
+    self->entries = NULL;
+    self->capacity = 0;
+    self->count = 0;
+}
+
+bool
+wcore_ext_set_has(const struct wcore_ext_set *self, const char *name)
+{
+    size_t len;
+
+    assert(self);
+
+    if (!name || self->count == 0)
+        return false;
+
+    len = strlen(name);
+    if (len == 0)
+        return false;
+
+    return wcore_ext_set_find(self, name, len,
+                              wcore_hash_string(name, len))->name != NULL;
+}
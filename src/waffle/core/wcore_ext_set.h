@@ -0,0 +1,67 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief An immutable, hashed set of extension names.
+///
+/// A wcore_ext_set indexes a space-separated extension string, such as the
+/// result of eglQueryString(EGL_EXTENSIONS), so that repeated queries do not
+/// rescan the string.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct wcore_ext_set_entry {
+    /// @brief Points into wcore_ext_set::names. Null if the slot is empty.
+    const char *name;
+    size_t len;
+    uint32_t hash;
+};
+
+struct wcore_ext_set {
+    /// @brief Copy of the extension string, with each separator replaced
+    /// by a NUL.
+    char *names;
+
+    /// @brief Open-addressed table whose capacity is a power of two.
+    struct wcore_ext_set_entry *entries;
+    size_t capacity;
+    size_t count;
+};
+
+/// @brief Index the extensions in @a extension_string.
+///
+/// A null @a extension_string produces an empty set.
+bool
+wcore_ext_set_init(struct wcore_ext_set *self, const char *extension_string);
+
+void
+wcore_ext_set_teardown(struct wcore_ext_set *self);
+
+bool
+wcore_ext_set_has(const struct wcore_ext_set *self, const char *name);
@@ -0,0 +1,153 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "wcore_ext_set.h"
+
+static int
+setup(void **state) {
+    struct wcore_ext_set *set = calloc(1, sizeof(*set));
+    if (!set)
+        return -1;
+
+    *state = set;
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    wcore_ext_set_teardown(*state);
+    free(*state);
+    return 0;
+}
+
+static void
+test_wcore_ext_set_null_string(void **state) {
+    struct wcore_ext_set *set = *state;
+
+    assert_true(wcore_ext_set_init(set, NULL));
+    assert_int_equal(set->count, 0);
+    assert_false(wcore_ext_set_has(set, "EGL_KHR_create_context"));
+}
+
+static void
+test_wcore_ext_set_empty_string(void **state) {
+    struct wcore_ext_set *set = *state;
+
+    assert_true(wcore_ext_set_init(set, ""));
+    assert_int_equal(set->count, 0);
+    assert_false(wcore_ext_set_has(set, ""));
+}
+
+static void
+test_wcore_ext_set_has(void **state) {
+    struct wcore_ext_set *set = *state;
+
+    assert_true(wcore_ext_set_init(set,
+        "EGL_KHR_create_context EGL_KHR_image_base EGL_MESA_platform_gbm"));
+
+    assert_int_equal(set->count, 3);
+    assert_true(wcore_ext_set_has(set, "EGL_KHR_create_context"));
+    assert_true(wcore_ext_set_has(set, "EGL_KHR_image_base"));
+    assert_true(wcore_ext_set_has(set, "EGL_MESA_platform_gbm"));
+    assert_false(wcore_ext_set_has(set, "EGL_KHR_image"));
+    assert_false(wcore_ext_set_has(set, "EGL_KHR_create_context_no_error"));
+    assert_false(wcore_ext_set_has(set, ""));
+    assert_false(wcore_ext_set_has(set, NULL));
+}
+
+static void
+test_wcore_ext_set_extra_spaces(void **state) {
+    struct wcore_ext_set *set = *state;
+
+    assert_true(wcore_ext_set_init(set, "  GL_ARB_sync   GL_ARB_timer_query "));
+
+    assert_int_equal(set->count, 2);
+    assert_true(wcore_ext_set_has(set, "GL_ARB_sync"));
+    assert_true(wcore_ext_set_has(set, "GL_ARB_timer_query"));
+    assert_false(wcore_ext_set_has(set, " GL_ARB_sync"));
+}
+
+static void
+test_wcore_ext_set_duplicates(void **state) {
+    struct wcore_ext_set *set = *state;
+
+    assert_true(wcore_ext_set_init(set, "GL_ARB_sync GL_ARB_sync GL_ARB_sync"));
+
+    assert_int_equal(set->count, 1);
+    assert_true(wcore_ext_set_has(set, "GL_ARB_sync"));
+}
+
+static void
+test_wcore_ext_set_many(void **state) {
+    struct wcore_ext_set *set = *state;
+    char *str = calloc(1000, 16);
+    char name[16];
+
+    assert_non_null(str);
+
+    for (int i = 0; i < 1000; ++i) {
+        snprintf(name, sizeof(name), "GL_ext%d ", i);
+        strcat(str, name);
+    }
+
+    assert_true(wcore_ext_set_init(set, str));
+    free(str);
+
+    assert_int_equal(set->count, 1000);
+    assert_true(set->capacity >= 2000);
+
+    for (int i = 0; i < 1000; ++i) {
+        snprintf(name, sizeof(name), "GL_ext%d", i);
+        assert_true(wcore_ext_set_has(set, name));
+    }
+
+    assert_false(wcore_ext_set_has(set, "GL_ext1000"));
+}
+
+int
+main(void) {
+    const struct CMUnitTest tests[] = {
+        #define unit_test_make(name) cmocka_unit_test_setup_teardown(name, setup, teardown)
+
+        unit_test_make(test_wcore_ext_set_null_string),
+        unit_test_make(test_wcore_ext_set_empty_string),
+        unit_test_make(test_wcore_ext_set_has),
+        unit_test_make(test_wcore_ext_set_extra_spaces),
+        unit_test_make(test_wcore_ext_set_duplicates),
+        unit_test_make(test_wcore_ext_set_many),
+
+        #undef unit_test_make
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
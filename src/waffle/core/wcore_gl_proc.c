@@ -0,0 +1,113 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <assert.h>
+
+#include "wcore_error.h"
+#include "wcore_gl_proc.h"
+#include "wcore_platform.h"
+
+static int32_t
+wcore_gl_proc_get_dl(int32_t context_api)
+{
+    switch (context_api) {
+        case WAFFLE_CONTEXT_OPENGL:     return WAFFLE_DL_OPENGL;
+        case WAFFLE_CONTEXT_OPENGL_ES1: return WAFFLE_DL_OPENGL_ES1;
+        case WAFFLE_CONTEXT_OPENGL_ES2: return WAFFLE_DL_OPENGL_ES2;
+        case WAFFLE_CONTEXT_OPENGL_ES3: return WAFFLE_DL_OPENGL_ES3;
+        default:
+            assert(false);
+            return 0;
+    }
+}
+
+void
+wcore_gl_proc_loader_init(struct wcore_gl_proc_loader *self,
+                          struct wcore_platform *platform,
+                          int32_t context_api)
+{
+    self->platform = platform;
+    self->dl = wcore_gl_proc_get_dl(context_api);
+    self->can_open_dl = false;
+
+    if (!platform->defer_dl || !platform->get_proc_address_has_core) {
+        WCORE_ERROR_DISABLED({
+            self->can_open_dl = platform->vtbl->dl_can_open(platform,
+                                                            self->dl);
+        });
+    }
+}
+
+// The rules that dictate how to properly query a GL symbol are complex. As
+// of 2014-11-19:
+//   - Mali drivers on EGL 1.4 expose glGetStringi statically from
+//     libGLESv2 but not dynamically from eglGetProcAddress. The EGL 1.4 spec
+//     permits this behavior.
+//   - EGL 1.5 requires that all client API functions be exposed dynamically
+//     through eglGetProcAddress. Exposing statically with dlsym is optional.
+//   - Windows requires that post-1.1 functions be exposed dynamically from
+//     wglGetProcAddress, which requires a current context. Exposing
+//     statically from GetProcAddress (Window's dlsym equivalent) is
+//     optional.
+//   - Mesa drivers expose core functions statically from libGL and libGLESv2
+//     and dynamically from eglGetProcAddress and glXGetProcAddress.
+//   - Mac exposes functions only statically.
+//
+// Try the library before the platform's GetProcAddress because (1)
+// egl/glXGetProcAddress can return invalid non-null pointers for unsupported
+// functions and (2) dlsym returns non-null if and only if the library
+// exposes the symbol.
+//
+// With WAFFLE_DEFER_DL, on platforms whose GetProcAddress is known to return
+// core functions (EGL_KHR_client_get_all_proc_addresses), try GetProcAddress
+// first so that the library is opened only for what it does not return.
+void*
+wcore_gl_proc_loader_get(const struct wcore_gl_proc_loader *self,
+                         const char *name)
+{
+    struct wcore_platform *platform = self->platform;
+    void *proc = NULL;
+
+    if (platform->defer_dl && platform->get_proc_address_has_core) {
+        proc = platform->vtbl->get_proc_address(platform, name);
+        if (!proc) {
+            WCORE_ERROR_DISABLED({
+                proc = platform->vtbl->dl_sym(platform, self->dl, name);
+            });
+        }
+        return proc;
+    }
+
+    if (self->can_open_dl) {
+        WCORE_ERROR_DISABLED({
+            proc = platform->vtbl->dl_sym(platform, self->dl, name);
+        });
+    }
+
+    if (!proc)
+        proc = platform->vtbl->get_proc_address(platform, name);
+
+    return proc;
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct wcore_platform;
+
+/// @brief Resolves the GL functions of one client API.
+///
+/// waffle_context_get_gl_dispatch() and the platforms' internal GL calls
+/// share it, so every GL function is looked up the same way.
+struct wcore_gl_proc_loader {
+    struct wcore_platform *platform;
+    int32_t dl; // WAFFLE_DL_*
+    bool can_open_dl;
+};
+
+/// @brief Prepare to resolve functions of @a context_api, a
+/// WAFFLE_CONTEXT_* value.
+///
+/// This may open the client API's library, unless WAFFLE_DEFER_DL lets the
+/// platform's GetProcAddress return everything.
+void
+wcore_gl_proc_loader_init(struct wcore_gl_proc_loader *self,
+                          struct wcore_platform *platform,
+                          int32_t context_api);
+
+/// @brief Return the function, or null.
+void*
+wcore_gl_proc_loader_get(const struct wcore_gl_proc_loader *self,
+                         const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -36,6 +36,8 @@ struct wcore_context;
 struct wcore_display;
 struct wcore_platform;
 struct wcore_window;
+struct waffle_display_capabilities;
+struct waffle_platform;
 
 struct wcore_platform_vtbl {
     bool
@@ -53,6 +55,13 @@ struct wcore_platform_vtbl {
             struct wcore_platform *self,
             const char *proc);
 
+    /// @brief Release the calling thread's native state.
+    ///
+    /// Called by threads that waffle creates before they exit.
+    /// May be null.
+    void
+    (*release_thread)(struct wcore_platform *self);
+
     bool
     (*dl_can_open)(
             struct wcore_platform *self,
@@ -80,6 +89,15 @@ struct wcore_platform_vtbl {
         /// May be null.
         union waffle_native_display*
         (*get_native)(struct wcore_display *display);
+
+        /// @brief Fill the capabilities that need no context.
+        ///
+        /// That is, the context flags, the driver name and the device
+        /// identity. The strings must outlive the display. May be null.
+        void
+        (*get_capabilities)(
+                struct wcore_display *display,
+                struct waffle_display_capabilities *caps);
     } display;
 
     struct wcore_config_vtbl {
@@ -88,6 +106,17 @@ struct wcore_platform_vtbl {
                   struct wcore_display *display,
                   const struct wcore_config_attrs *attrs);
 
+        /// @brief Create the configs that match @a attrs, best first.
+        ///
+        /// If @a configs is null, only count the matches. May be null.
+        bool
+        (*enumerate)(struct wcore_platform *platform,
+                     struct wcore_display *display,
+                     const struct wcore_config_attrs *attrs,
+                     struct wcore_config **configs,
+                     int32_t configs_size,
+                     int32_t *num_configs);
+
         bool
         (*destroy)(struct wcore_config *config);
 
@@ -108,6 +137,13 @@ struct wcore_platform_vtbl {
         /// May be null.
         union waffle_native_context*
         (*get_native)(struct wcore_context *ctx);
+
+        /// @brief Get the WAFFLE_CONTEXT_PRIORITY_* that the driver granted.
+        ///
+        /// May be null if the platform creates only medium priority contexts.
+        bool
+        (*get_priority)(struct wcore_context *ctx,
+                        int32_t *priority);
     } context;
 
     struct wcore_window_vtbl {
@@ -140,8 +176,48 @@ struct wcore_platform_vtbl {
 struct wcore_platform {
     const struct wcore_platform_vtbl *vtbl;
     enum waffle_enum waffle_platform; // WAFFLE_PLATFORM_*
+
+    /// @brief Value of WAFFLE_SKIP_REDUNDANT_MAKE_CURRENT.
+    bool skip_redundant_make_current;
+
+    /// @brief Value of WAFFLE_SKIP_VALIDATION.
+    bool skip_validation;
+
+    /// @brief Value of WAFFLE_DEFER_DL.
+    bool defer_dl;
+
+    /// @brief Value of WAFFLE_CACHE.
+    bool cache;
+
+    /// @brief get_proc_address() also returns core functions.
+    ///
+    /// If set, the client API libraries need not be opened merely to
+    /// resolve core functions.
+    bool get_proc_address_has_core;
+
+    /// @brief Asynchronous operations started on the platform's objects and
+    /// not yet finished. Destroying the platform fails while it is nonzero.
+    long async_op_count;
+
+    /// @brief Nanoseconds spent initializing, per WAFFLE_INIT_TIME_* phase.
+    struct {
+        uint64_t dl_open;
+        uint64_t dl_sym;
+        uint64_t platform;
+        uint64_t wait;
+    } init_time;
 };
 
+static inline struct waffle_platform*
+waffle_platform(struct wcore_platform *self) {
+    return (struct waffle_platform*) self;
+}
+
+static inline struct wcore_platform*
+wcore_platform(struct waffle_platform *self) {
+    return (struct wcore_platform*) self;
+}
+
 static inline bool
 wcore_platform_init(struct wcore_platform *self)
 {
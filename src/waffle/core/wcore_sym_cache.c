@@ -0,0 +1,169 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wcore_error.h"
+#include "wcore_sym_cache.h"
+#include "wcore_util.h"
+
+enum {
+    WCORE_SYM_CACHE_MIN_CAPACITY = 256,
+};
+
+bool
+wcore_sym_cache_init(struct wcore_sym_cache *self)
+{
+    assert(self);
+
+    self->entries = NULL;
+    self->capacity = 0;
+    self->count = 0;
+    self->initialized = mtx_init(&self->mutex, mtx_plain) == thrd_success;
+    if (!self->initialized) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        return false;
+    }
+
+    return true;
+}
+
+void
+wcore_sym_cache_teardown(struct wcore_sym_cache *self)
+{
+    assert(self);
+
+    if (!self->initialized)
+        return;
+
+    for (size_t i = 0; i < self->capacity; ++i)
+        free(self->entries[i].name);
+
+    free(self->entries);
+    self->entries = NULL;
+    self->capacity = 0;
+    self->count = 0;
+    self->initialized = false;
+    mtx_destroy(&self->mutex);
+}
+
+/// Return the slot that holds @a name, or the empty slot where it belongs.
+static struct wcore_sym_cache_entry*
+wcore_sym_cache_find(struct wcore_sym_cache_entry *entries, size_t capacity,
+                     const char *name, uint32_t hash)
+{
+    size_t mask = capacity - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        struct wcore_sym_cache_entry *e = &entries[i];
+
+        if (!e->name)
+            return e;
+
+        if (e->hash == hash && strcmp(e->name, name) == 0)
+            return e;
+    }
+}
+
+static bool
+wcore_sym_cache_grow(struct wcore_sym_cache *self)
+{
+    struct wcore_sym_cache_entry *entries;
+    size_t capacity;
+
+    if (self->capacity == 0)
+        capacity = WCORE_SYM_CACHE_MIN_CAPACITY;
+    else if (!wcore_mul_size(&capacity, self->capacity, 2))
+        return false;
+
+    // Use calloc() rather than wcore_calloc() because failure to grow the
+    // cache is not an error.
+    entries = calloc(capacity, sizeof(*entries));
+    if (!entries)
+        return false;
+
+    for (size_t i = 0; i < self->capacity; ++i) {
+        struct wcore_sym_cache_entry *e = &self->entries[i];
+        if (e->name)
+            *wcore_sym_cache_find(entries, capacity, e->name, e->hash) = *e;
+    }
+
+    free(self->entries);
+    self->entries = entries;
+    self->capacity = capacity;
+    return true;
+}
+
+void*
+wcore_sym_cache_get(struct wcore_sym_cache *self, const char *name)
+{
+    uint32_t hash = wcore_hash_string(name, strlen(name));
+    void *sym = NULL;
+
+    mtx_lock(&self->mutex);
+
+    if (self->count > 0) {
+        struct wcore_sym_cache_entry *e =
+            wcore_sym_cache_find(self->entries, self->capacity, name, hash);
+        sym = e->sym;
+    }
+
+    mtx_unlock(&self->mutex);
+    return sym;
+}
+
+void
+wcore_sym_cache_put(struct wcore_sym_cache *self, const char *name, void *sym)
+{
+    uint32_t hash = wcore_hash_string(name, strlen(name));
+    struct wcore_sym_cache_entry *e;
+
+    if (!sym)
+        return;
+
+    mtx_lock(&self->mutex);
+
+    // Keep the load factor at or below 1/2.
+    if (2 * (self->count + 1) > self->capacity &&
+        !wcore_sym_cache_grow(self))
+        goto out;
+
+    e = wcore_sym_cache_find(self->entries, self->capacity, name, hash);
+    if (!e->name) {
+        e->name = strdup(name);
+        if (!e->name)
+            goto out;
+
+        e->hash = hash;
+        self->count++;
+    }
+
+    e->sym = sym;
+
+out:
+    mtx_unlock(&self->mutex);
+}
@@ -0,0 +1,75 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief A thread-safe hash table that maps symbol names to addresses.
+///
+/// Platforms use it to memoize the results of dlsym() and
+/// *GetProcAddress(). The cache is best-effort: if it fails to allocate,
+/// lookups simply miss and no error is emitted.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "threads.h"
+
+struct wcore_sym_cache_entry {
+    /// @brief Owned by the cache. Null if and only if the slot is empty.
+    char *name;
+    uint32_t hash;
+    void *sym;
+};
+
+struct wcore_sym_cache {
+    mtx_t mutex;
+
+    /// @brief Set once the mutex is initialized. A zeroed cache may be torn
+    /// down.
+    bool initialized;
+
+    /// @brief Open-addressed table whose capacity is a power of two.
+    struct wcore_sym_cache_entry *entries;
+    size_t capacity;
+    size_t count;
+};
+
+/// @brief Emit WAFFLE_ERROR_UNKNOWN and return false if the mutex fails to
+/// initialize.
+bool
+wcore_sym_cache_init(struct wcore_sym_cache *self);
+
+void
+wcore_sym_cache_teardown(struct wcore_sym_cache *self);
+
+/// @brief Return the cached address of @a name, or null on a cache miss.
+void*
+wcore_sym_cache_get(struct wcore_sym_cache *self, const char *name);
+
+/// @brief Insert @a name into the cache. Null addresses are not cached.
+void
+wcore_sym_cache_put(struct wcore_sym_cache *self, const char *name, void *sym);
@@ -0,0 +1,135 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "wcore_sym_cache.h"
+
+static int
+setup(void **state) {
+    struct wcore_sym_cache *cache = calloc(1, sizeof(*cache));
+    if (!cache)
+        return -1;
+
+    if (!wcore_sym_cache_init(cache)) {
+        free(cache);
+        return -1;
+    }
+
+    *state = cache;
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    wcore_sym_cache_teardown(*state);
+    free(*state);
+    return 0;
+}
+
+static void
+test_wcore_sym_cache_miss_on_empty(void **state) {
+    struct wcore_sym_cache *cache = *state;
+
+    assert_null(wcore_sym_cache_get(cache, "glClear"));
+}
+
+static void
+test_wcore_sym_cache_hit(void **state) {
+    struct wcore_sym_cache *cache = *state;
+    int a, b;
+
+    wcore_sym_cache_put(cache, "glClear", &a);
+    wcore_sym_cache_put(cache, "glClearColor", &b);
+
+    assert_ptr_equal(wcore_sym_cache_get(cache, "glClear"), &a);
+    assert_ptr_equal(wcore_sym_cache_get(cache, "glClearColor"), &b);
+    assert_null(wcore_sym_cache_get(cache, "glClearDepth"));
+}
+
+static void
+test_wcore_sym_cache_null_is_not_cached(void **state) {
+    struct wcore_sym_cache *cache = *state;
+
+    wcore_sym_cache_put(cache, "glClear", NULL);
+
+    assert_int_equal(cache->count, 0);
+    assert_null(wcore_sym_cache_get(cache, "glClear"));
+}
+
+static void
+test_wcore_sym_cache_put_replaces(void **state) {
+    struct wcore_sym_cache *cache = *state;
+    int a, b;
+
+    wcore_sym_cache_put(cache, "glClear", &a);
+    wcore_sym_cache_put(cache, "glClear", &b);
+
+    assert_int_equal(cache->count, 1);
+    assert_ptr_equal(wcore_sym_cache_get(cache, "glClear"), &b);
+}
+
+static void
+test_wcore_sym_cache_grow(void **state) {
+    struct wcore_sym_cache *cache = *state;
+    static char syms[2000];
+    char name[32];
+
+    for (int i = 0; i < 2000; ++i) {
+        snprintf(name, sizeof(name), "glFunc%d", i);
+        wcore_sym_cache_put(cache, name, &syms[i]);
+    }
+
+    assert_int_equal(cache->count, 2000);
+    assert_true(cache->capacity >= 4000);
+
+    for (int i = 0; i < 2000; ++i) {
+        snprintf(name, sizeof(name), "glFunc%d", i);
+        assert_ptr_equal(wcore_sym_cache_get(cache, name), &syms[i]);
+    }
+}
+
+int
+main(void) {
+    const struct CMUnitTest tests[] = {
+        #define unit_test_make(name) cmocka_unit_test_setup_teardown(name, setup, teardown)
+
+        unit_test_make(test_wcore_sym_cache_miss_on_empty),
+        unit_test_make(test_wcore_sym_cache_hit),
+        unit_test_make(test_wcore_sym_cache_null_is_not_cached),
+        unit_test_make(test_wcore_sym_cache_put_replaces),
+        unit_test_make(test_wcore_sym_cache_grow),
+
+        #undef unit_test_make
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
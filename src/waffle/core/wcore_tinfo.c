@@ -47,7 +47,7 @@ static tss_t wcore_tinfo_key;
 ///
 /// [2] Ulrich Drepper. "Elf Handling For Thread Local Storage".
 ///     http://people.redhat.com/drepper/tls.pdf
-static __thread struct wcore_tinfo wcore_tinfo
+__thread struct wcore_tinfo _wcore_tinfo
 #ifdef WAFFLE_HAS_TLS_MODEL_INITIAL_EXEC
     __attribute__((tls_model("initial-exec")))
 #endif
@@ -76,7 +76,7 @@ wcore_tinfo_key_dtor(void *args)
     if (!tinfo)
         return;
 
-    wcore_error_tinfo_destroy(tinfo->error);
+    wcore_error_tinfo_teardown(&tinfo->error);
 
 #ifndef WAFFLE_HAS_TLS
     free(tinfo);
@@ -93,21 +93,21 @@ wcore_tinfo_key_create(void)
         wcore_tinfo_abort_init();
 }
 
-static void
-wcore_tinfo_init(struct wcore_tinfo *tinfo)
+void
+_wcore_tinfo_init(struct wcore_tinfo *tinfo)
 {
     int err;
 
     if (tinfo->is_init)
         return;
 
-    tinfo->error = wcore_error_tinfo_create();
-    if (!tinfo->error)
-        wcore_tinfo_abort_init();
+    wcore_error_tinfo_init(&tinfo->error);
 
     tinfo->current_display = NULL;
     tinfo->current_window = NULL;
     tinfo->current_context = NULL;
+    tinfo->current_is_stale = false;
+    tinfo->make_current_skip_count = 0;
 
     tinfo->is_init = true;
 
@@ -128,13 +128,10 @@ wcore_tinfo_init(struct wcore_tinfo *tinfo)
         wcore_tinfo_abort_init();
 }
 
+#ifndef WAFFLE_HAS_TLS
 struct wcore_tinfo*
-wcore_tinfo_get(void)
+_wcore_tinfo_get_tss(void)
 {
-#ifdef WAFFLE_HAS_TLS
-    wcore_tinfo_init(&wcore_tinfo);
-    return &wcore_tinfo;
-#else
     struct wcore_tinfo *tinfo;
 
     // With C11 threads call_once "can never fail"...
@@ -149,7 +146,7 @@ wcore_tinfo_get(void)
     if (!tinfo)
         wcore_tinfo_abort_init();
 
-    wcore_tinfo_init(tinfo);
+    _wcore_tinfo_init(tinfo);
     return tinfo;
-#endif
 }
+#endif // WAFFLE_HAS_TLS
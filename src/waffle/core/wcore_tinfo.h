@@ -25,11 +25,33 @@
 
 #pragma once
 
-struct wcore_error_tinfo;
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "waffle.h"
+
 struct wcore_context;
 struct wcore_display;
+struct wcore_error_log;
 struct wcore_window;
 
+/// @brief Thread-local info for the wcore_error module.
+struct wcore_error_tinfo {
+    bool is_enabled;
+    enum waffle_error code;
+
+    /// @brief Records of the current and recent errors. Allocated by the
+    /// first error.
+    ///
+    /// The log is not embedded because, with the initial-exec TLS model,
+    /// all of struct wcore_tinfo must fit in the loader's small static TLS
+    /// reserve when libwaffle is dlopen'ed.
+    struct wcore_error_log *log;
+
+    /// @brief The user-visible portion of the error state.
+    struct waffle_error_info user_info;
+};
+
 /// @brief Thread-local info for all of Waffle.
 ///
 /// A note on the current display and context:
@@ -78,14 +100,55 @@ struct wcore_window;
 ///
 struct wcore_tinfo {
     /// @brief Info for @ref wcore_error.
-    struct wcore_error_tinfo *error;
+    struct wcore_error_tinfo error;
 
     struct wcore_display *current_display;
     struct wcore_window *current_window;
     struct wcore_context *current_context;
 
+    /// @brief The current_* members may not match the native binding.
+    ///
+    /// Set when an object that is current on this thread is destroyed, in
+    /// which case the native binding may still reference the object.
+    /// Cleared by the next successful waffle_make_current().
+    bool current_is_stale;
+
+    /// @brief Count of waffle_make_current() calls that were skipped because
+    /// the requested binding was already current.
+    uint64_t make_current_skip_count;
+
     bool is_init;
 };
 
+#ifdef WAFFLE_HAS_TLS
+/// @brief Thread-local storage for all of Waffle.
+///
+/// Access it only through wcore_tinfo_get().
+extern __thread struct wcore_tinfo _wcore_tinfo
+#ifdef WAFFLE_HAS_TLS_MODEL_INITIAL_EXEC
+    __attribute__((tls_model("initial-exec")))
+#endif
+    ;
+#endif
+
+void _wcore_tinfo_init(struct wcore_tinfo *tinfo);
+
+#ifndef WAFFLE_HAS_TLS
+struct wcore_tinfo* _wcore_tinfo_get_tss(void);
+#endif
+
 /// @brief Get the thread-local info for the current thread.
-struct wcore_tinfo* wcore_tinfo_get(void);
+///
+/// With WAFFLE_HAS_TLS, this is a TLS access and a test of a flag.
+static inline struct wcore_tinfo*
+wcore_tinfo_get(void)
+{
+#ifdef WAFFLE_HAS_TLS
+    if (!_wcore_tinfo.is_init)
+        _wcore_tinfo_init(&_wcore_tinfo);
+
+    return &_wcore_tinfo;
+#else
+    return _wcore_tinfo_get_tss();
+#endif
+}
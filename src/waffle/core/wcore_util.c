@@ -86,6 +86,19 @@ wcore_strdup(const char *str)
     return p;
 }
 
+uint32_t
+wcore_hash_string(const char *str, size_t len)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (uint8_t) str[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
 const char*
 wcore_enum_to_string(int32_t e)
 {
@@ -103,6 +116,17 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_PLATFORM_GBM);
         CASE(WAFFLE_PLATFORM_WGL);
         CASE(WAFFLE_PLATFORM_SURFACELESS_EGL);
+        CASE(WAFFLE_PLATFORM_AUTO);
+        CASE(WAFFLE_SKIP_REDUNDANT_MAKE_CURRENT);
+        CASE(WAFFLE_SKIP_VALIDATION);
+        CASE(WAFFLE_PLATFORM_PROBE_TIMEOUT);
+        CASE(WAFFLE_PLATFORM_ASYNC_INIT);
+        CASE(WAFFLE_DEFER_DL);
+        CASE(WAFFLE_CACHE);
+        CASE(WAFFLE_INIT_TIME_DL_OPEN);
+        CASE(WAFFLE_INIT_TIME_DL_SYM);
+        CASE(WAFFLE_INIT_TIME_PLATFORM);
+        CASE(WAFFLE_INIT_TIME_WAIT);
         CASE(WAFFLE_CONTEXT_API);
         CASE(WAFFLE_CONTEXT_OPENGL);
         CASE(WAFFLE_CONTEXT_OPENGL_ES1);
@@ -116,6 +140,16 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_CONTEXT_FORWARD_COMPATIBLE);
         CASE(WAFFLE_CONTEXT_DEBUG);
         CASE(WAFFLE_CONTEXT_ROBUST_ACCESS);
+        CASE(WAFFLE_CONTEXT_NO_ERROR);
+        CASE(WAFFLE_CONTEXT_RELEASE_BEHAVIOR);
+        CASE(WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH);
+        CASE(WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE);
+        CASE(WAFFLE_CONTEXT_PRIORITY);
+        CASE(WAFFLE_CONTEXT_PRIORITY_LOW);
+        CASE(WAFFLE_CONTEXT_PRIORITY_MEDIUM);
+        CASE(WAFFLE_CONTEXT_PRIORITY_HIGH);
+        CASE(WAFFLE_CONTEXT_PRIORITY_REALTIME);
+        CASE(WAFFLE_CONTEXT_NO_CONFIG);
         CASE(WAFFLE_RED_SIZE);
         CASE(WAFFLE_GREEN_SIZE);
         CASE(WAFFLE_BLUE_SIZE);
@@ -126,6 +160,9 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_SAMPLES);
         CASE(WAFFLE_DOUBLE_BUFFERED);
         CASE(WAFFLE_ACCUM_BUFFER);
+        CASE(WAFFLE_CONFIG_SORT);
+        CASE(WAFFLE_CONFIG_SORT_NATIVE);
+        CASE(WAFFLE_CONFIG_SORT_SMALLEST);
         CASE(WAFFLE_DL_OPENGL);
         CASE(WAFFLE_DL_OPENGL_ES1);
         CASE(WAFFLE_DL_OPENGL_ES2);
@@ -133,6 +170,10 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_WINDOW_WIDTH);
         CASE(WAFFLE_WINDOW_HEIGHT);
         CASE(WAFFLE_WINDOW_FULLSCREEN);
+        CASE(WAFFLE_WINDOW_FBO);
+        CASE(WAFFLE_WINDOW_OFFSCREEN);
+        CASE(WAFFLE_CONTEXT_GROUP_SIZE);
+        CASE(WAFFLE_CONTEXT_GROUP_SURFACELESS);
 
         default: return NULL;
 
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include "c99_compat.h"
 
@@ -98,6 +99,10 @@ wcore_realloc(void *ptr, size_t size);
 char*
 wcore_strdup(const char *str);
 
+/// @brief Hash the first @a len bytes of @a str with 32-bit FNV-1a.
+uint32_t
+wcore_hash_string(const char *str, size_t len);
+
 /// @brief Create one of `union waffle_native_*`.
 ///
 /// The example below allocates n_dpy and n_dpy->glx, then sets both
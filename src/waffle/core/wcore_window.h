@@ -34,6 +34,12 @@ union waffle_native_window;
 struct wcore_window {
     struct api_object api;
     struct wcore_display *display;
+
+    /// @brief Filled on the first call to waffle_window_peek_native().
+    ///
+    /// Dropped by waffle_window_resize(), because resizing may replace the
+    /// underlying surface.
+    union waffle_native_window *native;
 };
 
 static inline struct waffle_window*
@@ -54,7 +60,9 @@ wcore_window_init(struct wcore_window *self,
     assert(config);
 
     self->api.display_id = config->display->api.display_id;
+    self->api.platform = config->api.platform;
     self->display = config->display;
+    self->native = NULL;
 
     return true;
 }
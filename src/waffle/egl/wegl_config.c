@@ -26,7 +26,11 @@
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
 
+#include <stddef.h>
+#include <stdlib.h>
+
 #include "wcore_config_attrs.h"
+#include "wcore_config_table.h"
 #include "wcore_error.h"
 #include "wcore_platform.h"
 
@@ -36,6 +40,8 @@
 #include "wegl_platform.h"
 #include "wegl_util.h"
 
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
 /// @brief Check the WAFFLE_CONTEXT_* attributes.
 static bool
 check_context_attrs(struct wegl_display *dpy,
@@ -67,6 +73,48 @@ check_context_attrs(struct wegl_display *dpy,
         return false;
     }
 
+    if (attrs->context_no_error && !dpy->KHR_create_context_no_error) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_create_context_no_error is required in order to "
+                     "request a no error context");
+        return false;
+    }
+
+    if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE &&
+        !dpy->KHR_context_flush_control) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_context_flush_control is required in order to "
+                     "request a context that is not flushed on release");
+        return false;
+    }
+
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM &&
+        !dpy->IMG_context_priority) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_IMG_context_priority is required in order to "
+                     "request a context priority other than medium");
+        return false;
+    }
+
+    if (attrs->context_priority == WAFFLE_CONTEXT_PRIORITY_REALTIME &&
+        !dpy->NV_context_priority_realtime) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_NV_context_priority_realtime is required in order "
+                     "to request a realtime priority context");
+        return false;
+    }
+
+    // EGL_MESA_configless_context predates the KHR extension and has the
+    // same semantics for the APIs that waffle supports.
+    if (attrs->context_no_config && !dpy->KHR_no_config_context &&
+        !dpy->MESA_configless_context) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_no_config_context or "
+                     "EGL_MESA_configless_context is required in order to "
+                     "request a context without a config");
+        return false;
+    }
+
     switch (attrs->context_api) {
         case WAFFLE_CONTEXT_OPENGL:
             if (!(dpy->api_mask & WEGL_OPENGL_API)) {
@@ -119,84 +167,237 @@ check_context_attrs(struct wegl_display *dpy,
     }
 }
 
-static EGLConfig
-choose_real_config(struct wegl_display *dpy,
-                   const struct wcore_config_attrs *attrs)
+struct egl_config_attribs {
+    EGLint red_size;
+    EGLint green_size;
+    EGLint blue_size;
+    EGLint alpha_size;
+    EGLint buffer_size;
+    EGLint depth_size;
+    EGLint stencil_size;
+    EGLint sample_buffers;
+    EGLint samples;
+    EGLint caveat;
+    EGLint renderable_type;
+    EGLint surface_type;
+    EGLint color_buffer_type;
+    EGLint transparent_type;
+    EGLint level;
+    EGLint config_id;
+    EGLint native_visual_id;
+    EGLint component_type;
+};
+
+static const struct {
+    EGLint name;
+    size_t offset;
+} egl_config_attrib_list[] = {
+#define ATTRIB(name, field) { name, offsetof(struct egl_config_attribs, field) }
+    ATTRIB(EGL_RED_SIZE,            red_size),
+    ATTRIB(EGL_GREEN_SIZE,          green_size),
+    ATTRIB(EGL_BLUE_SIZE,           blue_size),
+    ATTRIB(EGL_ALPHA_SIZE,          alpha_size),
+    ATTRIB(EGL_BUFFER_SIZE,         buffer_size),
+    ATTRIB(EGL_DEPTH_SIZE,          depth_size),
+    ATTRIB(EGL_STENCIL_SIZE,        stencil_size),
+    ATTRIB(EGL_SAMPLE_BUFFERS,      sample_buffers),
+    ATTRIB(EGL_SAMPLES,             samples),
+    ATTRIB(EGL_CONFIG_CAVEAT,       caveat),
+    ATTRIB(EGL_RENDERABLE_TYPE,     renderable_type),
+    ATTRIB(EGL_SURFACE_TYPE,        surface_type),
+    ATTRIB(EGL_COLOR_BUFFER_TYPE,   color_buffer_type),
+    ATTRIB(EGL_TRANSPARENT_TYPE,    transparent_type),
+    ATTRIB(EGL_LEVEL,               level),
+    ATTRIB(EGL_CONFIG_ID,           config_id),
+    ATTRIB(EGL_NATIVE_VISUAL_ID,    native_visual_id),
+#undef ATTRIB
+};
+
+static bool
+get_config_attribs(struct wegl_display *dpy, EGLConfig config,
+                   struct egl_config_attribs *attribs)
 {
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
-    EGLConfig config = NULL;
-    bool ok = true;
 
-    if (attrs->accum_buffer) {
-        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
-                     "accum buffers do not exist on EGL");
-        return NULL;
+    for (size_t i = 0; i < ARRAY_SIZE(egl_config_attrib_list); ++i) {
+        EGLint *value = (EGLint*) ((char*) attribs +
+                                   egl_config_attrib_list[i].offset);
+
+        if (!plat->eglGetConfigAttrib(dpy->egl, config,
+                                      egl_config_attrib_list[i].name,
+                                      value)) {
+            wegl_emit_error(plat, "eglGetConfigAttrib");
+            return false;
+        }
     }
 
-    // WARNING: If you resize attrib_list, then update renderable_index.
-    const int renderable_index = 19;
+    attribs->component_type = EGL_COLOR_COMPONENT_TYPE_FIXED_EXT;
+    if (dpy->EXT_pixel_format_float &&
+        !plat->eglGetConfigAttrib(dpy->egl, config,
+                                  EGL_COLOR_COMPONENT_TYPE_EXT,
+                                  &attribs->component_type)) {
+        wegl_emit_error(plat, "eglGetConfigAttrib");
+        return false;
+    }
 
-    EGLint attrib_list[] = {
-        // From page 17 of the EGL 1.4 spec:
-        //
-        //     EGL_BUFFER_SIZE gives the total of the color component bits of
-        //     the color buffer2 For an RGB color buffer, the total is the sum
-        //     of EGL_RED_SIZE, EGL_GREEN_SIZE, EGL_BLUE_SIZE, and
-        //     EGL_ALPHA_SIZE.
-        EGL_BUFFER_SIZE,            attrs->rgba_size,
-        EGL_RED_SIZE,               attrs->red_size,
-        EGL_GREEN_SIZE,             attrs->green_size,
-        EGL_BLUE_SIZE,              attrs->blue_size,
-        EGL_ALPHA_SIZE,             attrs->alpha_size,
+    return true;
+}
 
-        EGL_DEPTH_SIZE,             attrs->depth_size,
-        EGL_STENCIL_SIZE,           attrs->stencil_size,
+/// @brief Create the table of all EGLConfigs that Waffle can choose.
+///
+/// Drop the configs that eglChooseConfig() would reject for every request
+/// Waffle makes: those that are not RGB, that lack the platform's surface
+/// type, that are transparent, overlaid, or that have float components.
+static struct wcore_config_table*
+create_config_table(struct wcore_display *wc_dpy)
+{
+    struct wegl_display *dpy = wegl_display(wc_dpy);
+    struct wegl_platform *plat = wegl_platform(wc_dpy->platform);
+    const EGLint surface_type = plat->egl_surface_type_mask;
+    struct wcore_config_table *table = NULL;
+    EGLConfig *configs = NULL;
+    EGLint num_configs = 0;
 
-        EGL_SAMPLE_BUFFERS,         attrs->sample_buffers,
-        EGL_SAMPLES,                attrs->samples,
+    if (!plat->eglGetConfigs(dpy->egl, NULL, 0, &num_configs)) {
+        wegl_emit_error(plat, "eglGetConfigs");
+        return NULL;
+    }
 
-        EGL_RENDERABLE_TYPE,        31415926,
+    configs = wcore_calloc((num_configs + 1) * sizeof(*configs));
+    if (!configs)
+        return NULL;
 
-        // According to the EGL 1.4 spec Table 3.4, the default value of
-        // EGL_SURFACE_BIT is EGL_WINDOW_BIT.  We explicitly set the attribute
-        // here because not all Waffle platforms require EGL_WINDOW_BIT.
-        EGL_SURFACE_TYPE,           plat->egl_surface_type_mask,
+    if (!plat->eglGetConfigs(dpy->egl, configs, num_configs, &num_configs)) {
+        wegl_emit_error(plat, "eglGetConfigs");
+        goto fail;
+    }
 
-        EGL_NONE,
-    };
+    table = wcore_config_table_create(num_configs);
+    if (!table)
+        goto fail;
 
-    switch (attrs->context_api) {
-        case WAFFLE_CONTEXT_OPENGL:
-            attrib_list[renderable_index] = EGL_OPENGL_BIT;
-            break;
-        case WAFFLE_CONTEXT_OPENGL_ES1:
-            attrib_list[renderable_index] = EGL_OPENGL_ES_BIT;
-            break;
-        case WAFFLE_CONTEXT_OPENGL_ES2:
-            attrib_list[renderable_index] = EGL_OPENGL_ES2_BIT;
-            break;
-        case WAFFLE_CONTEXT_OPENGL_ES3:
-            attrib_list[renderable_index] = EGL_OPENGL_ES3_BIT_KHR;
-            break;
-        default:
-            assert(false);
-            return NULL;
+    for (EGLint i = 0; i < num_configs; ++i) {
+        struct egl_config_attribs a;
+        int32_t apis = 0;
+        int32_t n;
+
+        if (!get_config_attribs(dpy, configs[i], &a))
+            goto fail;
+
+        if (a.color_buffer_type != EGL_RGB_BUFFER ||
+            (a.surface_type & surface_type) != surface_type ||
+            a.transparent_type != EGL_NONE ||
+            a.level != 0 ||
+            a.component_type != EGL_COLOR_COMPONENT_TYPE_FIXED_EXT)
+            continue;
+
+        if (a.renderable_type & EGL_OPENGL_BIT)
+            apis |= WCORE_CONFIG_API_OPENGL;
+        if (a.renderable_type & EGL_OPENGL_ES_BIT)
+            apis |= WCORE_CONFIG_API_OPENGL_ES1;
+        if (a.renderable_type & EGL_OPENGL_ES2_BIT)
+            apis |= WCORE_CONFIG_API_OPENGL_ES2;
+        if (a.renderable_type & EGL_OPENGL_ES3_BIT_KHR)
+            apis |= WCORE_CONFIG_API_OPENGL_ES3;
+
+        n = table->count++;
+        table->red_size[n] = a.red_size;
+        table->green_size[n] = a.green_size;
+        table->blue_size[n] = a.blue_size;
+        table->alpha_size[n] = a.alpha_size;
+        table->buffer_size[n] = a.buffer_size;
+        table->depth_size[n] = a.depth_size;
+        table->stencil_size[n] = a.stencil_size;
+        table->sample_buffers[n] = a.sample_buffers;
+        table->samples[n] = a.samples;
+
+        // The window surface, not the config, decides double buffering.
+        table->double_buffered[n] = WAFFLE_DONT_CARE;
+        table->accum_size[n] = 0;
+
+        switch (a.caveat) {
+            case EGL_SLOW_CONFIG:
+                table->caveat[n] = WCORE_CONFIG_CAVEAT_SLOW;
+                break;
+            case EGL_NON_CONFORMANT_CONFIG:
+                table->caveat[n] = WCORE_CONFIG_CAVEAT_NON_CONFORMANT;
+                break;
+            default:
+                table->caveat[n] = WCORE_CONFIG_CAVEAT_NONE;
+                break;
+        }
+
+        table->apis[n] = apis;
+        table->visual[n] = a.native_visual_id;
+        table->id[n] = a.config_id;
+        table->native[n] = configs[i];
     }
 
-    EGLint num_configs = 0;
-    ok &= plat->eglChooseConfig(dpy->egl,
-                                attrib_list, &config, 1, &num_configs);
-    if (!ok) {
-        wegl_emit_error(plat, "eglChooseConfig");
+    free(configs);
+    return table;
+
+fail:
+    wcore_config_table_destroy(table);
+    free(configs);
+    return NULL;
+}
+
+static struct wcore_config*
+create_config(struct wegl_display *dpy,
+              const struct wcore_config_attrs *attrs,
+              const struct wcore_config_table *table,
+              int32_t index)
+{
+    struct wegl_config *config;
+
+    config = wcore_calloc(sizeof(*config));
+    if (!config)
         return NULL;
-    }
-    else if (num_configs == 0) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "eglChooseConfig found no matching configs");
+
+    if (!wcore_config_init(&config->wcore, &dpy->wcore, attrs)) {
+        free(config);
         return NULL;
     }
 
-    return config;
+    config->egl = table->native[index];
+    config->visual = table->visual[index];
+    return &config->wcore;
+}
+
+/// @brief Return the indices of the matching configs, best first.
+static int32_t
+match_configs(struct wegl_display *dpy,
+              const struct wcore_config_attrs *attrs,
+              const struct wcore_config_table **table,
+              int32_t **indices)
+{
+    int32_t num_matches;
+
+    if (!check_context_attrs(dpy, attrs))
+        return -1;
+
+    if (attrs->accum_buffer) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "accum buffers do not exist on EGL");
+        return -1;
+    }
+
+    *table = wcore_display_get_config_table(&dpy->wcore,
+                                            create_config_table);
+    if (!*table)
+        return -1;
+
+    *indices = wcore_malloc(((*table)->count + 1) * sizeof(**indices));
+    if (!*indices)
+        return -1;
+
+    num_matches = wcore_config_table_match(*table, attrs, *indices);
+    if (num_matches < 0) {
+        free(*indices);
+        *indices = NULL;
+    }
+
+    return num_matches;
 }
 
 struct wcore_config*
@@ -204,39 +405,70 @@ wegl_config_choose(struct wcore_platform *wc_plat,
                    struct wcore_display *wc_dpy,
                    const struct wcore_config_attrs *attrs)
 {
-    struct wegl_platform *plat = wegl_platform(wc_plat);
     struct wegl_display *dpy = wegl_display(wc_dpy);
-    struct wegl_config *config;
-    bool ok;
+    const struct wcore_config_table *table;
+    struct wcore_config *config = NULL;
+    int32_t *indices = NULL;
+    int32_t num_matches;
 
     (void) wc_plat;
 
-    config = wcore_calloc(sizeof(*config));
-    if (!config)
+    num_matches = match_configs(dpy, attrs, &table, &indices);
+    if (num_matches < 0)
         return NULL;
 
-    ok = wcore_config_init(&config->wcore, wc_dpy, attrs);
-    if (!ok)
-        goto fail;
+    if (num_matches == 0) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "no EGLConfig matches the requested attributes");
+        goto out;
+    }
 
-    if (!check_context_attrs(dpy, attrs))
-        goto fail;
+    config = create_config(dpy, attrs, table, indices[0]);
 
-    config->egl = choose_real_config(dpy, attrs);
-    if (!config->egl)
-        goto fail;
+out:
+    free(indices);
+    return config;
+}
 
-    ok = plat->eglGetConfigAttrib(dpy->egl, config->egl,
-                                  EGL_NATIVE_VISUAL_ID, &config->visual);
+bool
+wegl_config_enumerate(struct wcore_platform *wc_plat,
+                      struct wcore_display *wc_dpy,
+                      const struct wcore_config_attrs *attrs,
+                      struct wcore_config **configs,
+                      int32_t configs_size,
+                      int32_t *num_configs)
+{
+    struct wegl_display *dpy = wegl_display(wc_dpy);
+    const struct wcore_config_table *table;
+    int32_t *indices = NULL;
+    int32_t num_matches;
+    int32_t n = 0;
 
-    if (!ok)
-        goto fail;
+    (void) wc_plat;
 
-    return &config->wcore;
+    num_matches = match_configs(dpy, attrs, &table, &indices);
+    if (num_matches < 0)
+        return false;
+
+    if (configs) {
+        for (; n < num_matches && n < configs_size; ++n) {
+            configs[n] = create_config(dpy, attrs, table, indices[n]);
+            if (!configs[n])
+                goto fail;
+        }
+    } else {
+        n = num_matches;
+    }
+
+    free(indices);
+    *num_configs = n;
+    return true;
 
 fail:
-    wegl_config_destroy(&config->wcore);
-    return NULL;
+    while (n-- > 0)
+        wegl_config_destroy(configs[n]);
+    free(indices);
+    return false;
 }
 
 bool
@@ -30,6 +30,7 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fbo.h"
 #include "wegl_imports.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
@@ -64,6 +65,17 @@ bind_api(struct wegl_platform *plat, int32_t waffle_context_api)
     return ok;
 }
 
+static EGLint
+priority_to_egl(int32_t priority)
+{
+    switch (priority) {
+        case WAFFLE_CONTEXT_PRIORITY_LOW:       return EGL_CONTEXT_PRIORITY_LOW_IMG;
+        case WAFFLE_CONTEXT_PRIORITY_HIGH:      return EGL_CONTEXT_PRIORITY_HIGH_IMG;
+        case WAFFLE_CONTEXT_PRIORITY_REALTIME:  return EGL_CONTEXT_PRIORITY_REALTIME_NV;
+        default:                                return EGL_CONTEXT_PRIORITY_MEDIUM_IMG;
+    }
+}
+
 static EGLContext
 create_real_context(struct wegl_config *config,
                     EGLContext share_ctx)
@@ -162,6 +174,24 @@ create_real_context(struct wegl_config *config,
             return EGL_NO_CONTEXT;
     }
 
+    if (attrs->context_no_error) {
+        attrib_list[i++] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+        attrib_list[i++] = EGL_TRUE;
+    }
+
+    // Flushing is the default, so only NONE needs the extension.
+    if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE) {
+        attrib_list[i++] = EGL_CONTEXT_RELEASE_BEHAVIOR_KHR;
+        attrib_list[i++] = EGL_CONTEXT_RELEASE_BEHAVIOR_NONE_KHR;
+    }
+
+    // The priority is a hint. The driver may grant a lower one, which
+    // wegl_context_get_priority() reports.
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM) {
+        attrib_list[i++] = EGL_CONTEXT_PRIORITY_LEVEL_IMG;
+        attrib_list[i++] = priority_to_egl(attrs->context_priority);
+    }
+
     if (context_flags != 0) {
         attrib_list[i++] = EGL_CONTEXT_FLAGS_KHR;
         attrib_list[i++] = context_flags;
@@ -172,7 +202,10 @@ create_real_context(struct wegl_config *config,
     if (!bind_api(plat, waffle_context_api))
         return EGL_NO_CONTEXT;
 
-    EGLContext ctx = plat->eglCreateContext(dpy->egl, config->egl,
+    EGLConfig egl_config = attrs->context_no_config ? EGL_NO_CONFIG_KHR
+                                                    : config->egl;
+
+    EGLContext ctx = plat->eglCreateContext(dpy->egl, egl_config,
                                             share_ctx, attrib_list);
     if (!ctx)
         wegl_emit_error(plat, "eglCreateContext");
@@ -193,6 +226,9 @@ wegl_context_init(struct wegl_context *ctx,
     if (!ok)
         goto fail;
 
+    ctx->glBindFramebuffer = NULL;
+    ctx->fbos = NULL;
+
     ctx->egl = create_real_context(config,
                                    share_ctx
                                        ? share_ctx->egl
@@ -240,6 +276,8 @@ wegl_context_teardown(struct wegl_context *ctx)
         struct wegl_display *dpy = wegl_display(ctx->wcore.display);
         struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
 
+        result &= wegl_fbo_release_owner(ctx);
+
         if (!plat->eglDestroyContext(dpy->egl, ctx->egl)) {
             wegl_emit_error(plat, "eglDestroyContext");
             result = false;
@@ -262,3 +300,45 @@ wegl_context_destroy(struct wcore_context *wc_ctx)
     }
     return result;
 }
+
+bool
+wegl_context_get_priority(struct wcore_context *wc_ctx,
+                          int32_t *priority)
+{
+    struct wegl_context *ctx = wegl_context(wc_ctx);
+    struct wegl_display *dpy = wegl_display(wc_ctx->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLint value;
+
+    // Without the extension, only medium priority contexts can be requested.
+    if (!dpy->IMG_context_priority) {
+        *priority = WAFFLE_CONTEXT_PRIORITY_MEDIUM;
+        return true;
+    }
+
+    if (!plat->eglQueryContext(dpy->egl, ctx->egl,
+                               EGL_CONTEXT_PRIORITY_LEVEL_IMG, &value)) {
+        wegl_emit_error(plat, "eglQueryContext");
+        return false;
+    }
+
+    switch (value) {
+        case EGL_CONTEXT_PRIORITY_LOW_IMG:
+            *priority = WAFFLE_CONTEXT_PRIORITY_LOW;
+            return true;
+        case EGL_CONTEXT_PRIORITY_MEDIUM_IMG:
+            *priority = WAFFLE_CONTEXT_PRIORITY_MEDIUM;
+            return true;
+        case EGL_CONTEXT_PRIORITY_HIGH_IMG:
+            *priority = WAFFLE_CONTEXT_PRIORITY_HIGH;
+            return true;
+        case EGL_CONTEXT_PRIORITY_REALTIME_NV:
+            *priority = WAFFLE_CONTEXT_PRIORITY_REALTIME;
+            return true;
+        default:
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "eglQueryContext returned unknown priority 0x%x",
+                         value);
+            return false;
+    }
+}
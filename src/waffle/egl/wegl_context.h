@@ -33,9 +33,20 @@
 #include "wcore_context.h"
 #include "wcore_util.h"
 
+struct wegl_fbo;
+
 struct wegl_context {
     struct wcore_context wcore;
     EGLContext egl;
+
+    /// @brief List, linked by wegl_fbo::next_owned, of the framebuffer
+    /// object windows whose GL objects live in this context.
+    struct wegl_fbo *fbos;
+
+    /// @brief Set while a wegl_fbo is bound, so that the default framebuffer
+    /// can be bound again when the context is made current with a surface.
+    void (WAFFLE_GL_APIENTRY *glBindFramebuffer)(uint32_t target,
+                                                 uint32_t framebuffer);
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_context,
@@ -58,3 +69,7 @@ wegl_context_create(struct wcore_platform *wc_plat,
 
 bool
 wegl_context_destroy(struct wcore_context *wc_ctx);
+
+bool
+wegl_context_get_priority(struct wcore_context *wc_ctx,
+                          int32_t *priority);
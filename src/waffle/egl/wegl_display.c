@@ -24,8 +24,12 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assert.h>
+#include <stdlib.h>
+
+#include "threads.h"
 
 #include "wcore_error.h"
+#include "wcore_ext_set.h"
 #include "wcore_platform.h"
 
 #include "wegl_display.h"
@@ -73,92 +77,315 @@ get_extensions(struct wegl_display *dpy)
 {
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
     const char *extensions = plat->eglQueryString(dpy->egl, EGL_EXTENSIONS);
+    struct wcore_ext_set set;
 
     if (!extensions) {
         wegl_emit_error(plat, "eglQueryString(EGL_EXTENSIONS)");
         return false;
     }
 
-    // waffle_is_extension_in_string() resets the error state. That's ok,
-    // however, because if we've reached this point then no error should be
-    // pending emission.
-    assert(wcore_error_get_code() == 0);
+    if (!wcore_ext_set_init(&set, extensions))
+        return false;
 
 #define CHECK_EXTENSION(ext) \
-    dpy->ext = waffle_is_extension_in_string(extensions, "EGL_" #ext)
+    dpy->ext = wcore_ext_set_has(&set, "EGL_" #ext)
 
     CHECK_EXTENSION(EXT_create_context_robustness);
     CHECK_EXTENSION(KHR_create_context);
+    CHECK_EXTENSION(KHR_create_context_no_error);
+    CHECK_EXTENSION(KHR_context_flush_control);
+    CHECK_EXTENSION(IMG_context_priority);
+    CHECK_EXTENSION(NV_context_priority_realtime);
+    CHECK_EXTENSION(KHR_no_config_context);
+    CHECK_EXTENSION(MESA_configless_context);
+    CHECK_EXTENSION(KHR_surfaceless_context);
+    CHECK_EXTENSION(MESA_query_driver);
     CHECK_EXTENSION(EXT_image_dma_buf_import_modifiers);
+    CHECK_EXTENSION(EXT_pixel_format_float);
 
 #undef CHECK_EXTENSION
 
+    wcore_ext_set_teardown(&set);
+    return true;
+}
+
+/// @brief An initialized EGLDisplay and what Waffle learned about it.
+///
+/// EGL returns the same EGLDisplay for every connection to one native
+/// display, and eglTerminate() on any of them terminates all. So each
+/// EGLDisplay is initialized once per process, and terminated when its last
+/// wegl_display is torn down.
+struct wegl_shared_display {
+    struct wegl_shared_display *next;
+
+    /// @brief The key. eglTerminate identifies the EGL library.
+    void *eglTerminate;
+    EGLenum egl_platform;
+    void *native_display;
+
+    /// @brief Whether the first connection is still initializing `info`.
+    bool pending;
+    bool failed;
+
+    /// @brief Number of wegl_displays using `info`.
+    int refcount;
+
+    /// @brief Number of threads waiting for `pending` to clear.
+    int waiters;
+
+    /// @brief The display as the first connection initialized it.
+    struct wegl_display info;
+};
+
+static struct wegl_shared_display *shared_displays;
+static mtx_t shared_mutex;
+static cnd_t shared_cond;
+static once_flag shared_once = ONCE_FLAG_INIT;
+static bool shared_init_ok;
+
+static void
+shared_init_once(void)
+{
+    shared_init_ok = mtx_init(&shared_mutex, mtx_plain) == thrd_success &&
+                     cnd_init(&shared_cond) == thrd_success;
+}
+
+static struct wegl_shared_display*
+shared_find(struct wegl_platform *plat, void *native_display)
+{
+    for (struct wegl_shared_display *s = shared_displays; s; s = s->next) {
+        if (s->eglTerminate == (void*) plat->eglTerminate &&
+            s->egl_platform == plat->egl_platform &&
+            s->native_display == native_display)
+            return s;
+    }
+
+    return NULL;
+}
+
+static void
+shared_remove(struct wegl_shared_display *shared)
+{
+    struct wegl_shared_display **p = &shared_displays;
+
+    while (*p != shared)
+        p = &(*p)->next;
+
+    *p = shared->next;
+}
+
+/// @brief Give @a dpy the shared state, keeping its own wcore_display.
+static void
+shared_copy(struct wegl_display *dpy, struct wegl_shared_display *shared)
+{
+    struct wcore_display wcore = dpy->wcore;
+
+    *dpy = shared->info;
+    dpy->wcore = wcore;
+    dpy->shared = shared;
+}
+
+/// @brief Find the shared display, or insert a pending one for the caller
+/// to initialize.
+///
+/// Return false if the lock or the allocation fails. Otherwise set
+/// @a shared, and set @a found if it is ready to use.
+static bool
+shared_acquire(struct wegl_platform *plat, void *native_display,
+               struct wegl_shared_display **shared, bool *found)
+{
+    struct wegl_shared_display *s;
+
+    call_once(&shared_once, shared_init_once);
+    if (!shared_init_ok) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init or cnd_init failed");
+        return false;
+    }
+
+    mtx_lock(&shared_mutex);
+
+    while ((s = shared_find(plat, native_display)) && s->pending) {
+        s->waiters++;
+        cnd_wait(&shared_cond, &shared_mutex);
+        s->waiters--;
+
+        // A failed display left the list; the last waiter frees it.
+        if (s->failed && s->waiters == 0)
+            free(s);
+    }
+
+    if (s) {
+        s->refcount++;
+        *shared = s;
+        *found = true;
+        mtx_unlock(&shared_mutex);
+        return true;
+    }
+
+    s = wcore_calloc(sizeof(*s));
+    if (!s) {
+        mtx_unlock(&shared_mutex);
+        return false;
+    }
+
+    s->eglTerminate = (void*) plat->eglTerminate;
+    s->egl_platform = plat->egl_platform;
+    s->native_display = native_display;
+    s->pending = true;
+    s->next = shared_displays;
+    shared_displays = s;
+
+    *shared = s;
+    *found = false;
+    mtx_unlock(&shared_mutex);
     return true;
 }
 
+/// @brief Publish the result of initializing a pending shared display.
+static void
+shared_publish(struct wegl_shared_display *shared,
+               struct wegl_display *dpy, bool ok)
+{
+    mtx_lock(&shared_mutex);
+
+    shared->pending = false;
+
+    if (ok) {
+        shared->info = *dpy;
+        shared->info.shared = shared;
+        shared->refcount = 1;
+        dpy->shared = shared;
+    } else {
+        shared_remove(shared);
+        shared->failed = true;
+        if (shared->waiters == 0)
+            free(shared);
+    }
+
+    cnd_broadcast(&shared_cond);
+    mtx_unlock(&shared_mutex);
+}
+
 /// On Linux, according to eglplatform.h, EGLNativeDisplayType and intptr_t
 /// have the same size regardless of platform.
-bool
-wegl_display_init(struct wegl_display *dpy,
-                  struct wcore_platform *wc_plat,
-                  void *native_display)
+static bool
+initialize(struct wegl_display *dpy, void *native_display)
 {
-    struct wegl_platform *plat = wegl_platform(wc_plat);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
     bool ok;
 
-    ok = wcore_display_init(&dpy->wcore, wc_plat);
-    if (!ok)
-        goto fail;
+    // With EGL_KHR_display_reference, EGL counts eglInitialize() calls, so
+    // Waffle's eglTerminate() cannot pull the display out from under other
+    // users in the process.
+    const bool track_references =
+        wcore_ext_set_has(&plat->client_extensions,
+                          "EGL_KHR_display_reference");
+    const EGLAttrib attrib_list[] = {
+        EGL_TRACK_REFERENCES_KHR, EGL_TRUE,
+        EGL_NONE,
+    };
+    const EGLint attrib_list_ext[] = {
+        EGL_TRACK_REFERENCES_KHR, EGL_TRUE,
+        EGL_NONE,
+    };
 
     if (wegl_platform_can_use_eglGetPlatformDisplay(plat)) {
         dpy->egl = plat->eglGetPlatformDisplay(plat->egl_platform,
-                                               native_display, NULL);
+                                               native_display,
+                                               track_references ?
+                                                   attrib_list : NULL);
         if (!dpy->egl) {
             wegl_emit_error(plat, "eglGetPlatformDisplay");
-            goto fail;
+            return false;
         }
     } else if (wegl_platform_can_use_eglGetPlatformDisplayEXT(plat)) {
         dpy->egl = plat->eglGetPlatformDisplayEXT(plat->egl_platform,
-                                                  native_display, NULL);
+                                                  native_display,
+                                                  track_references ?
+                                                      attrib_list_ext : NULL);
         if (!dpy->egl) {
             wegl_emit_error(plat, "eglGetPlatformDisplayEXT");
-            goto fail;
+            return false;
         }
     } else {
         dpy->egl = plat->eglGetDisplay((EGLNativeDisplayType) native_display);
         if (!dpy->egl) {
             wegl_emit_error(plat, "eglGetDisplay");
-            goto fail;
+            return false;
         }
     }
 
     ok = plat->eglInitialize(dpy->egl, &dpy->major_version, &dpy->minor_version);
     if (!ok) {
         wegl_emit_error(plat, "eglInitialize");
-        goto fail;
+        return false;
     }
 
     ok = get_apis(dpy);
     if (!ok)
-        goto fail;
+        return false;
+
+    return get_extensions(dpy);
+}
 
-    ok = get_extensions(dpy);
+bool
+wegl_display_init(struct wegl_display *dpy,
+                  struct wcore_platform *wc_plat,
+                  void *native_display)
+{
+    struct wegl_platform *plat = wegl_platform(wc_plat);
+    struct wegl_shared_display *shared;
+    bool found;
+    bool ok;
+
+    ok = wcore_display_init(&dpy->wcore, wc_plat);
     if (!ok)
-        goto fail;
+        return false;
 
-    return true;
+    ok = shared_acquire(plat, native_display, &shared, &found);
+    if (!ok)
+        return false;
 
-fail:
-    wegl_display_teardown(dpy);
-    return false;
+    if (found) {
+        shared_copy(dpy, shared);
+        return true;
+    }
+
+    ok = initialize(dpy, native_display);
+    shared_publish(shared, dpy, ok);
+    if (!ok) {
+        wegl_display_teardown(dpy);
+        return false;
+    }
+
+    return true;
 }
 
 bool
 wegl_display_teardown(struct wegl_display *dpy)
 {
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    struct wegl_shared_display *shared = dpy->shared;
     bool ok = true;
 
+    wcore_display_teardown(&dpy->wcore);
+
+    if (shared) {
+        bool last;
+
+        mtx_lock(&shared_mutex);
+        last = --shared->refcount == 0;
+        if (last)
+            shared_remove(shared);
+        mtx_unlock(&shared_mutex);
+
+        dpy->shared = NULL;
+        if (!last)
+            return true;
+
+        free(shared);
+    }
+
     if (dpy->egl) {
         ok = plat->eglTerminate(dpy->egl);
         if (!ok)
@@ -188,3 +415,56 @@ wegl_display_supports_context_api(struct wcore_display *wc_dpy,
             return false;
     }
 }
+
+/// Return the DRM device file behind the display, or NULL if EGL cannot
+/// tell.
+static const char*
+get_device_path(struct wegl_display *dpy)
+{
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLAttrib device = 0;
+    const char *extensions;
+
+    // EGL_EXT_device_base is the union of EGL_EXT_device_query and
+    // EGL_EXT_device_enumeration.
+    if (!wcore_ext_set_has(&plat->client_extensions, "EGL_EXT_device_query") &&
+        !wcore_ext_set_has(&plat->client_extensions, "EGL_EXT_device_base"))
+        return NULL;
+
+    if (!plat->eglQueryDisplayAttribEXT || !plat->eglQueryDeviceStringEXT)
+        return NULL;
+
+    if (!plat->eglQueryDisplayAttribEXT(dpy->egl, EGL_DEVICE_EXT, &device) ||
+        !device)
+        return NULL;
+
+    extensions = plat->eglQueryDeviceStringEXT((EGLDeviceEXT) device,
+                                               EGL_EXTENSIONS);
+    if (!extensions ||
+        !waffle_is_extension_in_string(extensions, "EGL_EXT_device_drm"))
+        return NULL;
+
+    return plat->eglQueryDeviceStringEXT((EGLDeviceEXT) device,
+                                         EGL_DRM_DEVICE_FILE_EXT);
+}
+
+void
+wegl_display_get_capabilities(struct wcore_display *wc_dpy,
+                              struct waffle_display_capabilities *caps)
+{
+    struct wegl_display *dpy = wegl_display(wc_dpy);
+    struct wegl_platform *plat = wegl_platform(wc_dpy->platform);
+    bool egl_1_5 = dpy->major_version > 1 ||
+                   (dpy->major_version == 1 && dpy->minor_version >= 5);
+
+    // The same conditions as check_context_attrs() in wegl_config.c.
+    caps->robust_access = dpy->EXT_create_context_robustness || egl_1_5;
+    caps->debug = dpy->KHR_create_context;
+    caps->no_error = dpy->KHR_create_context_no_error;
+    caps->release_behavior_none = dpy->KHR_context_flush_control;
+
+    if (dpy->MESA_query_driver && plat->eglGetDisplayDriverName)
+        caps->driver_name = plat->eglGetDisplayDriverName(dpy->egl);
+
+    caps->device_path = get_device_path(dpy);
+}
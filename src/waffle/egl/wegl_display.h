@@ -33,6 +33,7 @@
 #include "wcore_display.h"
 
 struct wcore_display;
+struct wegl_shared_display;
 
 enum wegl_supported_api {
     WEGL_OPENGL_API = 1 << 0,
@@ -45,9 +46,22 @@ struct wegl_display {
     enum wegl_supported_api api_mask;
     bool EXT_create_context_robustness;
     bool KHR_create_context;
+    bool KHR_create_context_no_error;
+    bool KHR_context_flush_control;
+    bool IMG_context_priority;
+    bool NV_context_priority_realtime;
+    bool KHR_no_config_context;
+    bool MESA_configless_context;
+    bool KHR_surfaceless_context;
+    bool MESA_query_driver;
     bool EXT_image_dma_buf_import_modifiers;
+    bool EXT_pixel_format_float;
     EGLint major_version;
     EGLint minor_version;
+
+    /// @brief The process-wide record of `egl`, shared with every other
+    /// wegl_display connected to the same native display.
+    struct wegl_shared_display *shared;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_display,
@@ -66,3 +80,7 @@ wegl_display_teardown(struct wegl_display *dpy);
 bool
 wegl_display_supports_context_api(struct wcore_display *wc_dpy,
                                   int32_t waffle_context_api);
+
+void
+wegl_display_get_capabilities(struct wcore_display *wc_dpy,
+                              struct waffle_display_capabilities *caps);
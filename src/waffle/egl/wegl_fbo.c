@@ -0,0 +1,442 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "wcore_config.h"
+#include "wcore_error.h"
+#include "wcore_ext_set.h"
+#include "wcore_gl_proc.h"
+#include "wcore_platform.h"
+#include "wcore_tinfo.h"
+#include "wcore_util.h"
+
+#include "wegl_context.h"
+#include "wegl_display.h"
+#include "wegl_fbo.h"
+#include "wegl_platform.h"
+#include "wegl_util.h"
+
+#define GL_FRAMEBUFFER                  0x8D40
+#define GL_RENDERBUFFER                 0x8D41
+#define GL_RENDERBUFFER_BINDING         0x8CA7
+#define GL_COLOR_ATTACHMENT0            0x8CE0
+#define GL_DEPTH_ATTACHMENT             0x8D00
+#define GL_STENCIL_ATTACHMENT           0x8D20
+#define GL_FRAMEBUFFER_COMPLETE         0x8CD5
+#define GL_VERSION                      0x1F02
+#define GL_EXTENSIONS                   0x1F03
+#define GL_RGB8                         0x8051
+#define GL_RGBA4                        0x8056
+#define GL_RGBA8                        0x8058
+#define GL_RGB565                       0x8D62
+#define GL_DEPTH_COMPONENT16            0x81A5
+#define GL_DEPTH24_STENCIL8             0x88F0
+
+struct wegl_fbo*
+wegl_fbo_create(struct wcore_config *wc_config,
+                int32_t width, int32_t height)
+{
+    struct wcore_platform *plat = wc_config->display->platform;
+    struct wegl_display *dpy = wegl_display(wc_config->display);
+    const struct wcore_config_attrs *attrs = &wc_config->attrs;
+    struct wegl_fbo *self;
+    struct wcore_gl_proc_loader loader;
+
+    if (!dpy->KHR_surfaceless_context &&
+        dpy->major_version == 1 && dpy->minor_version < 5) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_surfaceless_context or EGL 1.5 is required in "
+                     "order to create a framebuffer object window");
+        return NULL;
+    }
+
+    if (attrs->context_api == WAFFLE_CONTEXT_OPENGL_ES1) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "framebuffer object windows are not supported for "
+                     "OpenGL ES1");
+        return NULL;
+    }
+
+    if (attrs->samples > 0) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "framebuffer object windows are not supported for "
+                     "multisampled configs");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    self->platform = plat;
+    self->context_api = attrs->context_api;
+    self->width = width;
+    self->height = height;
+
+    if (attrs->alpha_size > 0)
+        self->color_format = GL_RGBA8;
+    else if (attrs->red_size > 0 && attrs->red_size <= 5)
+        self->color_format = GL_RGB565;
+    else
+        self->color_format = GL_RGB8;
+
+    if (attrs->stencil_size > 0 || attrs->depth_size > 16)
+        self->depth_stencil_format = GL_DEPTH24_STENCIL8;
+    else if (attrs->depth_size > 0)
+        self->depth_stencil_format = GL_DEPTH_COMPONENT16;
+
+    self->stencil = attrs->stencil_size > 0;
+
+    wcore_gl_proc_loader_init(&loader, plat, attrs->context_api);
+
+#define RETRIEVE_GL_PROC(type, name, params) \
+    self->gl.name = (type (WAFFLE_GL_APIENTRY *) params) \
+        wcore_gl_proc_loader_get(&loader, #name); \
+    if (!self->gl.name) { \
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM, \
+                     "failed to resolve %s for a framebuffer object window", \
+                     #name); \
+        goto fail; \
+    }
+
+    WEGL_FBO_GL_FUNCTIONS(RETRIEVE_GL_PROC)
+
+#undef RETRIEVE_GL_PROC
+
+    return self;
+
+fail:
+    free(self);
+    return NULL;
+}
+
+// Compare pointers only, as a stale current context may have been freed.
+static bool
+wegl_fbo_owner_is_current(struct wegl_fbo *self)
+{
+    struct wcore_tinfo *tinfo = wcore_tinfo_get();
+
+    return self->owner &&
+           !tinfo->current_is_stale &&
+           tinfo->current_context == &self->owner->wcore;
+}
+
+static void
+wegl_fbo_delete_objects(struct wegl_fbo *self)
+{
+    self->gl.glDeleteFramebuffers(1, &self->framebuffer);
+    self->gl.glDeleteRenderbuffers(1, &self->color_renderbuffer);
+    if (self->depth_stencil_renderbuffer)
+        self->gl.glDeleteRenderbuffers(1, &self->depth_stencil_renderbuffer);
+}
+
+// Forget the GL objects, so that the next context made current with the
+// framebuffer creates new ones.
+static void
+wegl_fbo_reset(struct wegl_fbo *self)
+{
+    self->framebuffer = 0;
+    self->color_renderbuffer = 0;
+    self->depth_stencil_renderbuffer = 0;
+    self->owner = NULL;
+    self->next_owned = NULL;
+    self->storage_valid = false;
+}
+
+// Delete the GL objects in the owner, making it current on this thread if it
+// is not. Does not unlink @a self from the owner.
+static bool
+wegl_fbo_delete_in_owner(struct wegl_fbo *self)
+{
+    struct wegl_platform *plat = wegl_platform(self->platform);
+    struct wegl_display *dpy = wegl_display(self->owner->wcore.display);
+    EGLDisplay old_dpy;
+    EGLSurface old_draw;
+    EGLSurface old_read;
+    EGLContext old_ctx;
+    bool ok;
+
+    if (wegl_fbo_owner_is_current(self)) {
+        wegl_fbo_delete_objects(self);
+        return true;
+    }
+
+    old_dpy = plat->eglGetCurrentDisplay();
+    old_draw = plat->eglGetCurrentSurface(EGL_DRAW);
+    old_read = plat->eglGetCurrentSurface(EGL_READ);
+    old_ctx = plat->eglGetCurrentContext();
+
+    // This fails if the owner is current on another thread. Then the GL
+    // objects are freed with the owner.
+    if (!plat->eglMakeCurrent(dpy->egl, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                              self->owner->egl))
+        return true;
+
+    wegl_fbo_delete_objects(self);
+
+    if (old_ctx != EGL_NO_CONTEXT) {
+        ok = plat->eglMakeCurrent(old_dpy, old_draw, old_read, old_ctx);
+    } else {
+        ok = plat->eglMakeCurrent(dpy->egl, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                                  EGL_NO_CONTEXT);
+    }
+
+    if (!ok) {
+        wegl_emit_error(plat, "eglMakeCurrent");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+wegl_fbo_destroy(struct wegl_fbo *self)
+{
+    struct wegl_fbo **link;
+    bool ok = true;
+
+    if (!self)
+        return true;
+
+    if (self->owner) {
+        for (link = &self->owner->fbos; *link; link = &(*link)->next_owned) {
+            if (*link == self) {
+                *link = self->next_owned;
+                break;
+            }
+        }
+
+        ok = wegl_fbo_delete_in_owner(self);
+    }
+
+    free(self);
+    return ok;
+}
+
+bool
+wegl_fbo_release_owner(struct wegl_context *ctx)
+{
+    struct wegl_fbo *fbo = ctx->fbos;
+    bool ok = true;
+
+    while (fbo) {
+        struct wegl_fbo *next = fbo->next_owned;
+
+        ok &= wegl_fbo_delete_in_owner(fbo);
+        wegl_fbo_reset(fbo);
+        fbo = next;
+    }
+
+    ctx->fbos = NULL;
+    return ok;
+}
+
+bool
+wegl_fbo_check_context(struct wegl_fbo *self, struct wegl_context *ctx)
+{
+    if (ctx && self->owner && ctx != self->owner) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "the framebuffer object window is owned by another "
+                     "context");
+        return false;
+    }
+
+    return true;
+}
+
+// OpenGL ES 2.0 has 8-bit color and packed depth/stencil renderbuffers only
+// with GL_OES_rgb8_rgba8 and GL_OES_packed_depth_stencil. Without them, fall
+// back to the core formats, or fail if the config needs stencil.
+static bool
+wegl_fbo_choose_formats(struct wegl_fbo *self)
+{
+    const char *version;
+    struct wcore_ext_set exts;
+    bool has_rgb8_rgba8;
+    bool has_packed_depth_stencil;
+
+    if (self->context_api != WAFFLE_CONTEXT_OPENGL_ES2)
+        return true;
+
+    // A context created for OpenGL ES2 may be OpenGL ES 3.x.
+    version = (const char *) self->gl.glGetString(GL_VERSION);
+    if (version && strncmp(version, "OpenGL ES 2.", 12) != 0)
+        return true;
+
+    if (!wcore_ext_set_init(&exts,
+            (const char *) self->gl.glGetString(GL_EXTENSIONS)))
+        return false;
+
+    has_rgb8_rgba8 = wcore_ext_set_has(&exts, "GL_OES_rgb8_rgba8");
+    has_packed_depth_stencil =
+        wcore_ext_set_has(&exts, "GL_OES_packed_depth_stencil");
+    wcore_ext_set_teardown(&exts);
+
+    if (!has_rgb8_rgba8) {
+        if (self->color_format == GL_RGBA8)
+            self->color_format = GL_RGBA4;
+        else if (self->color_format == GL_RGB8)
+            self->color_format = GL_RGB565;
+    }
+
+    if (!has_packed_depth_stencil &&
+        self->depth_stencil_format == GL_DEPTH24_STENCIL8) {
+        if (self->stencil) {
+            wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                         "framebuffer object windows with stencil require "
+                         "GL_OES_packed_depth_stencil on OpenGL ES 2.0");
+            return false;
+        }
+
+        self->depth_stencil_format = GL_DEPTH_COMPONENT16;
+    }
+
+    return true;
+}
+
+// Allocate storage of the current size without disturbing the application's
+// renderbuffer binding.
+static void
+wegl_fbo_alloc_storage(struct wegl_fbo *self)
+{
+    int32_t renderbuffer = 0;
+
+    self->gl.glGetIntegerv(GL_RENDERBUFFER_BINDING, &renderbuffer);
+
+    self->gl.glBindRenderbuffer(GL_RENDERBUFFER, self->color_renderbuffer);
+    self->gl.glRenderbufferStorage(GL_RENDERBUFFER, self->color_format,
+                                   self->width, self->height);
+
+    if (self->depth_stencil_renderbuffer) {
+        self->gl.glBindRenderbuffer(GL_RENDERBUFFER,
+                                    self->depth_stencil_renderbuffer);
+        self->gl.glRenderbufferStorage(GL_RENDERBUFFER,
+                                       self->depth_stencil_format,
+                                       self->width, self->height);
+    }
+
+    self->gl.glBindRenderbuffer(GL_RENDERBUFFER, (uint32_t) renderbuffer);
+    self->storage_valid = true;
+}
+
+bool
+wegl_fbo_bind(struct wegl_fbo *self, struct wegl_context *ctx)
+{
+    bool first_bind = self->owner == NULL;
+    uint32_t status;
+
+    if (first_bind) {
+        if (!wegl_fbo_choose_formats(self))
+            return false;
+
+        self->gl.glGenFramebuffers(1, &self->framebuffer);
+        self->gl.glGenRenderbuffers(1, &self->color_renderbuffer);
+        if (self->depth_stencil_format)
+            self->gl.glGenRenderbuffers(1, &self->depth_stencil_renderbuffer);
+        self->owner = ctx;
+    }
+
+    if (!self->storage_valid)
+        wegl_fbo_alloc_storage(self);
+
+    self->gl.glBindFramebuffer(GL_FRAMEBUFFER, self->framebuffer);
+    ctx->glBindFramebuffer = self->gl.glBindFramebuffer;
+
+    if (!first_bind)
+        return true;
+
+    self->gl.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                       GL_RENDERBUFFER,
+                                       self->color_renderbuffer);
+
+    // Attach depth and stencil separately, because GL_DEPTH_STENCIL_ATTACHMENT
+    // is missing from OpenGL ES 2.0.
+    if (self->depth_stencil_format) {
+        self->gl.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                                           GL_RENDERBUFFER,
+                                           self->depth_stencil_renderbuffer);
+    }
+    if (self->depth_stencil_format == GL_DEPTH24_STENCIL8) {
+        self->gl.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT,
+                                           GL_RENDERBUFFER,
+                                           self->depth_stencil_renderbuffer);
+    }
+
+    status = self->gl.glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "glCheckFramebufferStatus returned 0x%x for a "
+                     "framebuffer object window", status);
+        wegl_fbo_delete_objects(self);
+        wegl_fbo_reset(self);
+        ctx->glBindFramebuffer = NULL;
+        return false;
+    }
+
+    self->next_owned = ctx->fbos;
+    ctx->fbos = self;
+
+    // A context gets a viewport of the surface's size when it is first made
+    // current with a surface. Do the same for the framebuffer object.
+    self->gl.glViewport(0, 0, self->width, self->height);
+    return true;
+}
+
+void
+wegl_fbo_unbind(struct wegl_context *ctx)
+{
+    if (!ctx->glBindFramebuffer)
+        return;
+
+    ctx->glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ctx->glBindFramebuffer = NULL;
+}
+
+bool
+wegl_fbo_resize(struct wegl_fbo *self, int32_t width, int32_t height)
+{
+    self->width = width;
+    self->height = height;
+    self->storage_valid = false;
+
+    // Otherwise the storage is reallocated when the owner is next made
+    // current with the window.
+    if (wegl_fbo_owner_is_current(self))
+        wegl_fbo_alloc_storage(self);
+
+    return true;
+}
+
+bool
+wegl_fbo_swap_buffers(struct wegl_fbo *self)
+{
+    // There is nothing to present, but flush as eglSwapBuffers would.
+    if (wegl_fbo_owner_is_current(self))
+        self->gl.glFlush();
+
+    return true;
+}
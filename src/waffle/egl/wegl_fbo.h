@@ -0,0 +1,131 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "waffle.h"
+
+struct wcore_config;
+struct wcore_platform;
+struct wegl_context;
+
+// The GL entry points that struct wegl_fbo uses, as
+// f(return_type, name, parameters).
+#define WEGL_FBO_GL_FUNCTIONS(f) \
+    f(void    , glGenFramebuffers        , (int32_t n, uint32_t *framebuffers)) \
+    f(void    , glDeleteFramebuffers     , (int32_t n, const uint32_t *framebuffers)) \
+    f(void    , glBindFramebuffer        , (uint32_t target, uint32_t framebuffer)) \
+    f(void    , glFramebufferRenderbuffer, (uint32_t target, uint32_t attachment, uint32_t renderbuffertarget, uint32_t renderbuffer)) \
+    f(uint32_t, glCheckFramebufferStatus , (uint32_t target)) \
+    f(void    , glGenRenderbuffers       , (int32_t n, uint32_t *renderbuffers)) \
+    f(void    , glDeleteRenderbuffers    , (int32_t n, const uint32_t *renderbuffers)) \
+    f(void    , glBindRenderbuffer       , (uint32_t target, uint32_t renderbuffer)) \
+    f(void    , glRenderbufferStorage    , (uint32_t target, uint32_t internalformat, int32_t width, int32_t height)) \
+    f(void    , glGetIntegerv            , (uint32_t pname, int32_t *data)) \
+    f(void    , glViewport               , (int32_t x, int32_t y, int32_t width, int32_t height)) \
+    f(void    , glFlush                  , (void)) \
+    f(const uint8_t*, glGetString        , (uint32_t name))
+
+/// @brief A framebuffer object that stands in for an EGL surface.
+///
+/// The GL objects are created in the first context that is made current with
+/// the framebuffer, because framebuffer objects are not shared between
+/// contexts. From then on, only that context can be made current with it,
+/// until the context is destroyed.
+struct wegl_fbo {
+    struct wcore_platform *platform;
+    int32_t context_api;
+
+    int32_t width;
+    int32_t height;
+
+    /// @brief The formats that the config asks for. OpenGL ES 2.0 may lack
+    /// them, so wegl_fbo_bind() chooses the formats actually used.
+    uint32_t color_format;
+    uint32_t depth_stencil_format;
+    bool stencil;
+
+    /// @brief The context that owns the GL objects, or null before the first
+    /// bind and after the owner is destroyed.
+    struct wegl_context *owner;
+
+    /// @brief Next framebuffer in wegl_context::fbos of the owner.
+    struct wegl_fbo *next_owned;
+
+    uint32_t framebuffer;
+    uint32_t color_renderbuffer;
+    uint32_t depth_stencil_renderbuffer;
+
+    /// @brief False if the renderbuffers need storage of the current size.
+    bool storage_valid;
+
+    struct {
+#define WEGL_FBO_GL_DECLARE(type, name, params) \
+        type (WAFFLE_GL_APIENTRY *name) params;
+
+        WEGL_FBO_GL_FUNCTIONS(WEGL_FBO_GL_DECLARE)
+
+#undef WEGL_FBO_GL_DECLARE
+    } gl;
+};
+
+struct wegl_fbo*
+wegl_fbo_create(struct wcore_config *wc_config,
+                int32_t width, int32_t height);
+
+/// @brief Delete the GL objects and free @a self.
+///
+/// If the owner is not current, it is made current on this thread for the
+/// deletion and the thread's EGL binding is restored. If the owner is current
+/// on another thread, the GL objects are left to be freed with the owner.
+bool
+wegl_fbo_destroy(struct wegl_fbo *self);
+
+/// @brief Delete the GL objects of each framebuffer that @a ctx owns, as
+/// wegl_fbo_destroy() does, before @a ctx is destroyed.
+bool
+wegl_fbo_release_owner(struct wegl_context *ctx);
+
+/// @brief Check, before binding, that @a ctx may be made current with @a self.
+bool
+wegl_fbo_check_context(struct wegl_fbo *self, struct wegl_context *ctx);
+
+/// @brief Bind @a self as the framebuffer of @a ctx, which must be current.
+bool
+wegl_fbo_bind(struct wegl_fbo *self, struct wegl_context *ctx);
+
+/// @brief Bind the default framebuffer again if @a ctx, which must be
+/// current, has a wegl_fbo bound.
+void
+wegl_fbo_unbind(struct wegl_context *ctx);
+
+bool
+wegl_fbo_resize(struct wegl_fbo *self, int32_t width, int32_t height);
+
+bool
+wegl_fbo_swap_buffers(struct wegl_fbo *self);
@@ -56,6 +56,36 @@ typedef intptr_t EGLAttrib;
 #define EGL_OPENGL_ES3_BIT_KHR                              0x00000040
 #endif
 
+#ifndef EGL_KHR_create_context_no_error
+#define EGL_KHR_create_context_no_error 1
+#define EGL_CONTEXT_OPENGL_NO_ERROR_KHR                     0x31B3
+#endif
+
+#ifndef EGL_KHR_context_flush_control
+#define EGL_KHR_context_flush_control 1
+#define EGL_CONTEXT_RELEASE_BEHAVIOR_NONE_KHR               0
+#define EGL_CONTEXT_RELEASE_BEHAVIOR_KHR                    0x2097
+#define EGL_CONTEXT_RELEASE_BEHAVIOR_FLUSH_KHR              0x2098
+#endif
+
+#ifndef EGL_IMG_context_priority
+#define EGL_IMG_context_priority 1
+#define EGL_CONTEXT_PRIORITY_LEVEL_IMG                      0x3100
+#define EGL_CONTEXT_PRIORITY_HIGH_IMG                       0x3101
+#define EGL_CONTEXT_PRIORITY_MEDIUM_IMG                     0x3102
+#define EGL_CONTEXT_PRIORITY_LOW_IMG                        0x3103
+#endif
+
+#ifndef EGL_NV_context_priority_realtime
+#define EGL_NV_context_priority_realtime 1
+#define EGL_CONTEXT_PRIORITY_REALTIME_NV                    0x3357
+#endif
+
+#ifndef EGL_KHR_no_config_context
+#define EGL_KHR_no_config_context 1
+#define EGL_NO_CONFIG_KHR                                   ((EGLConfig)0)
+#endif
+
 #ifndef EGL_KHR_platform_android
 #define EGL_KHR_platform_android 1
 #define EGL_PLATFORM_ANDROID_KHR          0x3141
@@ -81,3 +111,25 @@ typedef intptr_t EGLAttrib;
 #define EGL_MESA_platform_surfaceless 1
 #define EGL_PLATFORM_SURFACELESS_MESA     0x31DD
 #endif /* EGL_MESA_platform_surfaceless */
+
+#ifndef EGL_EXT_device_base
+#define EGL_EXT_device_base 1
+typedef void *EGLDeviceEXT;
+#define EGL_DEVICE_EXT                    0x322C
+#endif /* EGL_EXT_device_base */
+
+#ifndef EGL_EXT_device_drm
+#define EGL_EXT_device_drm 1
+#define EGL_DRM_DEVICE_FILE_EXT           0x3233
+#endif /* EGL_EXT_device_drm */
+
+#ifndef EGL_KHR_display_reference
+#define EGL_KHR_display_reference 1
+#define EGL_TRACK_REFERENCES_KHR          0x3352
+#endif /* EGL_KHR_display_reference */
+
+#ifndef EGL_EXT_pixel_format_float
+#define EGL_EXT_pixel_format_float 1
+#define EGL_COLOR_COMPONENT_TYPE_EXT        0x3339
+#define EGL_COLOR_COMPONENT_TYPE_FIXED_EXT  0x333A
+#endif /* EGL_EXT_pixel_format_float */
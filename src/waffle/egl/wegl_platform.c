@@ -28,6 +28,7 @@
 #include <dlfcn.h>
 
 #include "wcore_error.h"
+#include "wcore_time.h"
 #include "wegl_platform.h"
 
 
@@ -85,6 +86,8 @@ wegl_platform_teardown(struct wegl_platform *self)
         }
     }
 
+    wcore_ext_set_teardown(&self->client_extensions);
+    wcore_sym_cache_teardown(&self->proc_cache);
     ok &= wcore_platform_teardown(&self->wcore);
     return ok;
 }
@@ -92,18 +95,26 @@ wegl_platform_teardown(struct wegl_platform *self)
 bool
 wegl_platform_init(struct wegl_platform *self, EGLenum egl_platform)
 {
+    uint64_t t0, t1;
     bool ok;
 
     ok = wcore_platform_init(&self->wcore);
     if (!ok)
         goto error;
 
+    ok = wcore_sym_cache_init(&self->proc_cache);
+    if (!ok)
+        goto error;
+
     self->egl_platform = egl_platform;
 
     // Most Waffle platforms will call eglCreateWindowSurface.
     self->egl_surface_type_mask = EGL_WINDOW_BIT;
 
+    t0 = wcore_time_ns();
     self->eglHandle = dlopen(libEGL_filename, RTLD_LAZY | RTLD_LOCAL);
+    t1 = wcore_time_ns();
+    self->wcore.init_time.dl_open += t1 - t0;
     if (!self->eglHandle) {
         wcore_errorf(WAFFLE_ERROR_FATAL,
                      "dlopen(\"%s\") failed: %s",
@@ -142,6 +153,10 @@ wegl_platform_init(struct wegl_platform *self, EGLenum egl_platform)
     self->function = (void*) self->eglGetProcAddress(#function);
 
     RETRIEVE_EGL_SYMBOL(eglMakeCurrent);
+    RETRIEVE_EGL_SYMBOL(eglReleaseThread);
+    RETRIEVE_EGL_SYMBOL(eglGetCurrentDisplay);
+    RETRIEVE_EGL_SYMBOL(eglGetCurrentSurface);
+    RETRIEVE_EGL_SYMBOL(eglGetCurrentContext);
     RETRIEVE_EGL_SYMBOL(eglGetProcAddress);
 
     // display
@@ -152,12 +167,13 @@ wegl_platform_init(struct wegl_platform *self, EGLenum egl_platform)
     RETRIEVE_EGL_SYMBOL(eglTerminate);
 
     // config
-    RETRIEVE_EGL_SYMBOL(eglChooseConfig);
+    RETRIEVE_EGL_SYMBOL(eglGetConfigs);
 
     // context
     RETRIEVE_EGL_SYMBOL(eglBindAPI);
     RETRIEVE_EGL_SYMBOL(eglCreateContext);
     RETRIEVE_EGL_SYMBOL(eglDestroyContext);
+    RETRIEVE_EGL_SYMBOL(eglQueryContext);
 
     // window
     RETRIEVE_EGL_SYMBOL(eglGetConfigAttrib);
@@ -176,11 +192,29 @@ wegl_platform_init(struct wegl_platform *self, EGLenum egl_platform)
     RETRIEVE_EGL_SYMBOL_OPTIONAL(eglQueryDmaBufFormatsEXT);
     RETRIEVE_EGL_SYMBOL_OPTIONAL(eglQueryDmaBufModifiersEXT);
 
+    // EGL_MESA_query_driver
+    RETRIEVE_EGL_SYMBOL_OPTIONAL(eglGetDisplayDriverName);
+
+    // EGL_EXT_device_query
+    RETRIEVE_EGL_SYMBOL_OPTIONAL(eglQueryDisplayAttribEXT);
+    RETRIEVE_EGL_SYMBOL_OPTIONAL(eglQueryDeviceStringEXT);
+
 #undef RETRIEVE_EGL_SYMBOL
 #undef RETRIEVE_EGL_SYMBOL_OPTIONAL
 
-    self->client_extensions =
-        self->eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    // Without EGL_EXT_client_extensions, the query fails and the set is
+    // empty.
+    ok = wcore_ext_set_init(&self->client_extensions,
+                            self->eglQueryString(EGL_NO_DISPLAY,
+                                                 EGL_EXTENSIONS));
+    if (!ok)
+        goto error;
+
+    self->wcore.init_time.dl_sym += wcore_time_ns() - t1;
+
+    self->wcore.get_proc_address_has_core =
+        wcore_ext_set_has(&self->client_extensions,
+                          "EGL_KHR_client_get_all_proc_addresses");
 
     if (!wegl_platform_can_use_eglGetPlatformDisplay(self) &&
         !wegl_platform_can_use_eglGetPlatformDisplayEXT(self)) {
@@ -222,7 +256,7 @@ wegl_platform_can_use_eglGetPlatformDisplay(const struct wegl_platform *plat)
             return false;
     }
 
-    return waffle_is_extension_in_string(plat->client_extensions, ext);
+    return wcore_ext_set_has(&plat->client_extensions, ext);
 }
 
 bool
@@ -254,5 +288,5 @@ wegl_platform_can_use_eglGetPlatformDisplayEXT(const struct wegl_platform *plat)
             return false;
     }
 
-    return waffle_is_extension_in_string(plat->client_extensions, ext);
+    return wcore_ext_set_has(&plat->client_extensions, ext);
 }
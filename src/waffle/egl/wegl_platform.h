@@ -27,7 +27,9 @@
 
 #include <EGL/egl.h>
 
+#include "wcore_ext_set.h"
 #include "wcore_platform.h"
+#include "wcore_sym_cache.h"
 #include "wcore_util.h"
 
 #include "wegl_imports.h"
@@ -40,8 +42,8 @@ struct wegl_platform {
 
     /// @brief Value of EGLConfig attribute EGL_SURFACE_TYPE
     ///
-    /// When calling eglChooseConfig, Waffle sets the EGL_SURFACE_TYPE attribute
-    /// to this value.  Since most Waffle EGL platforms call
+    /// When choosing a config, Waffle requires that its EGL_SURFACE_TYPE
+    /// contain all bits of this value.  Since most Waffle EGL platforms call
     /// eglCreatePlatformWindowSurface() from waffle_window_create(),
     /// wegl_platform_init() initializes this to EGL_WINDOW_BIT.
     ///
@@ -49,14 +51,24 @@ struct wegl_platform {
     /// namely, Mesa's "surfaceless" platform.
     EGLint egl_surface_type_mask;
 
+    /// @brief Results of eglGetProcAddress().
+    ///
+    /// EGL 1.5 requires that eglGetProcAddress() return context-independent
+    /// addresses, so they are safe to reuse for the lifetime of the platform.
+    struct wcore_sym_cache proc_cache;
+
     // EGL function pointers
     void *eglHandle;
 
     // See https://www.khronos.org/registry/egl/extensions/EXT/EGL_EXT_client_extensions.txt
-    const char *client_extensions;
+    struct wcore_ext_set client_extensions;
 
     EGLBoolean (*eglMakeCurrent)(EGLDisplay dpy, EGLSurface draw,
                                  EGLSurface read, EGLContext ctx);
+    EGLBoolean (*eglReleaseThread)(void);
+    EGLDisplay (*eglGetCurrentDisplay)(void);
+    EGLSurface (*eglGetCurrentSurface)(EGLint readdraw);
+    EGLContext (*eglGetCurrentContext)(void);
     __eglMustCastToProperFunctionPointerType
        (*eglGetProcAddress)(const char *procname);
 
@@ -72,9 +84,8 @@ struct wegl_platform {
     EGLBoolean (*eglTerminate)(EGLDisplay dpy);
 
     // config
-    EGLBoolean (*eglChooseConfig)(EGLDisplay dpy, const EGLint *attrib_list,
-                                  EGLConfig *configs, EGLint config_size,
-                                  EGLint *num_config);
+    EGLBoolean (*eglGetConfigs)(EGLDisplay dpy, EGLConfig *configs,
+                                EGLint config_size, EGLint *num_config);
 
     // context
     EGLBoolean (*eglBindAPI)(EGLenum api);
@@ -82,6 +93,8 @@ struct wegl_platform {
                                    EGLContext share_context,
                                    const EGLint *attrib_list);
     EGLBoolean (*eglDestroyContext)(EGLDisplay dpy, EGLContext ctx);
+    EGLBoolean (*eglQueryContext)(EGLDisplay dpy, EGLContext ctx,
+                                  EGLint attribute, EGLint *value);
 
     // window
     EGLBoolean (*eglGetConfigAttrib)(EGLDisplay dpy, EGLConfig config,
@@ -108,6 +121,14 @@ struct wegl_platform {
                                              EGLuint64KHR *modifiers,
                                              EGLBoolean *external_only,
                                              EGLint *num_modifiers);
+
+    // EGL_MESA_query_driver
+    const char *(*eglGetDisplayDriverName)(EGLDisplay dpy);
+
+    // EGL_EXT_device_query
+    EGLBoolean (*eglQueryDisplayAttribEXT)(EGLDisplay dpy, EGLint attribute,
+                                           EGLAttrib *value);
+    const char *(*eglQueryDeviceStringEXT)(EGLDeviceEXT device, EGLint name);
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_platform,
@@ -23,8 +23,15 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <assert.h>
+
+#include "wcore_error.h"
+#include "wcore_tinfo.h"
+
 #include "wegl_config.h"
+#include "wegl_context.h"
 #include "wegl_display.h"
+#include "wegl_fbo.h"
 #include "wegl_imports.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
@@ -73,14 +80,34 @@ fail:
     return false;
 }
 
+static EGLSurface
+create_pbuffer(struct wcore_config *wc_config, int32_t width, int32_t height)
+{
+    struct wegl_config *config = wegl_config(wc_config);
+    struct wegl_display *dpy = wegl_display(wc_config->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLSurface surface;
+
+    EGLint attrib_list[] = {
+        EGL_WIDTH, width,
+        EGL_HEIGHT, height,
+        EGL_NONE,
+    };
+
+    surface = plat->eglCreatePbufferSurface(dpy->egl, config->egl,
+                                            attrib_list);
+    if (!surface)
+        wegl_emit_error(plat, "eglCreatePbufferSurface");
+
+    return surface;
+}
+
 bool
 wegl_pbuffer_init(struct wegl_surface *surf,
                   struct wcore_config *wc_config,
                   int32_t width, int32_t height)
 {
     struct wegl_config *config = wegl_config(wc_config);
-    struct wegl_display *dpy = wegl_display(wc_config->display);
-    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
     bool ok;
 
     ok = wcore_window_init(&surf->wcore, wc_config);
@@ -95,18 +122,32 @@ wegl_pbuffer_init(struct wegl_surface *surf,
     // pbuffers even if the user requested double-buffering.
     (void) config->wcore.attrs.double_buffered;
 
-    EGLint attrib_list[] = {
-        EGL_WIDTH, width,
-        EGL_HEIGHT, height,
-        EGL_NONE,
-    };
+    surf->egl = create_pbuffer(wc_config, width, height);
+    if (!surf->egl)
+        goto fail;
 
-    surf->egl = plat->eglCreatePbufferSurface(dpy->egl, config->egl,
-                                              attrib_list);
-    if (!surf->egl) {
-        wegl_emit_error(plat, "eglCreatePbufferSurface");
+    return true;
+
+fail:
+    wegl_surface_teardown(surf);
+    return false;
+}
+
+bool
+wegl_fbo_surface_init(struct wegl_surface *surf,
+                      struct wcore_config *wc_config,
+                      int32_t width, int32_t height)
+{
+    bool ok;
+
+    ok = wcore_window_init(&surf->wcore, wc_config);
+    if (!ok)
+        goto fail;
+
+    surf->egl = EGL_NO_SURFACE;
+    surf->fbo = wegl_fbo_create(wc_config, width, height);
+    if (!surf->fbo)
         goto fail;
-    }
 
     return true;
 
@@ -115,6 +156,115 @@ fail:
     return false;
 }
 
+bool
+wegl_window_parse_attrib_list(const intptr_t attrib_list[],
+                              bool *offscreen,
+                              bool *fbo)
+{
+    *offscreen = false;
+    *fbo = false;
+
+    for (size_t i = 0; attrib_list && attrib_list[i]; i += 2) {
+        intptr_t key = attrib_list[i];
+        intptr_t value = attrib_list[i + 1];
+
+        if (key != WAFFLE_WINDOW_OFFSCREEN && key != WAFFLE_WINDOW_FBO) {
+            wcore_error_bad_attribute(key);
+            return false;
+        }
+
+        if (value != true && value != false) {
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "%s has bad value 0x%lx. "
+                         "Must be true(1) or false(0)",
+                         wcore_enum_to_string(key), (long)value);
+            return false;
+        }
+
+        if (key == WAFFLE_WINDOW_OFFSCREEN)
+            *offscreen = value;
+        else
+            *fbo = value;
+    }
+
+    *offscreen |= *fbo;
+    return true;
+}
+
+bool
+wegl_offscreen_init(struct wegl_surface *surf,
+                    struct wcore_config *wc_config,
+                    int32_t width, int32_t height,
+                    bool fbo)
+{
+    struct wegl_config *config = wegl_config(wc_config);
+    struct wegl_display *dpy = wegl_display(wc_config->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLint surface_type = 0;
+    bool ok;
+
+    if (width == -1 && height == -1) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "fullscreen offscreen window not supported");
+        return false;
+    }
+
+    // Configs chosen for native windows may lack EGL_PBUFFER_BIT. Mesa's gbm
+    // and wayland platforms, for example, have no pbuffers at all.
+    if (!fbo) {
+        plat->eglGetConfigAttrib(dpy->egl, config->egl, EGL_SURFACE_TYPE,
+                                 &surface_type);
+        fbo = !(surface_type & EGL_PBUFFER_BIT);
+    }
+
+    if (fbo)
+        ok = wegl_fbo_surface_init(surf, wc_config, width, height);
+    else
+        ok = wegl_pbuffer_init(surf, wc_config, width, height);
+    if (!ok)
+        return false;
+
+    surf->offscreen = true;
+    surf->config = wc_config;
+    return true;
+}
+
+bool
+wegl_offscreen_resize(struct wegl_surface *surf,
+                      int32_t width, int32_t height)
+{
+    struct wegl_display *dpy = wegl_display(surf->wcore.display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    struct wcore_tinfo *tinfo = wcore_tinfo_get();
+    EGLSurface new_egl;
+
+    assert(surf->offscreen);
+
+    if (surf->fbo)
+        return wegl_fbo_resize(surf->fbo, width, height);
+
+    // Pbuffers have a fixed size, so replace it.
+    new_egl = create_pbuffer(surf->config, width, height);
+    if (!new_egl)
+        return false;
+
+    if (tinfo->current_window == &surf->wcore && tinfo->current_context) {
+        struct wegl_context *ctx = wegl_context(tinfo->current_context);
+
+        if (!plat->eglMakeCurrent(dpy->egl, new_egl, new_egl, ctx->egl)) {
+            wegl_emit_error(plat, "eglMakeCurrent");
+            plat->eglDestroySurface(dpy->egl, new_egl);
+            return false;
+        }
+    }
+
+    if (!plat->eglDestroySurface(dpy->egl, surf->egl))
+        wegl_emit_error(plat, "eglDestroySurface");
+
+    surf->egl = new_egl;
+    return true;
+}
+
 bool
 wegl_surface_teardown(struct wegl_surface *surf)
 {
@@ -122,6 +272,11 @@ wegl_surface_teardown(struct wegl_surface *surf)
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
     bool result = true;
 
+    if (surf->fbo) {
+        result &= wegl_fbo_destroy(surf->fbo);
+        surf->fbo = NULL;
+    }
+
     if (surf->egl) {
         bool ok = plat->eglDestroySurface(dpy->egl, surf->egl);
         if (!ok) {
@@ -141,6 +296,9 @@ wegl_surface_swap_buffers(struct wcore_window *wc_window)
     struct wegl_display *dpy = wegl_display(surf->wcore.display);
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
 
+    if (surf->fbo)
+        return wegl_fbo_swap_buffers(surf->fbo);
+
     bool ok = plat->eglSwapBuffers(dpy->egl, surf->egl);
     if (!ok)
         wegl_emit_error(plat, "eglSwapBuffers");
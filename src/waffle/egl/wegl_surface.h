@@ -34,10 +34,20 @@
 
 struct wegl_config;
 struct wegl_display;
+struct wegl_fbo;
 
 struct wegl_surface {
     struct wcore_window wcore;
     EGLSurface egl;
+
+    /// @brief Set, and `egl` is EGL_NO_SURFACE, for framebuffer object
+    /// windows.
+    struct wegl_fbo *fbo;
+
+    /// @brief Set for pbuffer and framebuffer object windows, which have no
+    /// native window.
+    bool offscreen;
+    struct wcore_config *config;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_surface,
@@ -55,6 +65,37 @@ wegl_pbuffer_init(struct wegl_surface *surf,
                   struct wcore_config *wc_config,
                   int32_t width, int32_t height);
 
+/// @brief Init a window that renders to a framebuffer object managed by
+/// waffle, with no EGL surface. Requires EGL_KHR_surfaceless_context.
+bool
+wegl_fbo_surface_init(struct wegl_surface *surf,
+                      struct wcore_config *wc_config,
+                      int32_t width, int32_t height);
+
+/// @brief Parse the waffle_window_create2() attributes that every EGL
+/// platform handles, and reject all others.
+///
+/// WAFFLE_WINDOW_FBO implies WAFFLE_WINDOW_OFFSCREEN.
+bool
+wegl_window_parse_attrib_list(const intptr_t attrib_list[],
+                              bool *offscreen,
+                              bool *fbo);
+
+/// @brief Init a window with no native window.
+///
+/// Unless @a fbo, the window is a pbuffer if the config supports them and a
+/// framebuffer object otherwise.
+bool
+wegl_offscreen_init(struct wegl_surface *surf,
+                    struct wcore_config *wc_config,
+                    int32_t width, int32_t height,
+                    bool fbo);
+
+/// @brief Resize a window made by wegl_offscreen_init().
+bool
+wegl_offscreen_resize(struct wegl_surface *surf,
+                      int32_t width, int32_t height);
+
 bool
 wegl_surface_teardown(struct wegl_surface *surf);
 
@@ -27,6 +27,7 @@
 
 #include "wegl_context.h"
 #include "wegl_display.h"
+#include "wegl_fbo.h"
 #include "wegl_imports.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
@@ -76,24 +77,49 @@ wegl_make_current(struct wcore_platform *wc_plat,
                   struct wcore_context *wc_ctx)
 {
     struct wegl_platform *plat = wegl_platform(wc_plat);
-    EGLSurface surface = wc_window ? wegl_surface(wc_window)->egl : NULL;
+    struct wegl_surface *surf = wc_window ? wegl_surface(wc_window) : NULL;
+    struct wegl_context *ctx = wc_ctx ? wegl_context(wc_ctx) : NULL;
+    EGLSurface surface = surf ? surf->egl : NULL;
     bool ok;
 
+    if (surf && surf->fbo && !wegl_fbo_check_context(surf->fbo, ctx))
+        return false;
+
     ok = plat->eglMakeCurrent(wegl_display(wc_dpy)->egl,
                               surface,
                               surface,
-                              wc_ctx
-                                  ? wegl_context(wc_ctx)->egl
-                                  : NULL);
-    if (!ok)
+                              ctx ? ctx->egl : NULL);
+    if (!ok) {
         wegl_emit_error(plat, "eglMakeCurrent");
+        return false;
+    }
+
+    if (!ctx)
+        return true;
 
-    return ok;
+    if (surf && surf->fbo)
+        return wegl_fbo_bind(surf->fbo, ctx);
+
+    wegl_fbo_unbind(ctx);
+    return true;
+}
+
+void
+wegl_release_thread(struct wcore_platform *wc_plat)
+{
+    wegl_platform(wc_plat)->eglReleaseThread();
 }
 
 void*
 wegl_get_proc_address(struct wcore_platform *wc_self, const char *name)
 {
     struct wegl_platform *self = wegl_platform(wc_self);
-    return self->eglGetProcAddress(name);
+    void *sym = wcore_sym_cache_get(&self->proc_cache, name);
+
+    if (!sym) {
+        sym = self->eglGetProcAddress(name);
+        wcore_sym_cache_put(&self->proc_cache, name, sym);
+    }
+
+    return sym;
 }
@@ -33,11 +33,139 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include "threads.h"
+
 #include "wcore_error.h"
 
 #include "wgbm_display.h"
 #include "wgbm_platform.h"
 
+/// @brief A GBM device shared by every display on one DRM device, so that
+/// connecting again reuses it and, through it, the initialized EGLDisplay.
+struct wgbm_shared_device {
+    struct wgbm_shared_device *next;
+
+    /// @brief The key. gbm_create_device identifies the GBM library.
+    void *gbm_create_device;
+    dev_t rdev;
+
+    struct gbm_device *gbm_device;
+    int refcount;
+};
+
+static struct wgbm_shared_device *shared_devices;
+static mtx_t shared_mutex;
+static once_flag shared_once = ONCE_FLAG_INIT;
+static bool shared_init_ok;
+
+static void
+shared_init_once(void)
+{
+    shared_init_ok = mtx_init(&shared_mutex, mtx_plain) == thrd_success;
+}
+
+/// @brief Set the display's gbm_device, reusing a shared one if any.
+///
+/// Take ownership of @a fd.
+static bool
+wgbm_display_open_device(struct wgbm_display *self,
+                         struct wgbm_platform *plat,
+                         int fd)
+{
+    struct wgbm_shared_device *shared;
+    struct stat st;
+
+    // Without the device number, do not share.
+    if (fstat(fd, &st) != 0) {
+        self->gbm_device = plat->gbm_create_device(fd);
+        if (!self->gbm_device) {
+            close(fd);
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_create_device failed");
+            return false;
+        }
+        return true;
+    }
+
+    call_once(&shared_once, shared_init_once);
+    if (!shared_init_ok) {
+        close(fd);
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        return false;
+    }
+
+    mtx_lock(&shared_mutex);
+
+    for (shared = shared_devices; shared; shared = shared->next) {
+        if (shared->gbm_create_device == (void*) plat->gbm_create_device &&
+            shared->rdev == st.st_rdev)
+            break;
+    }
+
+    if (shared) {
+        close(fd);
+        shared->refcount++;
+    } else {
+        shared = wcore_calloc(sizeof(*shared));
+        if (!shared)
+            goto fail;
+
+        shared->gbm_device = plat->gbm_create_device(fd);
+        if (!shared->gbm_device) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_create_device failed");
+            free(shared);
+            goto fail;
+        }
+
+        shared->gbm_create_device = (void*) plat->gbm_create_device;
+        shared->rdev = st.st_rdev;
+        shared->refcount = 1;
+        shared->next = shared_devices;
+        shared_devices = shared;
+    }
+
+    mtx_unlock(&shared_mutex);
+
+    self->gbm_device = shared->gbm_device;
+    self->shared = shared;
+    return true;
+
+fail:
+    mtx_unlock(&shared_mutex);
+    close(fd);
+    return false;
+}
+
+/// @brief Drop the display's reference to its gbm_device.
+///
+/// Return true if the caller must destroy the device.
+static bool
+wgbm_display_release_device(struct wgbm_display *self)
+{
+    struct wgbm_shared_device *shared = self->shared;
+    struct wgbm_shared_device **p;
+    bool last;
+
+    if (!shared)
+        return true;
+
+    mtx_lock(&shared_mutex);
+
+    last = --shared->refcount == 0;
+    if (last) {
+        for (p = &shared_devices; *p != shared; p = &(*p)->next)
+            ;
+        *p = shared->next;
+    }
+
+    mtx_unlock(&shared_mutex);
+
+    self->shared = NULL;
+    if (last)
+        free(shared);
+
+    return last;
+}
+
 bool
 wgbm_display_destroy(struct wcore_display *wc_self)
 {
@@ -53,7 +181,7 @@ wgbm_display_destroy(struct wcore_display *wc_self)
 
     ok &= wegl_display_teardown(&self->wegl);
 
-    if (self->gbm_device) {
+    if (self->gbm_device && wgbm_display_release_device(self)) {
         fd = plat->gbm_device_get_fd(self->gbm_device);
         plat->gbm_device_destroy(self->gbm_device);
         close(fd);
@@ -132,11 +260,9 @@ wgbm_display_connect(struct wcore_platform *wc_plat,
         }
     }
 
-    self->gbm_device = plat->gbm_create_device(fd);
-    if (!self->gbm_device) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_create_device failed");
+    ok = wgbm_display_open_device(self, plat, fd);
+    if (!ok)
         goto error;
-    }
 
     ok = wegl_display_init(&self->wegl, wc_plat, self->gbm_device);
     if (!ok)
@@ -34,9 +34,15 @@
 
 struct wcore_platform;
 struct gbm_device;
+struct wgbm_shared_device;
 
 struct wgbm_display {
     struct gbm_device *gbm_device;
+
+    /// @brief The process-wide owner of `gbm_device`. Null if the device
+    /// could not be identified, in which case the display owns it.
+    struct wgbm_shared_device *shared;
+
     struct wegl_display wegl;
 };
 
@@ -27,6 +27,7 @@
 #include <dlfcn.h>
 
 #include "wcore_error.h"
+#include "wcore_time.h"
 
 #include "linux_platform.h"
 
@@ -97,13 +98,17 @@ wgbm_platform_destroy(struct wcore_platform *wc_self)
 bool
 wgbm_platform_init(struct wgbm_platform *self)
 {
+    uint64_t t0, t1;
     bool ok = true;
 
     ok = wegl_platform_init(&self->wegl, EGL_PLATFORM_GBM_KHR);
     if (!ok)
         goto error;
 
+    t0 = wcore_time_ns();
     self->gbmHandle = dlopen(libgbm_filename, RTLD_LAZY | RTLD_LOCAL);
+    t1 = wcore_time_ns();
+    self->wegl.wcore.init_time.dl_open += t1 - t0;
     if (!self->gbmHandle) {
         wcore_errorf(WAFFLE_ERROR_FATAL,
                      "dlopen(\"%s\") failed: %s",
@@ -123,7 +128,12 @@ wgbm_platform_init(struct wgbm_platform *self)
     GBM_FUNCTIONS(RETRIEVE_GBM_SYMBOL);
 #undef RETRIEVE_GBM_SYMBOL
 
+    t0 = wcore_time_ns();
+    self->wegl.wcore.init_time.dl_sym += t0 - t1;
+
     self->drm.handle = dlopen(libdrm_filename, RTLD_LAZY | RTLD_LOCAL);
+    t1 = wcore_time_ns();
+    self->wegl.wcore.init_time.dl_open += t1 - t0;
     if (!self->drm.handle) {
         wcore_errorf(WAFFLE_ERROR_FATAL,
                      "dlopen(\"%s\") failed: %s",
@@ -144,7 +154,9 @@ wgbm_platform_init(struct wgbm_platform *self)
     RETRIEVE_DRM_SYMBOL(FreeDevices);
 #undef RETRIEVE_DRM_SYMBOL
 
-    self->linux = linux_platform_create();
+    self->wegl.wcore.init_time.dl_sym += wcore_time_ns() - t1;
+
+    self->linux = linux_platform_create(true);
     if (!self->linux)
         goto error;
 
@@ -209,6 +221,7 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
     .destroy = wgbm_platform_destroy,
 
     .make_current = wegl_make_current,
+    .release_thread = wegl_release_thread,
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = wgbm_dl_can_open,
     .dl_sym = wgbm_dl_sym,
@@ -218,10 +231,12 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
         .destroy = wgbm_display_destroy,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = wgbm_display_get_native,
+        .get_capabilities = wegl_display_get_capabilities,
     },
 
     .config = {
         .choose = wegl_config_choose,
+        .enumerate = wegl_config_enumerate,
         .destroy = wegl_config_destroy,
         .get_native = wgbm_config_get_native,
     },
@@ -230,6 +245,7 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
         .create = wegl_context_create,
         .destroy = wegl_context_destroy,
         .get_native = wgbm_context_get_native,
+        .get_priority = wegl_context_get_priority,
     },
 
     .window = {
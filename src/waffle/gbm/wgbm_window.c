@@ -30,7 +30,6 @@
 
 #include "waffle_gbm.h"
 
-#include "wcore_attrib_list.h"
 #include "wcore_error.h"
 #include "wcore_tinfo.h"
 
@@ -50,7 +49,8 @@ wgbm_window_teardown(struct wgbm_window *self)
     bool ok;
 
     ok = wegl_surface_teardown(&self->wegl);
-    plat->gbm_surface_destroy(self->gbm_surface);
+    if (self->gbm_surface)
+        plat->gbm_surface_destroy(self->gbm_surface);
 
     return ok;
 }
@@ -141,6 +141,7 @@ wgbm_window_create(struct wcore_platform *wc_plat,
                    const intptr_t attrib_list[])
 {
     struct wgbm_window *self;
+    bool offscreen, fbo;
     bool ok = true;
 
     if (width == -1 && height == -1) {
@@ -149,16 +150,17 @@ wgbm_window_create(struct wcore_platform *wc_plat,
         return NULL;
     }
 
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
+    if (!wegl_window_parse_attrib_list(attrib_list, &offscreen, &fbo))
         return NULL;
-    }
 
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
-    ok = wgbm_window_init(self, wc_plat, wc_config, width, height);
+    if (offscreen)
+        ok = wegl_offscreen_init(&self->wegl, wc_config, width, height, fbo);
+    else
+        ok = wgbm_window_init(self, wc_plat, wc_config, width, height);
     if (!ok) {
         free(self);
         return NULL;
@@ -185,6 +187,9 @@ wgbm_window_swap_buffers(struct wcore_window *wc_self)
         return false;
 
     struct wgbm_window *self = wgbm_window(wc_self);
+    if (self->wegl.offscreen)
+        return true;
+
     struct gbm_bo *bo = plat->gbm_surface_lock_front_buffer(self->gbm_surface);
     if (!bo)
         return false;
@@ -205,6 +210,9 @@ wgbm_window_resize(struct wcore_window *wc_self,
     struct wcore_tinfo *tinfo;
     bool ok = true;
 
+    if (self->wegl.offscreen)
+        return wegl_offscreen_resize(&self->wegl, width, height);
+
     // Backup the old window/surface so that we can restore it upon failure.
     backup_self = *self;
 
@@ -23,12 +23,14 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "linux_platform.h"
 
 #include "wcore_config_attrs.h"
+#include "wcore_config_table.h"
 #include "wcore_error.h"
 
 #include "glx_config.h"
@@ -37,6 +39,8 @@
 #include "glx_platform.h"
 #include "glx_wrappers.h"
 
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
 bool
 glx_config_destroy(struct wcore_config *wc_self)
 {
@@ -61,6 +65,8 @@ glx_config_check_context_attrs(struct glx_display *dpy,
         const char *fwd_compat = "";
         const char *debug = "";
         const char *robust = "";
+        const char *no_error = "";
+        const char *release = "";
 
         // XXX: Keep in sync with glx_context_needs_arb_create_context()
         if (attrs->context_api != WAFFLE_CONTEXT_OPENGL)
@@ -77,9 +83,16 @@ glx_config_check_context_attrs(struct glx_display *dpy,
         if (attrs->context_robust)
             robust = " - a robust access context\n";
 
+        if (attrs->context_no_error)
+            no_error = " - a no error context\n";
+
+        if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE)
+            release = " - a context that is not flushed on release\n";
+
         wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
                      "GLX_ARB_create_context is required to create:\n"
-                     "%s%s%s%s", gl, fwd_compat, debug, robust);
+                     "%s%s%s%s%s%s", gl, fwd_compat, debug, robust, no_error,
+                     release);
         return false;
     }
 
@@ -90,6 +103,33 @@ glx_config_check_context_attrs(struct glx_display *dpy,
         return false;
     }
 
+    if (attrs->context_no_error && !dpy->ARB_create_context_no_error) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX_ARB_create_context_no_error is required to "
+                     "request a no error context");
+        return false;
+    }
+
+    if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE &&
+        !dpy->ARB_context_flush_control) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX_ARB_context_flush_control is required to "
+                     "request a context that is not flushed on release");
+        return false;
+    }
+
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX does not support context priorities");
+        return false;
+    }
+
+    if (attrs->context_no_config) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX does not support contexts without a config");
+        return false;
+    }
+
     switch (attrs->context_api) {
         case WAFFLE_CONTEXT_OPENGL:
             if (wcore_config_attrs_version_ge(attrs, 32) && !dpy->ARB_create_context_profile) {
@@ -121,112 +161,284 @@ glx_config_check_context_attrs(struct glx_display *dpy,
     }
 }
 
-struct wcore_config*
-glx_config_choose(struct wcore_platform *wc_plat,
-                  struct wcore_display *wc_dpy,
-                  const struct wcore_config_attrs *attrs)
+struct glx_fbconfig_attribs {
+    int red_size;
+    int green_size;
+    int blue_size;
+    int alpha_size;
+    int buffer_size;
+    int depth_size;
+    int stencil_size;
+    int sample_buffers;
+    int samples;
+    int doublebuffer;
+    int stereo;
+    int accum_red_size;
+    int accum_green_size;
+    int accum_blue_size;
+    int accum_alpha_size;
+    int caveat;
+    int render_type;
+    int drawable_type;
+    int transparent_type;
+    int level;
+    int fbconfig_id;
+    int visual_id;
+};
+
+static const struct {
+    int name;
+    size_t offset;
+} glx_fbconfig_attrib_list[] = {
+#define ATTRIB(name, field) { name, offsetof(struct glx_fbconfig_attribs, field) }
+    ATTRIB(GLX_RED_SIZE,            red_size),
+    ATTRIB(GLX_GREEN_SIZE,          green_size),
+    ATTRIB(GLX_BLUE_SIZE,           blue_size),
+    ATTRIB(GLX_ALPHA_SIZE,          alpha_size),
+    ATTRIB(GLX_BUFFER_SIZE,         buffer_size),
+    ATTRIB(GLX_DEPTH_SIZE,          depth_size),
+    ATTRIB(GLX_STENCIL_SIZE,        stencil_size),
+    ATTRIB(GLX_SAMPLE_BUFFERS,      sample_buffers),
+    ATTRIB(GLX_SAMPLES,             samples),
+    ATTRIB(GLX_DOUBLEBUFFER,        doublebuffer),
+    ATTRIB(GLX_STEREO,              stereo),
+    ATTRIB(GLX_ACCUM_RED_SIZE,      accum_red_size),
+    ATTRIB(GLX_ACCUM_GREEN_SIZE,    accum_green_size),
+    ATTRIB(GLX_ACCUM_BLUE_SIZE,     accum_blue_size),
+    ATTRIB(GLX_ACCUM_ALPHA_SIZE,    accum_alpha_size),
+    ATTRIB(GLX_CONFIG_CAVEAT,       caveat),
+    ATTRIB(GLX_RENDER_TYPE,         render_type),
+    ATTRIB(GLX_DRAWABLE_TYPE,       drawable_type),
+    ATTRIB(GLX_TRANSPARENT_TYPE,    transparent_type),
+    ATTRIB(GLX_LEVEL,               level),
+    ATTRIB(GLX_FBCONFIG_ID,         fbconfig_id),
+    ATTRIB(GLX_VISUAL_ID,           visual_id),
+#undef ATTRIB
+};
+
+static int
+min_int(int a, int b)
 {
-    struct glx_config *self;
-    struct glx_display *dpy = glx_display(wc_dpy);
-    struct glx_platform *plat = glx_platform(wc_plat);
+    return a < b ? a : b;
+}
 
-    GLXFBConfig *configs = NULL;
+/// @brief Create the table of all GLXFBConfigs that Waffle can choose.
+///
+/// Drop the configs that glXChooseFBConfig() would reject for every request
+/// Waffle makes: those that are not RGBA, that cannot draw to a window or
+/// lack a visual, that are transparent, overlaid, or stereo.
+static struct wcore_config_table*
+create_config_table(struct wcore_display *wc_dpy)
+{
+    struct glx_display *dpy = glx_display(wc_dpy);
+    struct glx_platform *plat = glx_platform(wc_dpy->platform);
+    struct wcore_config_table *table = NULL;
+    GLXFBConfig *configs;
     int num_configs = 0;
-    XVisualInfo *vi = NULL;
 
-    bool ok = true;
-
-    if (!glx_config_check_context_attrs(dpy, attrs))
+    configs = wrapped_glXGetFBConfigs(plat, dpy->x11.xlib, dpy->x11.screen,
+                                      &num_configs);
+    if (!configs) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glXGetFBConfigs failed");
         return NULL;
+    }
+
+    table = wcore_config_table_create(num_configs);
+    if (!table)
+        goto cleanup;
+
+    // GLX sorts deeper depth buffers first.
+    table->prefer_larger_depth = true;
+
+    for (int i = 0; i < num_configs; ++i) {
+        struct glx_fbconfig_attribs a;
+        int n;
+
+        for (size_t k = 0; k < ARRAY_SIZE(glx_fbconfig_attrib_list); ++k) {
+            int *value = (int*) ((char*) &a +
+                                 glx_fbconfig_attrib_list[k].offset);
+
+            if (wrapped_glXGetFBConfigAttrib(plat, dpy->x11.xlib, configs[i],
+                                             glx_fbconfig_attrib_list[k].name,
+                                             value)) {
+                wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                             "glXGetFBConfigAttrib failed");
+                wcore_config_table_destroy(table);
+                table = NULL;
+                goto cleanup;
+            }
+        }
+
+        if (!(a.render_type & GLX_RGBA_BIT) ||
+            !(a.drawable_type & GLX_WINDOW_BIT) ||
+            a.visual_id == 0 ||
+            a.transparent_type != GLX_NONE ||
+            a.level != 0 ||
+            a.stereo)
+            continue;
+
+        n = table->count++;
+        table->red_size[n] = a.red_size;
+        table->green_size[n] = a.green_size;
+        table->blue_size[n] = a.blue_size;
+        table->alpha_size[n] = a.alpha_size;
+        table->buffer_size[n] = a.buffer_size;
+        table->depth_size[n] = a.depth_size;
+        table->stencil_size[n] = a.stencil_size;
+        table->sample_buffers[n] = a.sample_buffers;
+        table->samples[n] = a.samples;
+        table->double_buffered[n] = a.doublebuffer ? 1 : 0;
+        table->accum_size[n] = min_int(min_int(a.accum_red_size,
+                                               a.accum_green_size),
+                                       min_int(a.accum_blue_size,
+                                               a.accum_alpha_size));
+
+        switch (a.caveat) {
+            case GLX_SLOW_CONFIG:
+                table->caveat[n] = WCORE_CONFIG_CAVEAT_SLOW;
+                break;
+            case GLX_NON_CONFORMANT_CONFIG:
+                table->caveat[n] = WCORE_CONFIG_CAVEAT_NON_CONFORMANT;
+                break;
+            default:
+                table->caveat[n] = WCORE_CONFIG_CAVEAT_NONE;
+                break;
+        }
+
+        // GLX ties the client API to the context, not the config.
+        table->apis[n] = WCORE_CONFIG_API_OPENGL |
+                         WCORE_CONFIG_API_OPENGL_ES1 |
+                         WCORE_CONFIG_API_OPENGL_ES2 |
+                         WCORE_CONFIG_API_OPENGL_ES3;
+        table->visual[n] = a.visual_id;
+        table->id[n] = a.fbconfig_id;
+        table->native[n] = configs[i];
+    }
+
+cleanup:
+    XFree(configs);
+    return table;
+}
+
+static struct wcore_config*
+create_config(struct wcore_display *wc_dpy,
+              const struct wcore_config_attrs *attrs,
+              const struct wcore_config_table *table,
+              int32_t index)
+{
+    struct glx_config *self;
 
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
-    ok = wcore_config_init(&self->wcore, wc_dpy, attrs);
-    if (!ok)
-        goto error;
-
-    int attrib_list[] = {
-        // From page 12 (18 of pdf) of the GLX 1.4 spec:
-        //
-        //    For GLXFBConfigs that correspond to a TrueColor or DirectColor
-        //    visual, GLX BUFFER SIZE is the sum of GLX RED SIZE, GLX GREEN
-        //    SIZE, GLX BLUE SIZE, and GLX ALPHA SIZE.
-        GLX_BUFFER_SIZE,        attrs->rgba_size,
-        GLX_RED_SIZE,           attrs->red_size,
-        GLX_GREEN_SIZE,         attrs->green_size,
-        GLX_BLUE_SIZE,          attrs->blue_size,
-        GLX_ALPHA_SIZE,         attrs->alpha_size,
-
-        GLX_DEPTH_SIZE,         attrs->depth_size,
-        GLX_STENCIL_SIZE,       attrs->stencil_size,
-
-        GLX_SAMPLE_BUFFERS,     attrs->sample_buffers,
-        GLX_SAMPLES,            attrs->samples,
-
-        GLX_DOUBLEBUFFER,       attrs->double_buffered,
-
-        GLX_ACCUM_RED_SIZE,     attrs->accum_buffer,
-        GLX_ACCUM_GREEN_SIZE,   attrs->accum_buffer,
-        GLX_ACCUM_BLUE_SIZE,    attrs->accum_buffer,
-        GLX_ACCUM_ALPHA_SIZE,   attrs->accum_buffer,
-
-        // According to the GLX 1.4 spec Table 3.4, the default value of
-        // GLX_DRAWABLE_TYPE is GLX_WINDOW_BIT. Explicitly set the default
-        // here for the sake of self-documentation.
-        GLX_DRAWABLE_TYPE,      GLX_WINDOW_BIT,
-
-        0,
-    };
-
-    // Set glx_fbconfig.
-    configs = wrapped_glXChooseFBConfig(plat, dpy->x11.xlib,
-                                        dpy->x11.screen,
-                                        attrib_list,
-                                        &num_configs);
-    if (!configs || num_configs == 0) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "glXChooseFBConfig returned no matching configs");
-        goto error;
+    if (!wcore_config_init(&self->wcore, wc_dpy, attrs)) {
+        free(self);
+        return NULL;
     }
-    // Simply take the first.
-    self->glx_fbconfig = configs[0];
-
-    // Set glx_fbconfig_id.
-    ok = !wrapped_glXGetFBConfigAttrib(plat, dpy->x11.xlib,
-                                       self->glx_fbconfig,
-                                       GLX_FBCONFIG_ID,
-                                       &self->glx_fbconfig_id);
-    if (!ok) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glxGetFBConfigAttrib failed");
-        goto error;
+
+    self->glx_fbconfig = table->native[index];
+    self->glx_fbconfig_id = table->id[index];
+    self->xcb_visual_id = table->visual[index];
+    return &self->wcore;
+}
+
+/// @brief Return the indices of the matching configs, best first.
+static int32_t
+match_configs(struct wcore_display *wc_dpy,
+              const struct wcore_config_attrs *attrs,
+              const struct wcore_config_table **table,
+              int32_t **indices)
+{
+    int32_t num_matches;
+
+    if (!glx_config_check_context_attrs(glx_display(wc_dpy), attrs))
+        return -1;
+
+    *table = wcore_display_get_config_table(wc_dpy, create_config_table);
+    if (!*table)
+        return -1;
+
+    *indices = wcore_malloc(((*table)->count + 1) * sizeof(**indices));
+    if (!*indices)
+        return -1;
+
+    num_matches = wcore_config_table_match(*table, attrs, *indices);
+    if (num_matches < 0) {
+        free(*indices);
+        *indices = NULL;
     }
 
-    // Set xcb_visual_id.
-    vi = wrapped_glXGetVisualFromFBConfig(plat, dpy->x11.xlib,
-                                          self->glx_fbconfig);
-    if (!vi) {
+    return num_matches;
+}
+
+struct wcore_config*
+glx_config_choose(struct wcore_platform *wc_plat,
+                  struct wcore_display *wc_dpy,
+                  const struct wcore_config_attrs *attrs)
+{
+    const struct wcore_config_table *table;
+    struct wcore_config *config = NULL;
+    int32_t *indices = NULL;
+    int32_t num_matches;
+
+    (void) wc_plat;
+
+    num_matches = match_configs(wc_dpy, attrs, &table, &indices);
+    if (num_matches < 0)
+        return NULL;
+
+    if (num_matches == 0) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "glXGetVisualInfoFromFBConfig failed with "
-                     "GLXFBConfigID=0x%x\n", self->glx_fbconfig_id);
-        goto error;
+                     "no GLXFBConfig matches the requested attributes");
+        goto out;
     }
-    self->xcb_visual_id = vi->visualid;
 
-    goto cleanup;
+    config = create_config(wc_dpy, attrs, table, indices[0]);
 
-error:
-    glx_config_destroy(&self->wcore);
-    self = NULL;
+out:
+    free(indices);
+    return config;
+}
 
-cleanup:
-    if (configs)
-        XFree(configs);
-    if (vi)
-        XFree(vi);
+bool
+glx_config_enumerate(struct wcore_platform *wc_plat,
+                     struct wcore_display *wc_dpy,
+                     const struct wcore_config_attrs *attrs,
+                     struct wcore_config **configs,
+                     int32_t configs_size,
+                     int32_t *num_configs)
+{
+    const struct wcore_config_table *table;
+    int32_t *indices = NULL;
+    int32_t num_matches;
+    int32_t n = 0;
 
-    return &self->wcore;
+    (void) wc_plat;
+
+    num_matches = match_configs(wc_dpy, attrs, &table, &indices);
+    if (num_matches < 0)
+        return false;
+
+    if (configs) {
+        for (; n < num_matches && n < configs_size; ++n) {
+            configs[n] = create_config(wc_dpy, attrs, table, indices[n]);
+            if (!configs[n])
+                goto fail;
+        }
+    } else {
+        n = num_matches;
+    }
+
+    free(indices);
+    *num_configs = n;
+    return true;
+
+fail:
+    while (n-- > 0)
+        glx_config_destroy(configs[n]);
+    free(indices);
+    return false;
 }
 
 union waffle_native_config*
@@ -55,6 +55,14 @@ glx_config_choose(struct wcore_platform *wc_plat,
                   struct wcore_display *wc_dpy,
                   const struct wcore_config_attrs *attrs);
 
+bool
+glx_config_enumerate(struct wcore_platform *wc_plat,
+                     struct wcore_display *wc_dpy,
+                     const struct wcore_config_attrs *attrs,
+                     struct wcore_config **configs,
+                     int32_t configs_size,
+                     int32_t *num_configs);
+
 bool
 glx_config_destroy(struct wcore_config *wc_self);
 
@@ -83,5 +83,11 @@ glx_context_needs_arb_create_context(const struct wcore_config_attrs *attrs)
     if (attrs->context_robust)
         return true;
 
+    if (attrs->context_no_error)
+        return true;
+
+    if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE)
+        return true;
+
     return false;
 }
@@ -64,6 +64,9 @@ glx_display_set_extensions(struct glx_display *self)
     self->ARB_create_context                     = waffle_is_extension_in_string(s, "GLX_ARB_create_context");
     self->ARB_create_context_profile             = waffle_is_extension_in_string(s, "GLX_ARB_create_context_profile");
     self->ARB_create_context_robustness          = waffle_is_extension_in_string(s, "GLX_ARB_create_context_robustness");
+    self->ARB_create_context_no_error            = waffle_is_extension_in_string(s, "GLX_ARB_create_context_no_error");
+    self->ARB_context_flush_control              = waffle_is_extension_in_string(s, "GLX_ARB_context_flush_control");
+    self->MESA_query_renderer                    = waffle_is_extension_in_string(s, "GLX_MESA_query_renderer");
     self->EXT_create_context_es_profile          = waffle_is_extension_in_string(s, "GLX_EXT_create_context_es_profile");
 
     // The GLX_EXT_create_context_es2_profile spec, version 4 2012/03/28,
@@ -148,3 +151,39 @@ glx_display_get_native(struct wcore_display *wc_self)
 
     return n_dpy;
 }
+
+void
+glx_display_get_capabilities(struct wcore_display *wc_self,
+                             struct waffle_display_capabilities *caps)
+{
+    struct glx_display *self = glx_display(wc_self);
+    struct glx_platform *platform = glx_platform(wc_self->platform);
+    unsigned int value;
+
+    caps->robust_access = self->ARB_create_context_robustness;
+    caps->debug = self->ARB_create_context;
+    caps->no_error = self->ARB_create_context_no_error;
+    caps->release_behavior_none = self->ARB_context_flush_control;
+
+    if (!self->MESA_query_renderer ||
+        !platform->glXQueryRendererIntegerMESA ||
+        !platform->glXQueryRendererStringMESA)
+        return;
+
+    // GLX has no driver name query; the renderer string is the closest.
+    caps->driver_name =
+        platform->glXQueryRendererStringMESA(self->x11.xlib, self->x11.screen,
+                                             0, GLX_RENDERER_DEVICE_ID_MESA);
+
+    if (platform->glXQueryRendererIntegerMESA(self->x11.xlib,
+                                              self->x11.screen, 0,
+                                              GLX_RENDERER_VENDOR_ID_MESA,
+                                              &value))
+        caps->vendor_id = value;
+
+    if (platform->glXQueryRendererIntegerMESA(self->x11.xlib,
+                                              self->x11.screen, 0,
+                                              GLX_RENDERER_DEVICE_ID_MESA,
+                                              &value))
+        caps->device_id = value;
+}
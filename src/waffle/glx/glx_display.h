@@ -47,6 +47,9 @@ struct glx_display {
     bool ARB_create_context;
     bool ARB_create_context_profile;
     bool ARB_create_context_robustness;
+    bool ARB_create_context_no_error;
+    bool ARB_context_flush_control;
+    bool MESA_query_renderer;
     bool EXT_create_context_es_profile;
     bool EXT_create_context_es2_profile;
 };
@@ -69,3 +72,7 @@ glx_display_supports_context_api(struct wcore_display *wc_self,
 
 union waffle_native_display*
 glx_display_get_native(struct wcore_display *wc_self);
+
+void
+glx_display_get_capabilities(struct wcore_display *wc_self,
+                             struct waffle_display_capabilities *caps);
@@ -23,11 +23,13 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <stdio.h>
 #include <stdlib.h>
-#include <dlfcn.h>
 
 #include "wcore_error.h"
+#include "wcore_time.h"
 
+#include "linux_dl.h"
 #include "linux_platform.h"
 
 #include "glx_config.h"
@@ -41,12 +43,22 @@ static const char *libGL_filename = "libGL.so.1";
 
 static const struct wcore_platform_vtbl glx_platform_vtbl;
 
+/// linux_dl reports failures as WAFFLE_ERROR_UNKNOWN, but failing to load
+/// GLX has always been fatal for platform creation. Keep linux_dl's message.
+static void
+glx_platform_error_fatal(void)
+{
+    char message[256];
+
+    snprintf(message, sizeof(message), "%s", wcore_error_get_info()->message);
+    wcore_errorf(WAFFLE_ERROR_FATAL, "%s", message);
+}
+
 static bool
 glx_platform_destroy(struct wcore_platform *wc_self)
 {
     struct glx_platform *self = glx_platform(wc_self);
     bool ok = true;
-    int error = 0;
 
     if (!self)
         return true;
@@ -54,16 +66,9 @@ glx_platform_destroy(struct wcore_platform *wc_self)
     if (self->linux)
         ok &= linux_platform_destroy(self->linux);
 
-    if (self->glxHandle) {
-        error = dlclose(self->glxHandle);
-        if (error) {
-            ok &= false;
-            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                         "dlclose(\"%s\") failed: %s",
-                         libGL_filename, dlerror());
-        }
-    }
+    ok &= linux_dl_close(self->libgl);
 
+    wcore_sym_cache_teardown(&self->proc_cache);
     ok &= wcore_platform_teardown(wc_self);
     free(self);
     return ok;
@@ -73,6 +78,7 @@ struct wcore_platform*
 glx_platform_create(void)
 {
     struct glx_platform *self;
+    uint64_t t0, t1;
     bool ok = true;
 
     self = wcore_calloc(sizeof(*self));
@@ -83,20 +89,26 @@ glx_platform_create(void)
     if (!ok)
         goto error;
 
-    self->glxHandle = dlopen(libGL_filename, RTLD_LAZY | RTLD_LOCAL);
-    if (!self->glxHandle) {
-        wcore_errorf(WAFFLE_ERROR_FATAL,
-                     "dlopen(\"%s\") failed: %s",
-                     libGL_filename, dlerror());
+    ok = wcore_sym_cache_init(&self->proc_cache);
+    if (!ok)
+        goto error;
+
+    t0 = wcore_time_ns();
+    // The glX* symbols live in libGL, whatever WAFFLE_LIBGL selects for
+    // waffle_dl_sym(). The handle is shared with waffle_dl when both open
+    // libGL.so.1.
+    self->libgl = linux_dl_open_name(libGL_filename);
+    t1 = wcore_time_ns();
+    self->wcore.init_time.dl_open += t1 - t0;
+    if (!self->libgl) {
+        glx_platform_error_fatal();
         goto error;
     }
 
 #define RETRIEVE_GLX_SYMBOL(function)                                  \
-    self->function = dlsym(self->glxHandle, #function);                \
+    self->function = linux_dl_sym(self->libgl, #function);             \
     if (!self->function) {                                             \
-        wcore_errorf(WAFFLE_ERROR_FATAL,                             \
-                     "dlsym(\"%s\", \"" #function "\") failed: %s",    \
-                     libGL_filename, dlerror());                      \
+        glx_platform_error_fatal();                                    \
         goto error;                                                    \
     }
 
@@ -107,18 +119,21 @@ glx_platform_create(void)
     RETRIEVE_GLX_SYMBOL(glXQueryExtensionsString);
     RETRIEVE_GLX_SYMBOL(glXGetProcAddress);
 
-    RETRIEVE_GLX_SYMBOL(glXGetVisualFromFBConfig);
     RETRIEVE_GLX_SYMBOL(glXGetFBConfigAttrib);
-    RETRIEVE_GLX_SYMBOL(glXChooseFBConfig);
+    RETRIEVE_GLX_SYMBOL(glXGetFBConfigs);
 
     RETRIEVE_GLX_SYMBOL(glXSwapBuffers);
 #undef RETRIEVE_GLX_SYMBOL
 
-    self->linux = linux_platform_create();
+    self->wcore.init_time.dl_sym += wcore_time_ns() - t1;
+
+    self->linux = linux_platform_create(false);
     if (!self->linux)
         goto error;
 
     self->glXCreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC) self->glXGetProcAddress((const uint8_t*) "glXCreateContextAttribsARB");
+    self->glXQueryRendererIntegerMESA = (PFNGLXQUERYRENDERERINTEGERMESAPROC) self->glXGetProcAddress((const uint8_t*) "glXQueryRendererIntegerMESA");
+    self->glXQueryRendererStringMESA = (PFNGLXQUERYRENDERERSTRINGMESAPROC) self->glXGetProcAddress((const uint8_t*) "glXQueryRendererStringMESA");
 
     self->wcore.vtbl = &glx_platform_vtbl;
     return &self->wcore;
@@ -153,7 +168,14 @@ glx_platform_get_proc_address(struct wcore_platform *wc_self,
                               const char *name)
 {
     struct glx_platform *self = glx_platform(wc_self);
-    return self->glXGetProcAddress((const GLubyte*) name);
+    void *sym = wcore_sym_cache_get(&self->proc_cache, name);
+
+    if (!sym) {
+        sym = self->glXGetProcAddress((const GLubyte*) name);
+        wcore_sym_cache_put(&self->proc_cache, name, sym);
+    }
+
+    return sym;
 }
 
 static bool
@@ -187,10 +209,12 @@ static const struct wcore_platform_vtbl glx_platform_vtbl = {
         .destroy = glx_display_destroy,
         .supports_context_api = glx_display_supports_context_api,
         .get_native = glx_display_get_native,
+        .get_capabilities = glx_display_get_capabilities,
     },
 
     .config = {
         .choose = glx_config_choose,
+        .enumerate = glx_config_enumerate,
         .destroy = glx_config_destroy,
         .get_native = glx_config_get_native,
     },
@@ -29,16 +29,22 @@
 #undef linux
 
 #include "wcore_platform.h"
+#include "wcore_sym_cache.h"
 #include "wcore_util.h"
 
+struct linux_dl;
 struct linux_platform;
 
 struct glx_platform {
     struct wcore_platform wcore;
     struct linux_platform *linux;
 
+    /// @brief Results of glXGetProcAddress(), which are
+    /// context-independent.
+    struct wcore_sym_cache proc_cache;
+
     // glX function pointers
-    void *glxHandle;
+    struct linux_dl *libgl;
 
     GLXContext (*glXCreateNewContext)(Display *dpy, GLXFBConfig config,
                                       int renderType, GLXContext shareList,
@@ -49,16 +55,18 @@ struct glx_platform {
     const char *(*glXQueryExtensionsString)(Display *dpy, int screen);
     void *(*glXGetProcAddress)(const GLubyte *procname);
 
-    XVisualInfo *(*glXGetVisualFromFBConfig)(Display *dpy, GLXFBConfig config);
     int (*glXGetFBConfigAttrib)(Display *dpy, GLXFBConfig config,
                                 int attribute, int *value);
-    GLXFBConfig *(*glXChooseFBConfig)(Display *dpy, int screen,
-                                      const int *attribList, int *nitems);
+    GLXFBConfig *(*glXGetFBConfigs)(Display *dpy, int screen, int *nelements);
 
     void (*glXSwapBuffers)(Display *dpy, GLXDrawable drawable);
 
 
     PFNGLXCREATECONTEXTATTRIBSARBPROC glXCreateContextAttribsARB;
+
+    // GLX_MESA_query_renderer
+    PFNGLXQUERYRENDERERINTEGERMESAPROC glXQueryRendererIntegerMESA;
+    PFNGLXQUERYRENDERERSTRINGMESAPROC glXQueryRendererStringMESA;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(glx_platform,
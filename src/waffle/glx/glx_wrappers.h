@@ -45,13 +45,11 @@
 #include "x11_wrappers.h"
 
 static inline GLXFBConfig*
-wrapped_glXChooseFBConfig(struct glx_platform *platform,
-                          Display *dpy, int screen,
-                          const int *attribList, int *nitems)
+wrapped_glXGetFBConfigs(struct glx_platform *platform,
+                        Display *dpy, int screen, int *nelements)
 {
     X11_SAVE_ERROR_HANDLER
-    GLXFBConfig *configs = platform->glXChooseFBConfig(dpy, screen,
-                                                       attribList, nitems);
+    GLXFBConfig *configs = platform->glXGetFBConfigs(dpy, screen, nelements);
     X11_RESTORE_ERROR_HANDLER
     return configs;
 }
@@ -92,16 +90,6 @@ wrapped_glXGetFBConfigAttrib(struct glx_platform *platform,
     return error;
 }
 
-static inline XVisualInfo*
-wrapped_glXGetVisualFromFBConfig(struct glx_platform *platform,
-                                 Display *dpy, GLXFBConfig config)
-{
-    X11_SAVE_ERROR_HANDLER
-    XVisualInfo *vi = platform->glXGetVisualFromFBConfig(dpy, config);
-    X11_RESTORE_ERROR_HANDLER
-    return vi;
-}
-
 static inline void
 wrapped_glXDestroyContext(struct glx_platform *platform,
                           Display *dpy, GLXContext ctx)
@@ -26,40 +26,104 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <dlfcn.h>
 
+#include "threads.h"
+
 #include "wcore_error.h"
+#include "wcore_sym_cache.h"
 #include "wcore_util.h"
 
 #include "linux_dl.h"
 
 struct linux_dl {
-    /// @brief For example, "libGLESv2.so.2".
-    const char *name;
+    /// @brief For example, "libGLESv2.so.2", or a path from the environment.
+    char *name;
 
     /// @brief The library obtained with dlopen().
-    ///
-    /// The library is initialized if and only if `dl != NULL`.
     void *dl;
+
+    /// @brief Symbols previously resolved with linux_dl_sym().
+    struct wcore_sym_cache cache;
+
+    /// @brief Number of opens not yet matched by linux_dl_close().
+    ///
+    /// Protected by linux_dl_mutex.
+    int refcount;
+
+    /// @brief Next entry in linux_dl_list.
+    struct linux_dl *next;
+};
+
+/// @brief The open libraries, each at most once.
+///
+/// GLX and the waffle_dl functions both need libGL, and every platform
+/// instance needs the same client libraries. Sharing the entry shares its
+/// symbol cache too.
+static struct linux_dl *linux_dl_list;
+static mtx_t linux_dl_mutex;
+static once_flag linux_dl_once = ONCE_FLAG_INIT;
+
+enum {
+    LINUX_DL_MAX_NAMES = 2,
 };
 
+static void
+linux_dl_init_once(void)
+{
+    mtx_init(&linux_dl_mutex, mtx_plain);
+}
+
+/// @brief The environment variable that overrides the library of a
+/// `WAFFLE_DL_*`.
 static const char*
-linux_dl_get_name(int32_t waffle_dl)
+linux_dl_get_env(int32_t waffle_dl)
 {
     switch (waffle_dl) {
-        case WAFFLE_DL_OPENGL:
-#ifdef WAFFLE_HAS_ANDROID
+        case WAFFLE_DL_OPENGL:      return "WAFFLE_LIBGL";
+        case WAFFLE_DL_OPENGL_ES1:  return "WAFFLE_LIBGLES1";
+        case WAFFLE_DL_OPENGL_ES2:
+        case WAFFLE_DL_OPENGL_ES3:  return "WAFFLE_LIBGLES2";
+        default:
+            assert(false);
             return NULL;
-#else
-            return "libGL.so.1";
+    }
+}
+
+/// @brief Fill @a names with the libraries to try, most preferred first.
+///
+/// Return the number of names.
+static int
+linux_dl_get_names(int32_t waffle_dl, bool egl,
+                   const char *names[LINUX_DL_MAX_NAMES])
+{
+    const char *env = getenv(linux_dl_get_env(waffle_dl));
+    int count = 0;
+
+    if (env && env[0]) {
+        names[count++] = env;
+        return count;
+    }
+
+    switch (waffle_dl) {
+        case WAFFLE_DL_OPENGL:
+#ifndef WAFFLE_HAS_ANDROID
+            // GLVND's libOpenGL.so.0 provides OpenGL without GLX. libGL.so.1
+            // would also pull in libGLX and Xlib, which EGL does not need.
+            if (egl)
+                names[count++] = "libOpenGL.so.0";
+            names[count++] = "libGL.so.1";
 #endif
+            break;
         case WAFFLE_DL_OPENGL_ES1:
 #ifdef WAFFLE_HAS_ANDROID
-            return "libGLESv1_CM.so";
+            names[count++] = "libGLESv1_CM.so";
 #else
-            return "libGLESv1_CM.so.1";
+            names[count++] = "libGLESv1_CM.so.1";
 #endif
+            break;
         case WAFFLE_DL_OPENGL_ES2:
         case WAFFLE_DL_OPENGL_ES3:
             // As of 2014-04-20, Mesa statically provides the ES2 and ES3
@@ -69,69 +133,148 @@ linux_dl_get_name(int32_t waffle_dl)
             // symbols. The soname was and is libGLESv2.so.2 before and after
             // ES3.
 #ifdef WAFFLE_HAS_ANDROID
-            return "libGLESv2.so";
+            names[count++] = "libGLESv2.so";
 #else
-            return "libGLESv2.so.2";
+            names[count++] = "libGLESv2.so.2";
 #endif
+            break;
         default:
             assert(false);
-            return NULL;
+            break;
     }
+
+    return count;
 }
 
 struct linux_dl*
-linux_dl_open(int32_t waffle_dl)
+linux_dl_open_name(const char *name)
 {
-    struct linux_dl *self = wcore_calloc(sizeof(*self));
+    struct linux_dl *self;
+
+    call_once(&linux_dl_once, linux_dl_init_once);
+    mtx_lock(&linux_dl_mutex);
+
+    for (self = linux_dl_list; self; self = self->next) {
+        if (strcmp(self->name, name) == 0) {
+            ++self->refcount;
+            goto done;
+        }
+    }
+
+    self = wcore_calloc(sizeof(*self));
     if (self == NULL)
-        return NULL;
+        goto done;
 
-    self->name = linux_dl_get_name(waffle_dl);
+    self->name = wcore_strdup(name);
     if (!self->name)
         goto error;
 
-    self->dl = dlopen(self->name, RTLD_LAZY);
+    self->dl = dlopen(name, RTLD_LAZY);
     if (!self->dl) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "dlopen(\"%s\") failed: %s", self->name, dlerror());
+                     "dlopen(\"%s\") failed: %s", name, dlerror());
         goto error;
     }
 
-    return self;
+    if (!wcore_sym_cache_init(&self->cache)) {
+        dlclose(self->dl);
+        goto error;
+    }
+
+    self->refcount = 1;
+    self->next = linux_dl_list;
+    linux_dl_list = self;
+    goto done;
 
 error:
+    free(self->name);
     free(self);
-    return NULL;
+    self = NULL;
+done:
+    mtx_unlock(&linux_dl_mutex);
+    return self;
+}
+
+struct linux_dl*
+linux_dl_open(int32_t waffle_dl, bool egl)
+{
+    const char *names[LINUX_DL_MAX_NAMES];
+    struct linux_dl *self = NULL;
+    int count;
+
+    count = linux_dl_get_names(waffle_dl, egl, names);
+    if (count == 0) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "no library provides %s on this platform",
+                     wcore_enum_to_string(waffle_dl));
+        return NULL;
+    }
+
+    // Only the failure of the last name is worth reporting.
+    for (int i = 0; i < count - 1 && !self; ++i) {
+        WCORE_ERROR_DISABLED({
+            self = linux_dl_open_name(names[i]);
+        });
+    }
+
+    if (!self)
+        self = linux_dl_open_name(names[count - 1]);
+
+    return self;
 }
 
 bool
 linux_dl_close(struct linux_dl *self)
 {
+    struct linux_dl **link;
     int error = 0;
 
     if (!self)
         return true;
 
-    if (self->dl) {
-        error = dlclose(self->dl);
-        if (error) {
-            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                         "dlclose(libname=\"%s\") failed: %s",
-                         self->name, dlerror());
-        }
+    mtx_lock(&linux_dl_mutex);
+
+    if (--self->refcount > 0) {
+        mtx_unlock(&linux_dl_mutex);
+        return true;
+    }
+
+    for (link = &linux_dl_list; *link != self; link = &(*link)->next)
+        continue;
+    *link = self->next;
+
+    mtx_unlock(&linux_dl_mutex);
+
+    error = dlclose(self->dl);
+    if (error) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "dlclose(libname=\"%s\") failed: %s",
+                     self->name, dlerror());
     }
 
+    wcore_sym_cache_teardown(&self->cache);
+    free(self->name);
     free(self);
     return error == 0;
 }
 
+const char*
+linux_dl_get_name(const struct linux_dl *self)
+{
+    return self->name;
+}
+
 void*
 linux_dl_sym(struct linux_dl *self, const char *symbol)
 {
+    void *sym = wcore_sym_cache_get(&self->cache, symbol);
+    if (sym)
+        return sym;
+
     // Clear any previous error.
     dlerror();
 
-    void *sym = dlsym(self->dl, symbol);
+    sym = dlsym(self->dl, symbol);
 
     const char *error = dlerror();
     if (error) {
@@ -141,5 +284,6 @@ linux_dl_sym(struct linux_dl *self, const char *symbol)
         return NULL;
     }
 
+    wcore_sym_cache_put(&self->cache, symbol, sym);
     return sym;
 }
@@ -33,13 +33,29 @@
 
 struct linux_dl;
 
+/// @brief Open a library by name or path.
+///
+/// Libraries are shared across the process. Opening a name that is already
+/// open returns the same object with one more reference.
+struct linux_dl*
+linux_dl_open_name(const char *name);
+
 /// @brief Dynamically open an OpenGL library.
 /// @a waffle_dl must be one of `WAFFLE_DL_*`.
+///
+/// The environment variables WAFFLE_LIBGL, WAFFLE_LIBGLES1 and
+/// WAFFLE_LIBGLES2 override the library. Otherwise, if @a egl, then
+/// WAFFLE_DL_OPENGL prefers GLVND's libOpenGL.so.0 to libGL.so.1.
 struct linux_dl*
-linux_dl_open(int32_t waffle_dl);
+linux_dl_open(int32_t waffle_dl, bool egl);
 
+/// @brief Drop a reference. The last one closes the library.
 bool
 linux_dl_close(struct linux_dl *self);
 
 void*
 linux_dl_sym(struct linux_dl *self, const char *symbol);
+
+/// @brief The name or path that the library was opened with.
+const char*
+linux_dl_get_name(const struct linux_dl *self);
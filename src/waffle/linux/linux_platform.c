@@ -33,15 +33,22 @@
 #include "linux_platform.h"
 
 struct linux_platform {
+    bool egl;
+
     struct linux_dl *libgl;
     struct linux_dl *libgles1;
     struct linux_dl *libgles2;
 };
 
 struct linux_platform*
-linux_platform_create(void)
+linux_platform_create(bool egl)
 {
-    return wcore_calloc(sizeof(struct linux_platform));
+    struct linux_platform *self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    self->egl = egl;
+    return self;
 }
 
 bool
@@ -52,7 +59,8 @@ linux_platform_destroy(struct linux_platform *self)
     if (!self)
         return true;
 
-    // FIXME: Waffle is unable to emit a sequence of errors.
+    // Only the first error is reported by waffle_error_get_info(). The
+    // others remain available through waffle_error_get_history_info().
     ok &= linux_dl_close(self->libgl);
     ok &= linux_dl_close(self->libgles1);
     ok &= linux_dl_close(self->libgles2);
@@ -77,7 +85,7 @@ linux_platform_get_dl(struct linux_platform *self, int32_t waffle_dl)
     }
 
     if (*dl == NULL)
-        *dl = linux_dl_open(waffle_dl);
+        *dl = linux_dl_open(waffle_dl, self->egl);
 
     return *dl;
 }
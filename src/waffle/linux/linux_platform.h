@@ -30,8 +30,12 @@
 
 struct linux_platform;
 
+/// @brief Create the client API library state of a platform.
+///
+/// Set @a egl for EGL platforms, which can use OpenGL from a library that
+/// does not depend on GLX. See linux_dl_open().
 struct linux_platform*
-linux_platform_create(void);
+linux_platform_create(bool egl);
 
 bool
 linux_platform_destroy(struct linux_platform *self);
@@ -74,7 +74,7 @@ sl_platform_create(void)
 
     self->wegl.egl_surface_type_mask = EGL_PBUFFER_BIT;
 
-    self->linux = linux_platform_create();
+    self->linux = linux_platform_create(true);
     if (!self->linux)
         goto fail;
 
@@ -122,6 +122,7 @@ static const struct wcore_platform_vtbl sl_platform_vtbl = {
     .destroy = sl_platform_destroy,
 
     .make_current = wegl_make_current,
+    .release_thread = wegl_release_thread,
     .get_proc_address = wegl_get_proc_address,
 
     .dl_can_open = sl_dl_can_open,
@@ -132,10 +133,12 @@ static const struct wcore_platform_vtbl sl_platform_vtbl = {
         .destroy = sl_display_destroy,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = sl_display_get_native,
+        .get_capabilities = wegl_display_get_capabilities,
     },
 
     .config = {
         .choose = wegl_config_choose,
+        .enumerate = wegl_config_enumerate,
         .destroy = wegl_config_destroy,
         .get_native = sl_config_get_native,
     },
@@ -144,6 +147,7 @@ static const struct wcore_platform_vtbl sl_platform_vtbl = {
         .create = wegl_context_create,
         .destroy = wegl_context_destroy,
         .get_native = sl_context_get_native,
+        .get_priority = wegl_context_get_priority,
     },
 
     .window = {
@@ -26,9 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "wcore_attrib_list.h"
 #include "wcore_error.h"
-#include "wcore_tinfo.h"
 
 #include "wegl_config.h"
 #include "wegl_util.h"
@@ -59,29 +57,21 @@ sl_window_create(struct wcore_platform *wc_plat,
                    const intptr_t attrib_list[])
 {
     struct sl_window *self;
+    bool offscreen, fbo;
     bool ok = true;
 
-    if (width == -1 && height == -1) {
-        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
-                     "fullscreen window not supported");
+    // Surfaceless windows are always offscreen.
+    if (!wegl_window_parse_attrib_list(attrib_list, &offscreen, &fbo))
         return NULL;
-    }
-
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
-        return NULL;
-    }
 
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
-    ok = wegl_pbuffer_init(&self->wegl, wc_config, width, height);
+    ok = wegl_offscreen_init(&self->wegl, wc_config, width, height, fbo);
     if (!ok)
         goto error;
 
-    self->wc_config = wc_config;
-
     return &self->wegl.wcore;
 
 error:
@@ -99,34 +89,7 @@ bool
 sl_window_resize(struct wcore_window *wc_self,
                  int32_t width, int32_t height)
 {
-    struct wcore_display *wc_dpy = wc_self->display;
-    struct wcore_platform *wc_plat = wc_self->display->platform;
-    struct sl_window *self = sl_window(wegl_surface(wc_self));
-    struct wegl_surface new_wegl;
-    struct wcore_context *wc_ctx;
-    struct wcore_tinfo *tinfo;
-    bool ok = true;
-
-    // Create a new pbuffer for the resized window.
-    ok = wegl_pbuffer_init(&new_wegl, self->wc_config, width, height);
-    if (!ok)
-        return false;
-
-    tinfo = wcore_tinfo_get();
-    wc_ctx = tinfo->current_context;
-
-    ok = wegl_make_current(wc_plat, wc_dpy, &new_wegl.wcore, wc_ctx);
-    if (!ok)
-        goto error;
-
-    // Everything went fine, so teardown the old pbuffer, and set the new one.
-    wegl_surface_teardown(&self->wegl);
-    self->wegl = new_wegl;
-    return true;
-
-error:
-    wegl_surface_teardown(&new_wegl);
-    return false;
+    return wegl_offscreen_resize(wegl_surface(wc_self), width, height);
 }
 
 union waffle_native_window *
@@ -33,7 +33,6 @@ struct wcore_platform;
 
 struct sl_window {
     struct wegl_surface wegl;
-    struct wcore_config *wc_config;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(sl_window,
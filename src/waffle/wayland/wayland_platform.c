@@ -118,7 +118,7 @@ wayland_platform_create(void)
 
 #undef RETRIEVE_WL_EGL_SYMBOL
 
-    self->linux = linux_platform_create();
+    self->linux = linux_platform_create(true);
     if (!self->linux)
         goto error;
 
@@ -185,6 +185,7 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
     .destroy = wayland_platform_destroy,
 
     .make_current = wegl_make_current,
+    .release_thread = wegl_release_thread,
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = wayland_dl_can_open,
     .dl_sym = wayland_dl_sym,
@@ -194,10 +195,12 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
         .destroy = wayland_display_destroy,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = wayland_display_get_native,
+        .get_capabilities = wegl_display_get_capabilities,
     },
 
     .config = {
         .choose = wegl_config_choose,
+        .enumerate = wegl_config_enumerate,
         .destroy = wegl_config_destroy,
         .get_native = wayland_config_get_native,
     },
@@ -206,6 +209,7 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
         .create = wegl_context_create,
         .destroy = wegl_context_destroy,
         .get_native = wayland_context_get_native,
+        .get_priority = wegl_context_get_priority,
     },
 
     .window = {
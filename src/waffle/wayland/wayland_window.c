@@ -35,7 +35,6 @@
 
 #include "waffle_wayland.h"
 
-#include "wcore_attrib_list.h"
 #include "wcore_error.h"
 
 #include "wegl_config.h"
@@ -173,6 +172,7 @@ wayland_window_create(struct wcore_platform *wc_plat,
     struct wayland_window *self;
     struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
     struct wayland_display *dpy = wayland_display(wc_config->display);
+    bool offscreen, fbo;
     bool fullscreen = false;
     bool ok = true;
 
@@ -185,15 +185,22 @@ wayland_window_create(struct wcore_platform *wc_plat,
         return NULL;
     }
 
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
+    if (!wegl_window_parse_attrib_list(attrib_list, &offscreen, &fbo))
         return NULL;
-    }
 
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
+    // No wl_surface, so no compositor traffic.
+    if (offscreen) {
+        ok = wegl_offscreen_init(&self->wegl, wc_config, width, height, fbo);
+        if (!ok)
+            goto error;
+
+        return &self->wegl.wcore;
+    }
+
     if (!dpy->wl_compositor) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wayland compositor not found");
         goto error;
@@ -284,6 +291,9 @@ wayland_window_show(struct wcore_window *wc_self)
     struct wayland_display *dpy = wayland_display(wc_self->display);
     bool ok = true;
 
+    if (self->wegl.offscreen)
+        return true;
+
     if (dpy->xdg_shell)
         wl_surface_commit(self->wl_surface);
     else
@@ -300,6 +310,7 @@ wayland_window_show(struct wcore_window *wc_self)
 bool
 wayland_window_swap_buffers(struct wcore_window *wc_self)
 {
+    struct wayland_window *self = wayland_window(wc_self);
     struct wayland_display *dpy = wayland_display(wc_self->display);
     bool ok;
 
@@ -307,6 +318,9 @@ wayland_window_swap_buffers(struct wcore_window *wc_self)
     if (!ok)
         return false;
 
+    if (self->wegl.offscreen)
+        return true;
+
     ok = wayland_display_sync(dpy);
     if (!ok)
         return false;
@@ -323,6 +337,9 @@ wayland_window_resize(struct wcore_window *wc_self,
     struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
     struct wayland_display *dpy = wayland_display(self->wegl.wcore.display);
 
+    if (self->wegl.offscreen)
+        return wegl_offscreen_resize(&self->wegl, width, height);
+
     plat->wl_egl_window_resize(wayland_window(wc_self)->wl_window,
                                width, height, 0, 0);
 
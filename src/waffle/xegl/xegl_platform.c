@@ -71,7 +71,7 @@ xegl_platform_create(void)
     if (!ok)
         goto error;
 
-    self->linux = linux_platform_create();
+    self->linux = linux_platform_create(true);
     if (!self->linux)
         goto error;
 
@@ -138,6 +138,7 @@ static const struct wcore_platform_vtbl xegl_platform_vtbl = {
     .destroy = xegl_platform_destroy,
 
     .make_current = wegl_make_current,
+    .release_thread = wegl_release_thread,
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = xegl_dl_can_open,
     .dl_sym = xegl_dl_sym,
@@ -147,10 +148,12 @@ static const struct wcore_platform_vtbl xegl_platform_vtbl = {
         .destroy = xegl_display_destroy,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = xegl_display_get_native,
+        .get_capabilities = wegl_display_get_capabilities,
     },
 
     .config = {
         .choose = wegl_config_choose,
+        .enumerate = wegl_config_enumerate,
         .destroy = wegl_config_destroy,
         .get_native = xegl_config_get_native,
     },
@@ -159,6 +162,7 @@ static const struct wcore_platform_vtbl xegl_platform_vtbl = {
         .create = wegl_context_create,
         .destroy = wegl_context_destroy,
         .get_native = xegl_context_get_native,
+        .get_priority = wegl_context_get_priority,
     },
 
     .window = {
@@ -28,7 +28,6 @@
 
 #include <xcb/xcb.h>
 
-#include "wcore_attrib_list.h"
 #include "wcore_error.h"
 
 #include "wegl_config.h"
@@ -63,22 +62,31 @@ xegl_window_create(struct wcore_platform *wc_plat,
     struct xegl_window *self;
     struct xegl_display *dpy = xegl_display(wc_config->display);
     struct wegl_config *config = wegl_config(wc_config);
+    bool offscreen, fbo;
     bool ok = true;
 
-    if (width == -1 && height == -1) {
-        width = DisplayWidth(dpy->x11.xlib, dpy->x11.screen);
-        height = DisplayHeight(dpy->x11.xlib, dpy->x11.screen);
-    }
-
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
+    if (!wegl_window_parse_attrib_list(attrib_list, &offscreen, &fbo))
         return NULL;
-    }
 
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
+    // An offscreen window has no screen to fill, so it takes the size as
+    // given and wegl_offscreen_init() rejects fullscreen.
+    if (offscreen) {
+        ok = wegl_offscreen_init(&self->wegl, wc_config, width, height, fbo);
+        if (!ok)
+            goto error;
+
+        return &self->wegl.wcore;
+    }
+
+    if (width == -1 && height == -1) {
+        width = DisplayWidth(dpy->x11.xlib, dpy->x11.screen);
+        height = DisplayHeight(dpy->x11.xlib, dpy->x11.screen);
+    }
+
     ok = x11_window_init(&self->x11,
                          &dpy->x11,
                          (xcb_visualid_t) config->visual,
@@ -103,14 +111,24 @@ error:
 bool
 xegl_window_show(struct wcore_window *wc_self)
 {
-    return x11_window_show(&xegl_window(wc_self)->x11);
+    struct xegl_window *self = xegl_window(wc_self);
+
+    if (self->wegl.offscreen)
+        return true;
+
+    return x11_window_show(&self->x11);
 }
 
 bool
 xegl_window_resize(struct wcore_window *wc_self,
                    int32_t width, int32_t height)
 {
-   return x11_window_resize(&xegl_window(wc_self)->x11, width, height);
+    struct xegl_window *self = xegl_window(wc_self);
+
+    if (self->wegl.offscreen)
+        return wegl_offscreen_resize(&self->wegl, width, height);
+
+    return x11_window_resize(&self->x11, width, height);
 }
 
 union waffle_native_window*
@@ -0,0 +1,236 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Measure the per-call overhead of waffle's API entry points.
+///
+/// Each benchmark calls an entry point that does no native work in a tight
+/// loop, so the result is the cost of entering waffle itself: thread-local
+/// info lookup, error reset, and object validation.
+///
+/// Usage: api_entry_bench [--platform NAME] [--iterations N] [--no-validation]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "waffle.h"
+
+struct bench_state {
+    struct waffle_display *dpy;
+    struct waffle_config *config;
+    struct waffle_window *window;
+    struct waffle_context *ctx;
+};
+
+static const struct {
+    int32_t platform;
+    const char *name;
+} platform_map[] = {
+    { WAFFLE_PLATFORM_CGL,              "cgl"             },
+    { WAFFLE_PLATFORM_GBM,              "gbm"             },
+    { WAFFLE_PLATFORM_GLX,              "glx"             },
+    { WAFFLE_PLATFORM_WAYLAND,          "wayland"         },
+    { WAFFLE_PLATFORM_WGL,              "wgl"             },
+    { WAFFLE_PLATFORM_X11_EGL,          "x11_egl"         },
+    { WAFFLE_PLATFORM_SURFACELESS_EGL,  "surfaceless_egl" },
+};
+
+static void
+die_waffle(const char *func)
+{
+    const struct waffle_error_info *info = waffle_error_get_info();
+
+    fprintf(stderr, "api_entry_bench: %s failed: %s: %s\n", func,
+            waffle_error_to_string(info->code),
+            info->message_length > 0 ? info->message : "");
+    exit(EXIT_FAILURE);
+}
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void
+report(const char *name, double start, double end, long iterations)
+{
+    printf("%-36s %8.2f ns/call\n", name, (end - start) / iterations);
+}
+
+static void
+bench_error_get_code(struct bench_state *s, long iterations)
+{
+    double start = now_ns();
+
+    (void) s;
+
+    for (long i = 0; i < iterations; ++i)
+        (void) waffle_error_get_code();
+
+    report("waffle_error_get_code", start, now_ns(), iterations);
+}
+
+static void
+bench_get_current_context(struct bench_state *s, long iterations)
+{
+    double start = now_ns();
+
+    for (long i = 0; i < iterations; ++i) {
+        if (waffle_get_current_context() != s->ctx)
+            die_waffle("waffle_get_current_context");
+    }
+
+    report("waffle_get_current_context", start, now_ns(), iterations);
+}
+
+static void
+bench_make_current(struct bench_state *s, long iterations)
+{
+    double start = now_ns();
+
+    // The binding is already current, so each call takes the skip path and
+    // never reaches the native platform.
+    for (long i = 0; i < iterations; ++i) {
+        if (!waffle_make_current(s->dpy, s->window, s->ctx))
+            die_waffle("waffle_make_current");
+    }
+
+    report("waffle_make_current (redundant)", start, now_ns(), iterations);
+}
+
+static void
+bench_get_gl_dispatch(struct bench_state *s, long iterations)
+{
+    double start = now_ns();
+
+    for (long i = 0; i < iterations; ++i) {
+        if (!waffle_context_get_gl_dispatch(s->ctx))
+            die_waffle("waffle_context_get_gl_dispatch");
+    }
+
+    report("waffle_context_get_gl_dispatch", start, now_ns(), iterations);
+}
+
+int
+main(int argc, char **argv)
+{
+    int32_t platform = WAFFLE_PLATFORM_SURFACELESS_EGL;
+    long iterations = 10000000;
+    bool no_validation = false;
+    struct bench_state s = { 0 };
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--platform") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            size_t j;
+
+            for (j = 0; j < sizeof(platform_map) / sizeof(platform_map[0]); ++j) {
+                if (strcmp(platform_map[j].name, name) == 0)
+                    break;
+            }
+
+            if (j == sizeof(platform_map) / sizeof(platform_map[0])) {
+                fprintf(stderr, "api_entry_bench: unknown platform '%s'\n", name);
+                return EXIT_FAILURE;
+            }
+
+            platform = platform_map[j].platform;
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--no-validation") == 0) {
+            no_validation = true;
+        } else {
+            fprintf(stderr, "usage: api_entry_bench [--platform NAME] "
+                    "[--iterations N] [--no-validation]\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (iterations <= 0)
+        iterations = 1;
+
+    const int32_t init_attrib_list[] = {
+        WAFFLE_PLATFORM, platform,
+        WAFFLE_SKIP_VALIDATION, no_validation,
+        0,
+    };
+
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL_ES2,
+        0,
+    };
+
+    if (!waffle_init(init_attrib_list))
+        die_waffle("waffle_init");
+
+    s.dpy = waffle_display_connect(NULL);
+    if (!s.dpy)
+        die_waffle("waffle_display_connect");
+
+    s.config = waffle_config_choose(s.dpy, config_attrib_list);
+    if (!s.config)
+        die_waffle("waffle_config_choose");
+
+    s.window = waffle_window_create(s.config, 64, 64);
+    if (!s.window)
+        die_waffle("waffle_window_create");
+
+    s.ctx = waffle_context_create(s.config, NULL);
+    if (!s.ctx)
+        die_waffle("waffle_context_create");
+
+    if (!waffle_make_current(s.dpy, s.window, s.ctx))
+        die_waffle("waffle_make_current");
+
+    if (!waffle_context_get_gl_dispatch(s.ctx))
+        die_waffle("waffle_context_get_gl_dispatch");
+
+    printf("iterations: %ld%s\n", iterations,
+           no_validation ? ", validation disabled" : "");
+
+    bench_error_get_code(&s, iterations);
+    bench_get_current_context(&s, iterations);
+    bench_make_current(&s, iterations);
+    bench_get_gl_dispatch(&s, iterations);
+
+    waffle_make_current(s.dpy, NULL, NULL);
+    waffle_context_destroy(s.ctx);
+    waffle_window_destroy(s.window);
+    waffle_config_destroy(s.config);
+    waffle_display_disconnect(s.dpy);
+    waffle_teardown();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,309 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Measure how GL work on the members of a context group scales with
+/// the number of threads.
+///
+/// For each thread count, create a group with one member per thread, bind
+/// each member on its own thread, and have every thread clear and read back
+/// its window for a fixed number of frames. The result is the total frame
+/// rate, and the speedup over one thread.
+///
+/// Usage: context_group_bench [--platform NAME] [--max-threads N]
+///                            [--frames N] [--size N]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "threads.h"
+#include "waffle.h"
+
+#define GL_COLOR_BUFFER_BIT 0x00004000
+#define GL_RGBA             0x1908
+#define GL_UNSIGNED_BYTE    0x1401
+
+struct bench_run {
+    struct waffle_context_group *group;
+    int32_t frames;
+    int32_t size;
+
+    mtx_t mutex;
+    cnd_t cond;
+    int32_t num_ready;
+    bool go;
+    bool failed;
+};
+
+struct bench_thread {
+    struct bench_run *run;
+    int32_t index;
+    thrd_t thread;
+};
+
+static const struct {
+    int32_t platform;
+    const char *name;
+} platform_map[] = {
+    { WAFFLE_PLATFORM_CGL,              "cgl"             },
+    { WAFFLE_PLATFORM_GBM,              "gbm"             },
+    { WAFFLE_PLATFORM_GLX,              "glx"             },
+    { WAFFLE_PLATFORM_WAYLAND,          "wayland"         },
+    { WAFFLE_PLATFORM_WGL,              "wgl"             },
+    { WAFFLE_PLATFORM_X11_EGL,          "x11_egl"         },
+    { WAFFLE_PLATFORM_SURFACELESS_EGL,  "surfaceless_egl" },
+};
+
+static void
+die_waffle(const char *func)
+{
+    const struct waffle_error_info *info = waffle_error_get_info();
+
+    fprintf(stderr, "context_group_bench: %s failed: %s: %s\n", func,
+            waffle_error_to_string(info->code),
+            info->message_length > 0 ? info->message : "");
+    exit(EXIT_FAILURE);
+}
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int
+bench_thread_main(void *arg)
+{
+    struct bench_thread *t = arg;
+    struct bench_run *run = t->run;
+    const struct waffle_gl_dispatch *gl = NULL;
+    struct waffle_context *ctx;
+    uint8_t *pixels;
+    bool ok;
+
+    pixels = malloc((size_t) run->size * run->size * 4);
+    ctx = waffle_context_group_get_context(run->group, t->index);
+    ok = pixels && ctx &&
+         waffle_context_group_make_current(run->group, t->index) &&
+         (gl = waffle_context_get_gl_dispatch(ctx)) != NULL;
+
+    // Start all threads together, once every member is bound.
+    mtx_lock(&run->mutex);
+    run->failed |= !ok;
+    run->num_ready++;
+    cnd_broadcast(&run->cond);
+    while (!run->go)
+        cnd_wait(&run->cond, &run->mutex);
+    mtx_unlock(&run->mutex);
+
+    if (ok) {
+        for (int32_t i = 0; i < run->frames; ++i) {
+            gl->glClearColor((t->index & 1) ? 1.0f : 0.0f,
+                             (i & 1) ? 1.0f : 0.0f, 0.0f, 1.0f);
+            gl->glClear(GL_COLOR_BUFFER_BIT);
+            gl->glReadPixels(0, 0, run->size, run->size,
+                             GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        }
+
+        waffle_make_current(waffle_get_current_display(), NULL, NULL);
+    }
+
+    free(pixels);
+    return 0;
+}
+
+/// @brief Run one thread count. Return the frames per second of all threads.
+static double
+bench_threads(struct waffle_config *config, int32_t num_threads,
+              int32_t frames, int32_t size, double *create_ms)
+{
+    struct bench_thread *threads;
+    struct bench_run run = {
+        .frames = frames,
+        .size = size,
+    };
+    double start, end;
+
+    const intptr_t group_attrib_list[] = {
+        WAFFLE_CONTEXT_GROUP_SIZE, num_threads,
+        WAFFLE_WINDOW_WIDTH, size,
+        WAFFLE_WINDOW_HEIGHT, size,
+        0,
+    };
+
+    start = now_ns();
+    run.group = waffle_context_group_create(config, NULL, group_attrib_list);
+    if (!run.group)
+        die_waffle("waffle_context_group_create");
+    *create_ms = (now_ns() - start) / 1e6;
+
+    threads = calloc(num_threads, sizeof(*threads));
+    if (!threads) {
+        fprintf(stderr, "context_group_bench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    mtx_init(&run.mutex, mtx_plain);
+    cnd_init(&run.cond);
+
+    for (int32_t i = 0; i < num_threads; ++i) {
+        threads[i].run = &run;
+        threads[i].index = i;
+        if (thrd_create(&threads[i].thread, bench_thread_main,
+                        &threads[i]) != thrd_success) {
+            fprintf(stderr, "context_group_bench: thrd_create failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    mtx_lock(&run.mutex);
+    while (run.num_ready < num_threads)
+        cnd_wait(&run.cond, &run.mutex);
+    start = now_ns();
+    run.go = true;
+    cnd_broadcast(&run.cond);
+    mtx_unlock(&run.mutex);
+
+    for (int32_t i = 0; i < num_threads; ++i)
+        thrd_join(threads[i].thread, NULL);
+    end = now_ns();
+
+    if (run.failed) {
+        fprintf(stderr, "context_group_bench: a thread failed to bind its "
+                "context\n");
+        exit(EXIT_FAILURE);
+    }
+
+    cnd_destroy(&run.cond);
+    mtx_destroy(&run.mutex);
+    free(threads);
+
+    if (!waffle_context_group_destroy(run.group))
+        die_waffle("waffle_context_group_destroy");
+
+    return (double) num_threads * frames / ((end - start) / 1e9);
+}
+
+int
+main(int argc, char **argv)
+{
+    int32_t platform = WAFFLE_PLATFORM_SURFACELESS_EGL;
+    int32_t max_threads = 64;
+    int32_t frames = 200;
+    int32_t size = 256;
+    struct waffle_display *dpy;
+    struct waffle_config *config;
+    double base_fps = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--platform") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            size_t j;
+
+            for (j = 0; j < sizeof(platform_map) / sizeof(platform_map[0]); ++j) {
+                if (strcmp(platform_map[j].name, name) == 0)
+                    break;
+            }
+
+            if (j == sizeof(platform_map) / sizeof(platform_map[0])) {
+                fprintf(stderr, "context_group_bench: unknown platform '%s'\n",
+                        name);
+                return EXIT_FAILURE;
+            }
+
+            platform = platform_map[j].platform;
+        } else if (strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc) {
+            max_threads = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = strtol(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: context_group_bench [--platform NAME] "
+                    "[--max-threads N] [--frames N] [--size N]\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (max_threads <= 0)
+        max_threads = 1;
+    if (frames <= 0)
+        frames = 1;
+    if (size <= 0)
+        size = 1;
+
+    const int32_t init_attrib_list[] = {
+        WAFFLE_PLATFORM, platform,
+        0,
+    };
+
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_RED_SIZE, 8,
+        WAFFLE_GREEN_SIZE, 8,
+        WAFFLE_BLUE_SIZE, 8,
+        WAFFLE_ALPHA_SIZE, 8,
+        0,
+    };
+
+    if (!waffle_init(init_attrib_list))
+        die_waffle("waffle_init");
+
+    dpy = waffle_display_connect(NULL);
+    if (!dpy)
+        die_waffle("waffle_display_connect");
+
+    config = waffle_config_choose(dpy, config_attrib_list);
+    if (!config)
+        die_waffle("waffle_config_choose");
+
+    printf("frames: %d per thread, %dx%d\n", frames, size, size);
+    printf("%8s %12s %14s %10s\n", "threads", "create ms", "frames/s", "speedup");
+
+    for (int32_t n = 1; n <= max_threads; n *= 2) {
+        double create_ms;
+        double fps = bench_threads(config, n, frames, size, &create_ms);
+
+        if (n == 1)
+            base_fps = fps;
+
+        printf("%8d %12.2f %14.1f %9.2fx\n", n, create_ms, fps, fps / base_fps);
+    }
+
+    waffle_config_destroy(config);
+    waffle_display_disconnect(dpy);
+    waffle_teardown();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+// Copyright 2026 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Measure context-switch throughput with each release behavior.
+///
+/// For each WAFFLE_CONTEXT_RELEASE_BEHAVIOR value, create a set of contexts,
+/// each with its own window, and have one thread bind them in turn. Between
+/// two switches, the bound context clears its window, so that every release
+/// has pending commands to flush. The result is the number of switches per
+/// second.
+///
+/// Usage: context_switch_bench [--platform NAME] [--contexts N]
+///                             [--switches N] [--size N]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "waffle.h"
+
+#define GL_COLOR_BUFFER_BIT 0x00004000
+
+static const struct {
+    int32_t platform;
+    const char *name;
+} platform_map[] = {
+    { WAFFLE_PLATFORM_CGL,              "cgl"             },
+    { WAFFLE_PLATFORM_GBM,              "gbm"             },
+    { WAFFLE_PLATFORM_GLX,              "glx"             },
+    { WAFFLE_PLATFORM_WAYLAND,          "wayland"         },
+    { WAFFLE_PLATFORM_WGL,              "wgl"             },
+    { WAFFLE_PLATFORM_X11_EGL,          "x11_egl"         },
+    { WAFFLE_PLATFORM_SURFACELESS_EGL,  "surfaceless_egl" },
+};
+
+static void
+die_waffle(const char *func)
+{
+    const struct waffle_error_info *info = waffle_error_get_info();
+
+    fprintf(stderr, "context_switch_bench: %s failed: %s: %s\n", func,
+            waffle_error_to_string(info->code),
+            info->message_length > 0 ? info->message : "");
+    exit(EXIT_FAILURE);
+}
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/// @brief Run one release behavior. Return the switches per second.
+static double
+bench_release_behavior(struct waffle_display *dpy, int32_t release_behavior,
+                       int32_t num_contexts, int32_t switches, int32_t size)
+{
+    struct waffle_config *config;
+    struct waffle_context **contexts;
+    struct waffle_window **windows;
+    const struct waffle_gl_dispatch **gl;
+    double start, end;
+
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API, WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR, release_behavior,
+        WAFFLE_RED_SIZE, 8,
+        WAFFLE_GREEN_SIZE, 8,
+        WAFFLE_BLUE_SIZE, 8,
+        WAFFLE_ALPHA_SIZE, 8,
+        0,
+    };
+
+    config = waffle_config_choose(dpy, config_attrib_list);
+    if (!config)
+        die_waffle("waffle_config_choose");
+
+    contexts = calloc(num_contexts, sizeof(*contexts));
+    windows = calloc(num_contexts, sizeof(*windows));
+    gl = calloc(num_contexts, sizeof(*gl));
+    if (!contexts || !windows || !gl) {
+        fprintf(stderr, "context_switch_bench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int32_t i = 0; i < num_contexts; ++i) {
+        windows[i] = waffle_window_create(config, size, size);
+        if (!windows[i])
+            die_waffle("waffle_window_create");
+
+        contexts[i] = waffle_context_create(config, NULL);
+        if (!contexts[i])
+            die_waffle("waffle_context_create");
+
+        if (!waffle_make_current(dpy, windows[i], contexts[i]))
+            die_waffle("waffle_make_current");
+
+        gl[i] = waffle_context_get_gl_dispatch(contexts[i]);
+        if (!gl[i])
+            die_waffle("waffle_context_get_gl_dispatch");
+    }
+
+    start = now_ns();
+    for (int32_t i = 0; i < switches; ++i) {
+        int32_t j = i % num_contexts;
+
+        if (!waffle_make_current(dpy, windows[j], contexts[j]))
+            die_waffle("waffle_make_current");
+
+        gl[j]->glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    // Drain the work of the last binding, then release it as well.
+    gl[(switches - 1) % num_contexts]->glFinish();
+    if (!waffle_make_current(dpy, NULL, NULL))
+        die_waffle("waffle_make_current");
+    end = now_ns();
+
+    for (int32_t i = 0; i < num_contexts; ++i) {
+        waffle_context_destroy(contexts[i]);
+        waffle_window_destroy(windows[i]);
+    }
+
+    free(gl);
+    free(windows);
+    free(contexts);
+    waffle_config_destroy(config);
+
+    return switches / ((end - start) / 1e9);
+}
+
+int
+main(int argc, char **argv)
+{
+    int32_t platform = WAFFLE_PLATFORM_SURFACELESS_EGL;
+    int32_t num_contexts = 8;
+    int32_t switches = 20000;
+    int32_t size = 64;
+    const struct waffle_display_capabilities *caps;
+    struct waffle_display *dpy;
+    double flush_rate;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--platform") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            size_t j;
+
+            for (j = 0; j < sizeof(platform_map) / sizeof(platform_map[0]); ++j) {
+                if (strcmp(platform_map[j].name, name) == 0)
+                    break;
+            }
+
+            if (j == sizeof(platform_map) / sizeof(platform_map[0])) {
+                fprintf(stderr, "context_switch_bench: unknown platform '%s'\n",
+                        name);
+                return EXIT_FAILURE;
+            }
+
+            platform = platform_map[j].platform;
+        } else if (strcmp(argv[i], "--contexts") == 0 && i + 1 < argc) {
+            num_contexts = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--switches") == 0 && i + 1 < argc) {
+            switches = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = strtol(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: context_switch_bench [--platform NAME] "
+                    "[--contexts N] [--switches N] [--size N]\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (num_contexts <= 1)
+        num_contexts = 2;
+    if (switches <= 0)
+        switches = 1;
+    if (size <= 0)
+        size = 1;
+
+    const int32_t init_attrib_list[] = {
+        WAFFLE_PLATFORM, platform,
+        0,
+    };
+
+    if (!waffle_init(init_attrib_list))
+        die_waffle("waffle_init");
+
+    dpy = waffle_display_connect(NULL);
+    if (!dpy)
+        die_waffle("waffle_display_connect");
+
+    caps = waffle_display_get_capabilities(dpy);
+    if (!caps)
+        die_waffle("waffle_display_get_capabilities");
+
+    printf("switches: %d among %d contexts, %dx%d\n",
+           switches, num_contexts, size, size);
+    printf("%16s %14s %10s\n", "release behavior", "switches/s", "speedup");
+
+    flush_rate = bench_release_behavior(dpy,
+                                        WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH,
+                                        num_contexts, switches, size);
+    printf("%16s %14.1f %9.2fx\n", "flush", flush_rate, 1.0);
+
+    if (caps->release_behavior_none) {
+        double none_rate =
+            bench_release_behavior(dpy, WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE,
+                                   num_contexts, switches, size);
+        printf("%16s %14.1f %9.2fx\n", "none", none_rate,
+               none_rate / flush_rate);
+    } else {
+        printf("%16s %14s\n", "none", "unsupported");
+    }
+
+    waffle_display_disconnect(dpy);
+    waffle_teardown();
+
+    return EXIT_SUCCESS;
+}
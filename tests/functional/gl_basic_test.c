@@ -43,6 +43,7 @@
 #include <getopt.h>
 #include <sys/types.h>
 #if !defined(_WIN32)
+#include <dirent.h>
 #include <unistd.h>
 #include <sys/wait.h>
 #else
@@ -73,6 +74,7 @@ static const uint8_t    ALPHA_UB    = 0xff;
 
 struct test_state_gl_basic {
     bool initialized;
+    int32_t platform;
     struct waffle_display *dpy;
     struct waffle_config *config;
     struct waffle_window *window;
@@ -114,9 +116,14 @@ typedef double              GLclampd;   /* double precision float in [0,1] */
 #define GL_COLOR_BUFFER_BIT         0x00004000
 #define GL_CONTEXT_FLAGS            0x821e
 #define GL_CONTEXT_ROBUST_ACCESS    0x90F3
+#define GL_CONTEXT_RELEASE_BEHAVIOR 0x82FB
+#define GL_DEPTH_BITS               0x0D56
+#define GL_DEPTH_BUFFER_BIT         0x00000100
+#define GL_FRAMEBUFFER_BINDING      0x8CA6
 
 #define GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT 0x00000001
 #define GL_CONTEXT_FLAG_DEBUG_BIT              0x00000002
+#define GL_CONTEXT_FLAG_NO_ERROR_BIT_KHR       0x00000008
 
 #define GL_CONTEXT_PROFILE_MASK     0x9126
 #define GL_CONTEXT_CORE_PROFILE_BIT            0x00000001
@@ -222,6 +229,7 @@ gl_basic_init(void **state, int32_t waffle_platform)
         0,
     };
 
+    ts->platform = waffle_platform;
     ts->initialized = waffle_init(init_attrib_list);
     if (!ts->initialized) {
         // XXX: does cmocka call teardown if setup fails ?
@@ -267,6 +275,8 @@ gl_basic_fini(void **state)
         .forward_compatible = false, \
         .debug = false, \
         .robust = false, \
+        .no_error = false, \
+        .release_none = false, \
         .alpha = false, \
         .expect_error = WAFFLE_NO_ERROR, \
         __VA_ARGS__ \
@@ -280,6 +290,8 @@ struct gl_basic_draw_args__ {
     bool forward_compatible;
     bool debug;
     bool robust;
+    bool no_error;
+    bool release_none;
     bool alpha;
 };
 
@@ -327,6 +339,63 @@ error_waffle(void)
         assert_true(0); \
     }
 
+// Return the first of OpenGL and OpenGL ES2 that dpy supports, or 0 if it
+// supports neither.
+static int32_t
+gl_basic_any_context_api(struct waffle_display *dpy)
+{
+    if (waffle_display_supports_context_api(dpy, WAFFLE_CONTEXT_OPENGL))
+        return WAFFLE_CONTEXT_OPENGL;
+    if (waffle_display_supports_context_api(dpy, WAFFLE_CONTEXT_OPENGL_ES2))
+        return WAFFLE_CONTEXT_OPENGL_ES2;
+    return 0;
+}
+
+// Choose a config of context_api on dpy. The attributes in attrib_list, which
+// may be null, are appended to WAFFLE_CONTEXT_API.
+static struct waffle_config *
+gl_basic_choose_config(struct waffle_display *dpy, int32_t context_api,
+                       const int32_t attrib_list[])
+{
+    struct waffle_config *config;
+    int32_t config_attrib_list[64] = {
+        WAFFLE_CONTEXT_API, context_api,
+    };
+    const int max = sizeof(config_attrib_list) / sizeof(config_attrib_list[0]);
+    int n = 2;
+
+    // Leave room for the terminating 0.
+    for (int i = 0; attrib_list && attrib_list[i]; i += 2) {
+        assert_true(n + 2 < max);
+        config_attrib_list[n++] = attrib_list[i];
+        config_attrib_list[n++] = attrib_list[i + 1];
+    }
+
+    config = waffle_config_choose(dpy, config_attrib_list);
+    assert_true_with_wfl_error(config);
+    return config;
+}
+
+// Connect ts->dpy and choose ts->config for gl_basic_any_context_api(), with
+// the attributes in attrib_list. Return the API, or 0 if the display supports
+// neither OpenGL nor OpenGL ES2.
+static int32_t
+gl_basic_choose_any_config(struct test_state_gl_basic *ts,
+                           const int32_t attrib_list[])
+{
+    int32_t context_api;
+
+    ts->dpy = waffle_display_connect(NULL);
+    assert_true_with_wfl_error(ts->dpy);
+
+    context_api = gl_basic_any_context_api(ts->dpy);
+    if (!context_api)
+        return 0;
+
+    ts->config = gl_basic_choose_config(ts->dpy, context_api, attrib_list);
+    return context_api;
+}
+
 static void
 gl_basic_draw__(void **state, struct gl_basic_draw_args__ args)
 {
@@ -338,6 +407,8 @@ gl_basic_draw__(void **state, struct gl_basic_draw_args__ args)
     bool context_forward_compatible = args.forward_compatible;
     bool context_debug = args.debug;
     bool context_robust = args.robust;
+    bool context_no_error = args.no_error;
+    bool context_release_none = args.release_none;
     bool alpha = args.alpha;
     bool ret;
 
@@ -375,6 +446,14 @@ gl_basic_draw__(void **state, struct gl_basic_draw_args__ args)
         config_attrib_list[i++] = WAFFLE_CONTEXT_ROBUST_ACCESS;
         config_attrib_list[i++] = true;
     }
+    if (context_no_error) {
+        config_attrib_list[i++] = WAFFLE_CONTEXT_NO_ERROR;
+        config_attrib_list[i++] = true;
+    }
+    if (context_release_none) {
+        config_attrib_list[i++] = WAFFLE_CONTEXT_RELEASE_BEHAVIOR;
+        config_attrib_list[i++] = WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE;
+    }
     config_attrib_list[i++] = WAFFLE_RED_SIZE;
     config_attrib_list[i++] = 8;
     config_attrib_list[i++] = WAFFLE_GREEN_SIZE;
@@ -552,7 +631,7 @@ gl_basic_draw__(void **state, struct gl_basic_draw_args__ args)
     if ((waffle_context_api == WAFFLE_CONTEXT_OPENGL && version_10x >= 30) ||
         (waffle_context_api != WAFFLE_CONTEXT_OPENGL && version_10x >= 32)) {
         GLint context_flags = 0;
-        if (context_forward_compatible || context_debug) {
+        if (context_forward_compatible || context_debug || context_no_error) {
             glGetIntegerv(GL_CONTEXT_FLAGS, &context_flags);
         }
 
@@ -563,6 +642,10 @@ gl_basic_draw__(void **state, struct gl_basic_draw_args__ args)
         if (context_debug) {
             assert_true(context_flags & GL_CONTEXT_FLAG_DEBUG_BIT);
         }
+
+        if (context_no_error) {
+            assert_true(context_flags & GL_CONTEXT_FLAG_NO_ERROR_BIT_KHR);
+        }
     }
 
     // GL_ROBUST_ACCESS comes with the following extensions
@@ -580,6 +663,16 @@ gl_basic_draw__(void **state, struct gl_basic_draw_args__ args)
             assert_true(robust_flag);
     }
 
+    // GL_CONTEXT_RELEASE_BEHAVIOR comes with GL_KHR_context_flush_control.
+    // As above, trust glGetError.
+    if (context_release_none) {
+        GLint release_behavior = -1;
+        glGetIntegerv(GL_CONTEXT_RELEASE_BEHAVIOR, &release_behavior);
+
+        if (glGetError() == GL_NO_ERROR)
+            assert_int_equal(release_behavior, 0);
+    }
+
     // Draw.
     ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
     ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT));
@@ -641,6 +734,24 @@ static void test_gl_basic_##context_api##_robust(void **state)          \
                   .expect_error=WAFFLE_##error);                        \
 }
 
+#define test_XX_no_error(context_api, waffle_api, error)                \
+static void test_gl_basic_##context_api##_no_error(void **state)        \
+{                                                                       \
+    gl_basic_draw(state,                                                \
+                  .api=WAFFLE_CONTEXT_##waffle_api,                     \
+                  .no_error=true,                                       \
+                  .expect_error=WAFFLE_##error);                        \
+}
+
+#define test_XX_release_none(context_api, waffle_api, error)            \
+static void test_gl_basic_##context_api##_release_none(void **state)    \
+{                                                                       \
+    gl_basic_draw(state,                                                \
+                  .api=WAFFLE_CONTEXT_##waffle_api,                     \
+                  .release_none=true,                                   \
+                  .expect_error=WAFFLE_##error);                        \
+}
+
 #define test_glXX(waffle_version, error)                                \
 static void test_gl_basic_gl##waffle_version(void **state)              \
 {                                                                       \
@@ -703,6 +814,17 @@ static void test_gl_basic_gl##waffle_version##_core_robust(void **state) \
                   .expect_error=WAFFLE_##error);                        \
 }
 
+#define test_glXX_core_no_error(waffle_version, error)                  \
+static void test_gl_basic_gl##waffle_version##_core_no_error(void **state) \
+{                                                                       \
+    gl_basic_draw(state,                                                \
+                  .api=WAFFLE_CONTEXT_OPENGL,                           \
+                  .version=waffle_version,                              \
+                  .profile=WAFFLE_CONTEXT_CORE_PROFILE,                 \
+                  .no_error=true,                                       \
+                  .expect_error=WAFFLE_##error);                        \
+}
+
 #define test_glXX_compat(waffle_version, error)                         \
 static void test_gl_basic_gl##waffle_version##_compat(void **state)     \
 {                                                                       \
@@ -755,6 +877,1061 @@ static void test_gl_basic_gles##waffle_version(void **state)            \
                   .expect_error=WAFFLE_##error);                        \
 }
 
+// Render on a second instance of the platform, next to the one created by
+// waffle_init(), and switch the thread between the two.
+static void
+test_gl_basic_second_platform(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_platform *plat;
+    struct waffle_display *dpy;
+    struct waffle_config *config;
+    struct waffle_window *window;
+    struct waffle_context *ctx;
+    int32_t context_api;
+
+    const int32_t platform_attrib_list[] = {
+        WAFFLE_PLATFORM, ts->platform,
+        0,
+    };
+
+    plat = waffle_platform_create(platform_attrib_list);
+    assert_true_with_wfl_error(plat);
+
+    dpy = waffle_display_connect_platform(plat, NULL);
+    assert_true_with_wfl_error(dpy);
+
+    ts->dpy = waffle_display_connect(NULL);
+    assert_true_with_wfl_error(ts->dpy);
+
+    context_api = gl_basic_any_context_api(dpy);
+    if (!context_api) {
+        waffle_display_disconnect(dpy);
+        waffle_platform_destroy(plat);
+        skip();
+        return;
+    }
+
+    config = gl_basic_choose_config(dpy, context_api, NULL);
+    ctx = waffle_context_create(config, NULL);
+    assert_true_with_wfl_error(ctx);
+    window = waffle_window_create(config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(window);
+
+    ts->config = gl_basic_choose_config(ts->dpy, context_api, NULL);
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+    ts->window = waffle_window_create(ts->config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(ts->window);
+
+    // Objects of different platforms never match.
+    assert_false(waffle_make_current(ts->dpy, window, ctx));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_DISPLAY_MATCH);
+
+    assert_true_with_wfl_error(waffle_make_current(dpy, window, ctx));
+    assert_true(waffle_get_current_context() == ctx);
+    assert_true(waffle_context_get_gl_dispatch(ctx)->glGetString(GL_VERSION));
+
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window,
+                                                  ts->ctx));
+    assert_true(waffle_get_current_context() == ts->ctx);
+    assert_true(waffle_context_get_gl_dispatch(ts->ctx)->glGetString(GL_VERSION));
+
+    assert_true_with_wfl_error(waffle_window_destroy(window));
+    assert_true_with_wfl_error(waffle_context_destroy(ctx));
+    assert_true_with_wfl_error(waffle_config_destroy(config));
+    assert_true_with_wfl_error(waffle_display_disconnect(dpy));
+    assert_true_with_wfl_error(waffle_platform_destroy(plat));
+}
+
+// WAFFLE_PLATFORM_AUTO resolves to a real platform and sticks to it.
+static void
+test_gl_basic_auto_platform(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_platform *plat;
+    int32_t platform;
+
+    const int32_t platform_attrib_list[] = {
+        WAFFLE_PLATFORM, WAFFLE_PLATFORM_AUTO,
+        0,
+    };
+
+    assert_int_equal(waffle_get_platform(), ts->platform);
+
+    plat = waffle_platform_create(platform_attrib_list);
+    assert_true_with_wfl_error(plat);
+    platform = waffle_platform_get_enum(plat);
+    assert_int_not_equal(platform, WAFFLE_PLATFORM_AUTO);
+    assert_true(waffle_enum_to_string(platform));
+    assert_true_with_wfl_error(waffle_platform_destroy(plat));
+
+    plat = waffle_platform_create(platform_attrib_list);
+    assert_true_with_wfl_error(plat);
+    assert_int_equal(waffle_platform_get_enum(plat), platform);
+    assert_true_with_wfl_error(waffle_platform_destroy(plat));
+}
+
+// WAFFLE_PLATFORM_ASYNC_INIT returns before the platform is ready, and the
+// first display connection waits for it.
+static void
+test_gl_basic_async_init(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_platform *plat;
+    struct waffle_display *dpy;
+    struct waffle_config *config;
+    struct waffle_window *window;
+    struct waffle_context *ctx;
+    int32_t context_api;
+
+    const int32_t platform_attrib_list[] = {
+        WAFFLE_PLATFORM, ts->platform,
+        WAFFLE_PLATFORM_ASYNC_INIT, true,
+        WAFFLE_DEFER_DL, true,
+        0,
+    };
+
+    plat = waffle_platform_create(platform_attrib_list);
+    assert_true_with_wfl_error(plat);
+    assert_int_equal(waffle_platform_get_enum(plat), ts->platform);
+
+    dpy = waffle_display_connect_platform(plat, NULL);
+    assert_true_with_wfl_error(dpy);
+
+    assert_true(waffle_platform_get_init_time(plat, WAFFLE_INIT_TIME_PLATFORM) >=
+                waffle_platform_get_init_time(plat, WAFFLE_INIT_TIME_DL_OPEN));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_NO_ERROR);
+    waffle_platform_get_init_time(plat, WAFFLE_INIT_TIME_WAIT);
+    assert_int_equal(waffle_error_get_code(), WAFFLE_NO_ERROR);
+    waffle_platform_get_init_time(plat, WAFFLE_NONE);
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    context_api = gl_basic_any_context_api(dpy);
+    if (!context_api) {
+        waffle_display_disconnect(dpy);
+        waffle_platform_destroy(plat);
+        skip();
+        return;
+    }
+
+    config = gl_basic_choose_config(dpy, context_api, NULL);
+    ctx = waffle_context_create(config, NULL);
+    assert_true_with_wfl_error(ctx);
+    window = waffle_window_create(config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(window);
+
+    assert_true_with_wfl_error(waffle_make_current(dpy, window, ctx));
+    assert_true(waffle_context_get_gl_dispatch(ctx)->glGetString(GL_VERSION));
+    assert_true_with_wfl_error(waffle_make_current(dpy, NULL, NULL));
+
+    assert_true_with_wfl_error(waffle_window_destroy(window));
+    assert_true_with_wfl_error(waffle_context_destroy(ctx));
+    assert_true_with_wfl_error(waffle_config_destroy(config));
+    assert_true_with_wfl_error(waffle_display_disconnect(dpy));
+    assert_true_with_wfl_error(waffle_platform_destroy(plat));
+}
+
+// waffle_display_get_capabilities() is computed once, agrees with the
+// contexts the display hands out, and leaves the caller's binding alone.
+static void
+test_gl_basic_display_capabilities(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    const struct waffle_display_capabilities *caps;
+    int32_t context_api;
+    int32_t major, minor;
+    int32_t max_version;
+
+    context_api = gl_basic_choose_any_config(ts, NULL);
+    if (!context_api) {
+        skip();
+        return;
+    }
+
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+    ts->window = waffle_window_create(ts->config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(ts->window);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window, ts->ctx));
+
+    caps = waffle_display_get_capabilities(ts->dpy);
+    assert_true_with_wfl_error(caps);
+    assert_int_equal(waffle_error_get_code(), WAFFLE_NO_ERROR);
+    assert_ptr_equal(waffle_display_get_capabilities(ts->dpy), caps);
+
+    assert_ptr_equal(waffle_get_current_display(), ts->dpy);
+    assert_ptr_equal(waffle_get_current_window(), ts->window);
+    assert_ptr_equal(waffle_get_current_context(), ts->ctx);
+
+    assert_int_equal(caps->supports_opengl,
+                     caps->opengl_compat_version || caps->opengl_core_version);
+    assert_int_equal(caps->supports_opengl_es2, caps->opengl_es_version != 0);
+    assert_int_equal(caps->supports_opengl_es3, caps->opengl_es_version >= 30);
+    if (caps->opengl_core_version)
+        assert_int_ge(caps->opengl_core_version, 32);
+
+    if (context_api == WAFFLE_CONTEXT_OPENGL) {
+        max_version = caps->opengl_compat_version;
+        if (caps->opengl_core_version > max_version)
+            max_version = caps->opengl_core_version;
+    } else {
+        max_version = caps->opengl_es_version;
+    }
+
+    assert_true_with_wfl_error(waffle_context_get_gl_version(ts->ctx,
+                                                             &major, &minor));
+    assert_int_ge(max_version, 10 * major + minor);
+}
+
+// With WAFFLE_CACHE, a second platform reads the versions the first one
+// probed.
+static void
+test_gl_basic_display_capabilities_cache(void **state)
+{
+#if defined(_WIN32)
+    (void) state;
+    skip();
+#else
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_display_capabilities caps[2];
+    char dir[] = "/tmp/waffle-gl-basic-XXXXXX";
+    char cache_dir[64];
+    char path[sizeof(cache_dir) + 256];
+    const char *old_xdg = getenv("XDG_CACHE_HOME");
+    char *saved_xdg = old_xdg ? strdup(old_xdg) : NULL;
+    struct dirent *entry;
+    DIR *d;
+    int files = 0;
+
+    const int32_t platform_attrib_list[] = {
+        WAFFLE_PLATFORM, ts->platform,
+        WAFFLE_CACHE, true,
+        0,
+    };
+
+    assert_non_null(mkdtemp(dir));
+    setenv("XDG_CACHE_HOME", dir, 1);
+
+    for (int i = 0; i < 2; ++i) {
+        struct waffle_platform *plat;
+        struct waffle_display *dpy;
+        const struct waffle_display_capabilities *c;
+
+        plat = waffle_platform_create(platform_attrib_list);
+        assert_true_with_wfl_error(plat);
+        dpy = waffle_display_connect_platform(plat, NULL);
+        assert_true_with_wfl_error(dpy);
+        c = waffle_display_get_capabilities(dpy);
+        assert_true_with_wfl_error(c);
+        caps[i] = *c;
+        assert_true_with_wfl_error(waffle_display_disconnect(dpy));
+        assert_true_with_wfl_error(waffle_platform_destroy(plat));
+    }
+
+    if (saved_xdg)
+        setenv("XDG_CACHE_HOME", saved_xdg, 1);
+    else
+        unsetenv("XDG_CACHE_HOME");
+    free(saved_xdg);
+
+    snprintf(cache_dir, sizeof(cache_dir), "%s/waffle", dir);
+    d = opendir(cache_dir);
+    if (d) {
+        while ((entry = readdir(d))) {
+            if (entry->d_name[0] == '.')
+                continue;
+            snprintf(path, sizeof(path), "%s/%s", cache_dir, entry->d_name);
+            unlink(path);
+            ++files;
+        }
+        closedir(d);
+        rmdir(cache_dir);
+    }
+    rmdir(dir);
+
+#if defined(__linux__)
+    assert_int_equal(files, 1);
+#endif
+    assert_int_equal(caps[1].opengl_compat_version, caps[0].opengl_compat_version);
+    assert_int_equal(caps[1].opengl_core_version, caps[0].opengl_core_version);
+    assert_int_equal(caps[1].opengl_es1_version, caps[0].opengl_es1_version);
+    assert_int_equal(caps[1].opengl_es_version, caps[0].opengl_es_version);
+    assert_int_equal(caps[1].supports_opengl, caps[0].supports_opengl);
+    assert_int_equal(caps[1].supports_opengl_es3, caps[0].supports_opengl_es3);
+#endif
+}
+
+// waffle_config_enumerate() counts the matches, fills as many as asked, and
+// hands out configs that work like those of waffle_config_choose().
+static void
+test_gl_basic_config_enumerate(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_config **configs;
+    int32_t context_api;
+    int32_t count = 0, smallest_count = 0, n = 0;
+
+    ts->dpy = waffle_display_connect(NULL);
+    assert_true_with_wfl_error(ts->dpy);
+
+    context_api = gl_basic_any_context_api(ts->dpy);
+    if (!context_api) {
+        skip();
+        return;
+    }
+
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API, context_api,
+        0,
+    };
+
+    const int32_t smallest_attrib_list[] = {
+        WAFFLE_CONTEXT_API, context_api,
+        WAFFLE_CONFIG_SORT, WAFFLE_CONFIG_SORT_SMALLEST,
+        0,
+    };
+
+    if (!waffle_config_enumerate(ts->dpy, config_attrib_list,
+                                 NULL, 0, &count)) {
+        assert_int_equal(waffle_error_get_code(),
+                         WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        skip();
+        return;
+    }
+    assert_int_ge(count, 1);
+
+    configs = calloc(count, sizeof(*configs));
+    assert_non_null(configs);
+
+    assert_true_with_wfl_error(waffle_config_enumerate(ts->dpy,
+                                                       config_attrib_list,
+                                                       configs, count, &n));
+    assert_int_equal(n, count);
+
+    // The first config draws like any other.
+    ts->ctx = waffle_context_create(configs[0], NULL);
+    assert_true_with_wfl_error(ts->ctx);
+    ts->window = waffle_window_create(configs[0], WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(ts->window);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window, ts->ctx));
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+    assert_true_with_wfl_error(waffle_window_destroy(ts->window));
+    assert_true_with_wfl_error(waffle_context_destroy(ts->ctx));
+    ts->window = NULL;
+    ts->ctx = NULL;
+
+    for (int32_t i = 0; i < n; ++i)
+        assert_true_with_wfl_error(waffle_config_destroy(configs[i]));
+
+    // A smaller array gets the best configs only.
+    assert_true_with_wfl_error(waffle_config_enumerate(ts->dpy,
+                                                       config_attrib_list,
+                                                       configs, 1, &n));
+    assert_int_equal(n, 1);
+    assert_true_with_wfl_error(waffle_config_destroy(configs[0]));
+
+    // Sorting changes the order, never the matches.
+    assert_true_with_wfl_error(waffle_config_enumerate(ts->dpy,
+                                                       smallest_attrib_list,
+                                                       NULL, 0,
+                                                       &smallest_count));
+    assert_int_equal(smallest_count, count);
+
+    free(configs);
+}
+
+// A pool hands back released contexts, unbinds them on release, and evicts
+// the least recently released one past its cap. The objects its contexts
+// are keyed on can't be destroyed while it holds them.
+static void
+test_gl_basic_context_pool(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_context_pool *pool;
+    struct waffle_context *a, *b, *c, *d, *e, *shared;
+
+    if (!gl_basic_choose_any_config(ts, NULL)) {
+        skip();
+        return;
+    }
+
+    ts->window = waffle_window_create(ts->config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(ts->window);
+
+    pool = waffle_context_pool_create(ts->dpy, 1);
+    assert_true_with_wfl_error(pool);
+
+    a = waffle_context_pool_acquire(pool, ts->config, NULL);
+    assert_true_with_wfl_error(a);
+    b = waffle_context_pool_acquire(pool, ts->config, NULL);
+    assert_true_with_wfl_error(b);
+    assert_ptr_not_equal(a, b);
+
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window, a));
+    assert_true_with_wfl_error(waffle_context_pool_release(pool, a));
+    assert_null(waffle_get_current_context());
+
+    // Releasing b evicts a.
+    assert_true_with_wfl_error(waffle_context_pool_release(pool, b));
+    assert_false(waffle_context_pool_release(pool, b));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    c = waffle_context_pool_acquire(pool, ts->config, NULL);
+    assert_ptr_equal(c, b);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window, c));
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+
+    assert_int_equal(waffle_context_pool_get_hit_count(pool), 1);
+    assert_int_equal(waffle_context_pool_get_miss_count(pool), 2);
+
+    assert_true_with_wfl_error(waffle_context_pool_release(pool, c));
+
+    shared = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(shared);
+    d = waffle_context_pool_acquire(pool, ts->config, shared);
+    assert_true_with_wfl_error(d);
+    assert_ptr_not_equal(d, c);
+    assert_true_with_wfl_error(waffle_context_pool_release(pool, d));
+
+    assert_false(waffle_config_destroy(ts->config));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+    assert_false(waffle_context_destroy(shared));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+    assert_false(waffle_display_disconnect(ts->dpy));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    // Destroying an acquired context removes it from the pool, which then
+    // no longer keeps its shared context from being destroyed.
+    e = waffle_context_pool_acquire(pool, ts->config, shared);
+    assert_ptr_equal(e, d);
+    assert_true_with_wfl_error(waffle_context_destroy(e));
+    assert_true_with_wfl_error(waffle_context_destroy(shared));
+
+    // Releasing d evicted b, so this is a miss.
+    c = waffle_context_pool_acquire(pool, ts->config, NULL);
+    assert_true_with_wfl_error(c);
+    assert_true_with_wfl_error(waffle_context_destroy(c));
+    assert_int_equal(waffle_context_pool_get_hit_count(pool), 2);
+    assert_int_equal(waffle_context_pool_get_miss_count(pool), 4);
+
+    assert_true_with_wfl_error(waffle_context_pool_destroy(pool));
+}
+
+// Connections to the same native display share it, so disconnecting one
+// leaves the others working.
+static void
+test_gl_basic_display_shared(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_display *other;
+
+    other = waffle_display_connect(NULL);
+    assert_true_with_wfl_error(other);
+    if (!gl_basic_choose_any_config(ts, NULL)) {
+        assert_true_with_wfl_error(waffle_display_disconnect(other));
+        skip();
+        return;
+    }
+    assert_ptr_not_equal(other, ts->dpy);
+    assert_true_with_wfl_error(waffle_display_disconnect(other));
+
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+    ts->window = waffle_window_create(ts->config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(ts->window);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window, ts->ctx));
+}
+
+// Contexts and windows created on a worker thread are usable on the caller's
+// thread, and the worker's errors reach the caller at finish.
+static void
+test_gl_basic_create_async(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_async_op *ctx_op, *window_op, *bad_op;
+
+    if (!gl_basic_choose_any_config(ts, NULL)) {
+        skip();
+        return;
+    }
+
+    const intptr_t window_attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, WINDOW_WIDTH,
+        WAFFLE_WINDOW_HEIGHT, WINDOW_HEIGHT,
+        0,
+    };
+
+    const intptr_t bad_window_attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, WINDOW_WIDTH,
+        0,
+    };
+
+    // Bad attributes fail before any work starts.
+    bad_op = waffle_window_create_async(ts->config, bad_window_attrib_list);
+    assert_null(bad_op);
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+
+    // The window size is required.
+    assert_null(waffle_window_create2(ts->config, NULL));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+    assert_null(waffle_window_create_async(ts->config, NULL));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+
+    ctx_op = waffle_context_create_async(ts->config, NULL);
+    assert_true_with_wfl_error(ctx_op);
+    window_op = waffle_window_create_async(ts->config, window_attrib_list);
+    assert_true_with_wfl_error(window_op);
+
+    // Pending operations keep their config, display and platform alive.
+    assert_false(waffle_config_destroy(ts->config));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+    assert_false(waffle_display_disconnect(ts->dpy));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+    assert_false(waffle_teardown());
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    // An operation finishes only as what it creates.
+    assert_null(waffle_window_create_finish(ctx_op));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    ts->ctx = waffle_context_create_finish(ctx_op);
+    assert_true_with_wfl_error(ts->ctx);
+
+    // They also keep the shared context alive.
+    ctx_op = waffle_context_create_async(ts->config, ts->ctx);
+    assert_true_with_wfl_error(ctx_op);
+    assert_false(waffle_context_destroy(ts->ctx));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+    assert_true_with_wfl_error(waffle_context_destroy(
+        waffle_context_create_finish(ctx_op)));
+    while (!waffle_async_op_is_done(window_op))
+        continue;
+    ts->window = waffle_window_create_finish(window_op);
+    assert_true_with_wfl_error(ts->window);
+
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window, ts->ctx));
+    assert_true_with_wfl_error(waffle_window_swap_buffers(ts->window));
+}
+
+// A group's members share objects, and each binds with one call.
+static void
+test_gl_basic_context_group(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_context_group *group;
+
+    if (!gl_basic_choose_any_config(ts, NULL)) {
+        skip();
+        return;
+    }
+
+    const intptr_t group_attrib_list[] = {
+        WAFFLE_CONTEXT_GROUP_SIZE, 3,
+        0,
+    };
+
+    const intptr_t surfaceless_attrib_list[] = {
+        WAFFLE_CONTEXT_GROUP_SIZE, 2,
+        WAFFLE_CONTEXT_GROUP_SURFACELESS, true,
+        0,
+    };
+
+    const intptr_t bad_attrib_list[] = {
+        WAFFLE_CONTEXT_GROUP_SIZE, 0,
+        0,
+    };
+
+    assert_null(waffle_context_group_create(ts->config, NULL, bad_attrib_list));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+
+    // A null attrib_list is empty, so it lacks WAFFLE_CONTEXT_GROUP_SIZE.
+    assert_null(waffle_context_group_create(ts->config, NULL, NULL));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+
+    group = waffle_context_group_create(ts->config, NULL, group_attrib_list);
+    assert_true_with_wfl_error(group);
+    assert_int_equal(waffle_context_group_get_size(group), 3);
+
+    for (int32_t i = 0; i < 3; ++i) {
+        assert_true_with_wfl_error(waffle_context_group_get_window(group, i));
+        assert_true_with_wfl_error(waffle_context_group_make_current(group, i));
+        assert_ptr_equal(waffle_get_current_context(),
+                         waffle_context_group_get_context(group, i));
+    }
+
+    assert_false(waffle_context_group_make_current(group, 3));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+    assert_true_with_wfl_error(waffle_context_group_destroy(group));
+
+    group = waffle_context_group_create(ts->config, NULL,
+                                        surfaceless_attrib_list);
+    assert_true_with_wfl_error(group);
+    assert_null(waffle_context_group_get_window(group, 1));
+
+    // Binding without a surface needs native support, which the surfaceless
+    // platform always has.
+    if (ts->platform == WAFFLE_PLATFORM_SURFACELESS_EGL) {
+        assert_true_with_wfl_error(waffle_context_group_make_current(group, 1));
+        assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+    }
+
+    assert_true_with_wfl_error(waffle_context_group_destroy(group));
+}
+
+// A default context has medium priority. A higher priority is a hint that
+// the driver may lower, but never raise.
+static void
+test_gl_basic_context_priority(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_config *config;
+    struct waffle_context *ctx;
+    int32_t context_api;
+    int32_t priority = 0;
+
+    context_api = gl_basic_choose_any_config(ts, NULL);
+    if (!context_api) {
+        skip();
+        return;
+    }
+
+    const int32_t high_attrib_list[] = {
+        WAFFLE_CONTEXT_API, context_api,
+        WAFFLE_CONTEXT_PRIORITY, WAFFLE_CONTEXT_PRIORITY_HIGH,
+        0,
+    };
+
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+
+    assert_true_with_wfl_error(waffle_context_get_priority(ts->ctx, &priority));
+    assert_int_equal(priority, WAFFLE_CONTEXT_PRIORITY_MEDIUM);
+
+    assert_false(waffle_context_get_priority(ts->ctx, NULL));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    config = waffle_config_choose(ts->dpy, high_attrib_list);
+    if (!config) {
+        assert_int_equal(waffle_error_get_code(),
+                         WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return;
+    }
+
+    ctx = waffle_context_create(config, NULL);
+    assert_true_with_wfl_error(ctx);
+
+    assert_true_with_wfl_error(waffle_context_get_priority(ctx, &priority));
+    assert_true(priority == WAFFLE_CONTEXT_PRIORITY_LOW ||
+                priority == WAFFLE_CONTEXT_PRIORITY_MEDIUM ||
+                priority == WAFFLE_CONTEXT_PRIORITY_HIGH);
+
+    assert_true_with_wfl_error(waffle_context_destroy(ctx));
+    assert_true_with_wfl_error(waffle_config_destroy(config));
+}
+
+// A context created without a config binds with windows of other configs.
+static void
+test_gl_basic_context_no_config(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_config *other_config;
+    struct waffle_window *other_window;
+    int32_t context_api;
+
+    ts->dpy = waffle_display_connect(NULL);
+    assert_true_with_wfl_error(ts->dpy);
+
+    context_api = gl_basic_any_context_api(ts->dpy);
+    if (!context_api) {
+        skip();
+        return;
+    }
+
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API, context_api,
+        WAFFLE_CONTEXT_NO_CONFIG, true,
+        WAFFLE_CONFIG_SORT, WAFFLE_CONFIG_SORT_SMALLEST,
+        0,
+    };
+
+    const int32_t other_attrib_list[] = {
+        WAFFLE_CONTEXT_API, context_api,
+        WAFFLE_RED_SIZE, 8,
+        WAFFLE_GREEN_SIZE, 8,
+        WAFFLE_BLUE_SIZE, 8,
+        WAFFLE_ALPHA_SIZE, 8,
+        WAFFLE_DEPTH_SIZE, 24,
+        0,
+    };
+
+    ts->config = waffle_config_choose(ts->dpy, config_attrib_list);
+    if (!ts->config) {
+        assert_int_equal(waffle_error_get_code(),
+                         WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        skip();
+        return;
+    }
+
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+
+    ts->window = waffle_window_create(ts->config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(ts->window);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window,
+                                                   ts->ctx));
+
+    other_config = waffle_config_choose(ts->dpy, other_attrib_list);
+    assert_true_with_wfl_error(other_config);
+    other_window = waffle_window_create(other_config, WINDOW_WIDTH,
+                                        WINDOW_HEIGHT);
+    assert_true_with_wfl_error(other_window);
+
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, other_window,
+                                                   ts->ctx));
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+
+    assert_true_with_wfl_error(waffle_window_destroy(other_window));
+    assert_true_with_wfl_error(waffle_config_destroy(other_config));
+}
+
+static void
+test_gl_basic_window_fbo(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_context *other_ctx;
+    GLint depth_bits = 0;
+    GLint framebuffer = 0;
+
+    const int32_t config_attrib_list[] = {
+        WAFFLE_RED_SIZE, 8,
+        WAFFLE_GREEN_SIZE, 8,
+        WAFFLE_BLUE_SIZE, 8,
+        WAFFLE_ALPHA_SIZE, 8,
+        WAFFLE_DEPTH_SIZE, 24,
+        WAFFLE_STENCIL_SIZE, 8,
+        0,
+    };
+
+    const intptr_t window_attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, WINDOW_WIDTH,
+        WAFFLE_WINDOW_HEIGHT, WINDOW_HEIGHT,
+        WAFFLE_WINDOW_FBO, true,
+        0,
+    };
+
+    if (!gl_basic_choose_any_config(ts, config_attrib_list)) {
+        skip();
+        return;
+    }
+
+    ts->window = waffle_window_create2(ts->config, window_attrib_list);
+    if (!ts->window) {
+        switch (waffle_error_get_code()) {
+        case WAFFLE_ERROR_BAD_ATTRIBUTE:
+            // fall-through
+        case WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM:
+            skip();
+            return;
+        default:
+            assert_true_with_wfl_error(ts->window);
+        }
+    }
+
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window,
+                                                   ts->ctx));
+
+    const struct waffle_gl_dispatch *gl = waffle_context_get_gl_dispatch(ts->ctx);
+    assert_true_with_wfl_error(gl);
+    assert_true(glClear         = gl->glClear);
+    assert_true(glClearColor    = gl->glClearColor);
+    assert_true(glGetError      = gl->glGetError);
+    assert_true(glGetIntegerv   = gl->glGetIntegerv);
+    assert_true(glReadPixels    = gl->glReadPixels);
+
+    // The framebuffer object stands in for the default framebuffer.
+    ASSERT_GL(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer));
+    assert_int_not_equal(framebuffer, 0);
+    ASSERT_GL(glGetIntegerv(GL_DEPTH_BITS, &depth_bits));
+    assert_true(depth_bits >= 24);
+
+    ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
+    ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           ts->actual_pixels));
+    assert_true_with_wfl_error(waffle_window_swap_buffers(ts->window));
+    assert_memory_equal(&ts->actual_pixels, &ts->expect_pixels,
+                        sizeof(ts->expect_pixels));
+
+    // Draw again after shrinking the window.
+    memset(&ts->actual_pixels, 0x99, sizeof(ts->actual_pixels));
+    assert_true_with_wfl_error(waffle_window_resize(ts->window,
+                                                    WINDOW_WIDTH,
+                                                    WINDOW_HEIGHT / 2));
+    ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT / 2,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           ts->actual_pixels));
+    assert_memory_equal(&ts->actual_pixels, &ts->expect_pixels,
+                        sizeof(ts->expect_pixels) / 2);
+
+    // Only the context that first bound the window can bind it.
+    other_ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(other_ctx);
+    assert_false(waffle_make_current(ts->dpy, ts->window, other_ctx));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    // Once the owner is destroyed, another context can bind the window. The
+    // window is destroyed in gl_basic_fini() while its new owner is not
+    // current.
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+    assert_true_with_wfl_error(waffle_context_destroy(ts->ctx));
+    ts->ctx = other_ctx;
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window,
+                                                   ts->ctx));
+    ASSERT_GL(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer));
+    assert_int_not_equal(framebuffer, 0);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+}
+
+static void
+test_gl_basic_window_offscreen(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+
+    const int32_t config_attrib_list[] = {
+        WAFFLE_RED_SIZE, 8,
+        WAFFLE_GREEN_SIZE, 8,
+        WAFFLE_BLUE_SIZE, 8,
+        WAFFLE_ALPHA_SIZE, 8,
+        0,
+    };
+
+    const intptr_t window_attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, WINDOW_WIDTH,
+        WAFFLE_WINDOW_HEIGHT, WINDOW_HEIGHT,
+        WAFFLE_WINDOW_OFFSCREEN, true,
+        0,
+    };
+
+    if (!gl_basic_choose_any_config(ts, config_attrib_list)) {
+        skip();
+        return;
+    }
+
+    ts->window = waffle_window_create2(ts->config, window_attrib_list);
+    if (!ts->window) {
+        switch (waffle_error_get_code()) {
+        case WAFFLE_ERROR_BAD_ATTRIBUTE:
+            // fall-through
+        case WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM:
+            skip();
+            return;
+        default:
+            assert_true_with_wfl_error(ts->window);
+        }
+    }
+    assert_true_with_wfl_error(waffle_window_show(ts->window));
+
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window,
+                                                   ts->ctx));
+
+    const struct waffle_gl_dispatch *gl = waffle_context_get_gl_dispatch(ts->ctx);
+    assert_true_with_wfl_error(gl);
+    assert_true(glClear         = gl->glClear);
+    assert_true(glClearColor    = gl->glClearColor);
+    assert_true(glGetError      = gl->glGetError);
+    assert_true(glReadPixels    = gl->glReadPixels);
+
+    // Resizing the current window keeps it current.
+    assert_true_with_wfl_error(waffle_window_resize(ts->window,
+                                                    WINDOW_WIDTH,
+                                                    WINDOW_HEIGHT / 2));
+    ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
+    ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT));
+    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT / 2,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           ts->actual_pixels));
+    assert_true_with_wfl_error(waffle_window_swap_buffers(ts->window));
+    assert_memory_equal(&ts->actual_pixels, &ts->expect_pixels,
+                        sizeof(ts->expect_pixels) / 2);
+
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+}
+
+// Make a window and context of the first supported API current. Return false
+// if the display supports neither OpenGL nor OpenGL ES2.
+static bool
+gl_basic_make_current_default(struct test_state_gl_basic *ts)
+{
+    if (!gl_basic_choose_any_config(ts, NULL))
+        return false;
+
+    ts->window = waffle_window_create(ts->config, WINDOW_WIDTH, WINDOW_HEIGHT);
+    assert_true_with_wfl_error(ts->window);
+    ts->ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(ts->ctx);
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window,
+                                                   ts->ctx));
+    return true;
+}
+
+static void
+test_gl_basic_make_current_skip(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    uint64_t skip_count;
+
+    if (!gl_basic_make_current_default(ts)) {
+        skip();
+        return;
+    }
+
+    // Rebinding the current objects is skipped by default.
+    skip_count = waffle_get_make_current_skip_count();
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, ts->window,
+                                                   ts->ctx));
+    assert_true(waffle_get_make_current_skip_count() == skip_count + 1);
+    assert_true(waffle_get_current_context() == ts->ctx);
+
+    // Changing any of the objects is not.
+    assert_true_with_wfl_error(waffle_make_current(ts->dpy, NULL, NULL));
+    assert_true(waffle_get_make_current_skip_count() == skip_count + 1);
+    assert_true(waffle_get_current_context() == NULL);
+}
+
+static void
+test_gl_basic_context_gl_version(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_context *other_ctx;
+    const struct waffle_gl_dispatch *gl;
+    const char *version_str;
+    int32_t major = 0, minor = 0;
+    int expected_major = 0, expected_minor = 0;
+
+    if (!gl_basic_make_current_default(ts)) {
+        skip();
+        return;
+    }
+
+    gl = waffle_context_get_gl_dispatch(ts->ctx);
+    assert_true_with_wfl_error(gl);
+    assert_true(glGetString = gl->glGetString);
+
+    // Skip the "OpenGL ES " prefix of OpenGL ES.
+    version_str = (const char *) glGetString(GL_VERSION);
+    assert_true(version_str);
+    while (*version_str && (*version_str < '0' || *version_str > '9'))
+        ++version_str;
+    assert_int_equal(sscanf(version_str, "%d.%d",
+                            &expected_major, &expected_minor), 2);
+
+    // The cached version agrees with GL_VERSION.
+    assert_true_with_wfl_error(waffle_context_get_gl_version(ts->ctx,
+                                                             &major, &minor));
+    assert_int_equal_print(major, expected_major);
+    assert_int_equal_print(minor, expected_minor);
+
+    assert_false(waffle_context_has_gl_extension(ts->ctx, "GL_WAFFLE_bogus"));
+    assert_int_equal_print(waffle_error_get_code(), WAFFLE_NO_ERROR);
+
+    assert_false(waffle_context_has_gl_extension(ts->ctx, NULL));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    // The cache can only be filled while the context is current.
+    other_ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(other_ctx);
+    assert_false(waffle_context_get_gl_version(other_ctx, &major, &minor));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+    assert_true_with_wfl_error(waffle_context_destroy(other_ctx));
+}
+
+static void
+test_gl_basic_gl_dispatch(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_context *other_ctx;
+    const struct waffle_gl_dispatch *gl;
+
+    if (!gl_basic_make_current_default(ts)) {
+        skip();
+        return;
+    }
+
+    // The table is owned by the context and filled once.
+    gl = waffle_context_get_gl_dispatch(ts->ctx);
+    assert_true_with_wfl_error(gl);
+    assert_true(gl == waffle_context_get_gl_dispatch(ts->ctx));
+    assert_true(gl->size >= sizeof(*gl));
+    assert_true(WAFFLE_GL_DISPATCH_HAS(gl, glFinish));
+
+    assert_true(glClear         = gl->glClear);
+    assert_true(glClearColor    = gl->glClearColor);
+    assert_true(glGetError      = gl->glGetError);
+    assert_true(glReadPixels    = gl->glReadPixels);
+    assert_true(glGetString     = gl->glGetString);
+    assert_true(glGetString(GL_VERSION));
+
+    ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
+    ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT));
+    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           ts->actual_pixels));
+    assert_memory_equal(&ts->actual_pixels, &ts->expect_pixels,
+                        sizeof(ts->expect_pixels));
+
+    // The context must be current on the calling thread.
+    other_ctx = waffle_context_create(ts->config, NULL);
+    assert_true_with_wfl_error(other_ctx);
+    assert_null(waffle_context_get_gl_dispatch(other_ctx));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+    assert_true_with_wfl_error(waffle_context_destroy(other_ctx));
+}
+
+// Native handles are filled once and owned by the object. Platforms without
+// native handles report WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM.
+#define ASSERT_PEEK_NATIVE(type, object)                                 \
+    do {                                                                \
+        const union waffle_native_##type *native =                      \
+            waffle_##type##_peek_native(object);                        \
+        if (native)                                                     \
+            assert_true(native == waffle_##type##_peek_native(object)); \
+        else                                                            \
+            assert_int_equal(waffle_error_get_code(),                   \
+                             WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);     \
+    } while (0)
+
+static void
+test_gl_basic_peek_native(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+
+    if (!gl_basic_make_current_default(ts)) {
+        skip();
+        return;
+    }
+
+    ASSERT_PEEK_NATIVE(display, ts->dpy);
+    ASSERT_PEEK_NATIVE(config, ts->config);
+    ASSERT_PEEK_NATIVE(context, ts->ctx);
+    ASSERT_PEEK_NATIVE(window, ts->window);
+
+    // Resizing may replace the window's surface, and with it the union.
+    assert_true_with_wfl_error(waffle_window_resize(ts->window,
+                                                    WINDOW_WIDTH / 2,
+                                                    WINDOW_HEIGHT / 2));
+    ASSERT_PEEK_NATIVE(window, ts->window);
+}
+
+#undef ASSERT_PEEK_NATIVE
 
 #define CREATE_TESTSUITE(waffle_platform, platform)                     \
                                                                         \
@@ -774,6 +1951,7 @@ testsuite_##platform(void)                                              \
         unit_test_make(test_gl_basic_gl_fwdcompat),                     \
         unit_test_make(test_gl_basic_gl_debug),                         \
         unit_test_make(test_gl_basic_gl_robust),                        \
+        unit_test_make(test_gl_basic_gl_release_none),                  \
                                                                         \
         unit_test_make(test_gl_basic_gl10),                             \
         unit_test_make(test_gl_basic_gl11),                             \
@@ -793,6 +1971,7 @@ testsuite_##platform(void)                                              \
         unit_test_make(test_gl_basic_gl32_core_fwdcompat),              \
         unit_test_make(test_gl_basic_gl32_core_debug),                  \
         unit_test_make(test_gl_basic_gl32_core_robust),                 \
+        unit_test_make(test_gl_basic_gl32_core_no_error),               \
         unit_test_make(test_gl_basic_gl33_core),                        \
         unit_test_make(test_gl_basic_gl40_core),                        \
         unit_test_make(test_gl_basic_gl41_core),                        \
@@ -828,6 +2007,8 @@ testsuite_##platform(void)                                              \
         unit_test_make(test_gl_basic_gles2_fwdcompat),                  \
         unit_test_make(test_gl_basic_gles2_debug),                      \
         unit_test_make(test_gl_basic_gles2_robust),                     \
+        unit_test_make(test_gl_basic_gles2_no_error),                   \
+        unit_test_make(test_gl_basic_gles2_release_none),               \
         unit_test_make(test_gl_basic_gles20),                           \
                                                                         \
         unit_test_make(test_gl_basic_gles3_rgb),                        \
@@ -835,10 +2016,31 @@ testsuite_##platform(void)                                              \
         unit_test_make(test_gl_basic_gles3_fwdcompat),                  \
         unit_test_make(test_gl_basic_gles3_debug),                      \
         unit_test_make(test_gl_basic_gles3_robust),                     \
+        unit_test_make(test_gl_basic_gles3_no_error),                   \
+        unit_test_make(test_gl_basic_gles3_release_none),               \
         unit_test_make(test_gl_basic_gles30),                           \
         unit_test_make(test_gl_basic_gles31),                           \
         unit_test_make(test_gl_basic_gles32),                           \
                                                                         \
+        unit_test_make(test_gl_basic_second_platform),                  \
+        unit_test_make(test_gl_basic_auto_platform),                    \
+        unit_test_make(test_gl_basic_async_init),                       \
+        unit_test_make(test_gl_basic_display_capabilities),             \
+        unit_test_make(test_gl_basic_display_capabilities_cache),       \
+        unit_test_make(test_gl_basic_config_enumerate),                 \
+        unit_test_make(test_gl_basic_context_pool),                     \
+        unit_test_make(test_gl_basic_display_shared),                   \
+        unit_test_make(test_gl_basic_create_async),                     \
+        unit_test_make(test_gl_basic_context_group),                    \
+        unit_test_make(test_gl_basic_context_priority),                 \
+        unit_test_make(test_gl_basic_context_no_config),                \
+        unit_test_make(test_gl_basic_window_fbo),                       \
+        unit_test_make(test_gl_basic_window_offscreen),                 \
+        unit_test_make(test_gl_basic_make_current_skip),                \
+        unit_test_make(test_gl_basic_context_gl_version),               \
+        unit_test_make(test_gl_basic_peek_native),                      \
+        unit_test_make(test_gl_basic_gl_dispatch),                      \
+                                                                        \
     };                                                                  \
                                                                         \
     return cmocka_run_group_tests_name(#platform, tests, NULL, NULL);   \
@@ -870,6 +2072,7 @@ test_XX_rgba(gl, OPENGL, NO_ERROR)
 test_XX_fwdcompat(gl, OPENGL, ERROR_BAD_ATTRIBUTE)
 test_XX_debug(gl, OPENGL, NO_ERROR)
 test_XX_robust(gl, OPENGL, NO_ERROR)
+test_XX_release_none(gl, OPENGL, NO_ERROR)
 
 test_glXX(10, NO_ERROR)
 test_glXX(11, NO_ERROR)
@@ -888,6 +2091,7 @@ test_glXX_core(32, NO_ERROR)
 test_glXX_core_fwdcompat(32, NO_ERROR)
 test_glXX_core_debug(32, NO_ERROR)
 test_glXX_core_robust(32, NO_ERROR)
+test_glXX_core_no_error(32, NO_ERROR)
 test_glXX_core(33, NO_ERROR)
 test_glXX_core(40, NO_ERROR)
 test_glXX_core(41, NO_ERROR)
@@ -923,6 +2127,8 @@ test_XX_rgba(gles2, OPENGL_ES2, NO_ERROR)
 test_XX_fwdcompat(gles2, OPENGL_ES2, ERROR_BAD_ATTRIBUTE)
 test_XX_debug(gles2, OPENGL_ES2, NO_ERROR)
 test_XX_robust(gles2, OPENGL_ES2, NO_ERROR)
+test_XX_no_error(gles2, OPENGL_ES2, NO_ERROR)
+test_XX_release_none(gles2, OPENGL_ES2, NO_ERROR)
 test_glesXX(2, 20, NO_ERROR)
 
 test_XX_rgb(gles3, OPENGL_ES3, NO_ERROR)
@@ -930,6 +2136,8 @@ test_XX_rgba(gles3, OPENGL_ES3, NO_ERROR)
 test_XX_fwdcompat(gles3, OPENGL_ES3, ERROR_BAD_ATTRIBUTE)
 test_XX_debug(gles3, OPENGL_ES3, NO_ERROR)
 test_XX_robust(gles3, OPENGL_ES3, NO_ERROR)
+test_XX_no_error(gles3, OPENGL_ES3, NO_ERROR)
+test_XX_release_none(gles3, OPENGL_ES3, NO_ERROR)
 test_glesXX(3, 30, NO_ERROR)
 test_glesXX(3, 31, NO_ERROR)
 test_glesXX(3, 32, NO_ERROR)
@@ -1018,6 +2226,7 @@ CREATE_TESTSUITE(WAFFLE_PLATFORM_WGL, wgl)
 #undef test_glXX_compat_debug
 #undef test_glXX_compat_fwdcompat
 #undef test_glXX_compat
+#undef test_glXX_core_no_error
 #undef test_glXX_core_robust
 #undef test_glXX_core_debug
 #undef test_glXX_core_fwdcompat
@@ -1025,6 +2234,8 @@ CREATE_TESTSUITE(WAFFLE_PLATFORM_WGL, wgl)
 #undef test_glXX_fwdcompat
 #undef test_glXX
 
+#undef test_XX_release_none
+#undef test_XX_no_error
 #undef test_XX_robust
 #undef test_XX_debug
 #undef test_XX_fwdcompat